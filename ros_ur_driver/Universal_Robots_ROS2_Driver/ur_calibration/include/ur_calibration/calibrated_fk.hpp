@@ -0,0 +1,248 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_CALIBRATION__CALIBRATED_FK_HPP_
+#define UR_CALIBRATION__CALIBRATED_FK_HPP_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ur_calibration/calibration.hpp"
+
+namespace ur_calibration
+{
+/*!
+ * \brief Forward kinematics and Jacobian of a calibrated robot, evaluated directly on the corrected chain.
+ *
+ * The six link transforms of Calibration::getSimplified() that make up the exported kinematics are stored as
+ * fixed-size rotations and translations. The tool flange pose is the product of these links interleaved with the
+ * joint rotations about z, so no URDF or generic kinematics solver is needed to evaluate it. Multiplying a frame
+ * with a rotation about z only mixes its first two columns, which is all that is done per joint.
+ */
+class CalibratedFK
+{
+public:
+  using JointVector = Eigen::Matrix<double, 6, 1>;
+  using Jacobian = Eigen::Matrix<double, 6, 6>;
+
+  /*!
+   * \brief Joint vectors of a batch, one per column.
+   */
+  using JointBatch = Eigen::Matrix<double, 6, Eigen::Dynamic>;
+
+  /*!
+   * \brief Poses of a batch, one per column. Rows 0-8 hold the rotation matrix in column-major order and rows 9-11
+   * the translation.
+   */
+  using PoseBatch = Eigen::Matrix<double, 12, Eigen::Dynamic>;
+
+  /*!
+   * \brief Creates the kinematics from a simplified chain as returned by Calibration::getSimplified().
+   *
+   * \param chain Homogeneous transforms of the links in front of each joint. Transforms after the sixth one are
+   * ignored, as in Calibration::calcForwardKinematics().
+   */
+  explicit CalibratedFK(const std::vector<Eigen::Matrix4d>& chain)
+  {
+    if (chain.size() < JOINT_COUNT) {
+      throw std::invalid_argument("The simplified chain has to consist of at least " + std::to_string(JOINT_COUNT) +
+                                  " transforms, got " + std::to_string(chain.size()));
+    }
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      rotations_[i] = chain[i].topLeftCorner<3, 3>();
+      translations_[i] = chain[i].topRightCorner<3, 1>();
+    }
+  }
+
+  explicit CalibratedFK(const Calibration& calibration)
+    : CalibratedFK(calibration.getSimplified())
+  {
+  }
+
+  /*!
+   * \brief Calculates the flange pose in the base frame.
+   *
+   * Matches Calibration::calcForwardKinematics() for all six joints.
+   */
+  Eigen::Matrix4d forward(const JointVector& joint_values) const
+  {
+    Eigen::Matrix3d rotation = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d translation = Eigen::Vector3d::Zero();
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      translation += rotation * translations_[i];
+      rotateJoint(rotation * rotations_[i], joint_values(i), rotation);
+    }
+    return toTransform(rotation, translation);
+  }
+
+  /*!
+   * \brief Calculates the flange pose and the geometric Jacobian in one pass.
+   *
+   * \param joint_values Joint positions
+   * \param jacobian Receives the Jacobian of the flange origin's linear (rows 0-2) and angular velocity (rows 3-5)
+   * in the base frame
+   *
+   * \returns The flange pose in the base frame
+   */
+  Eigen::Matrix4d forward(const JointVector& joint_values, Jacobian& jacobian) const
+  {
+    Eigen::Matrix3d rotation = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d translation = Eigen::Vector3d::Zero();
+    Eigen::Matrix<double, 3, JOINT_COUNT> origins;
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      translation += rotation * translations_[i];
+      const Eigen::Matrix3d frame = rotation * rotations_[i];
+      origins.col(i) = translation;
+      jacobian.block<3, 1>(3, i) = frame.col(2);
+      rotateJoint(frame, joint_values(i), rotation);
+    }
+    const Eigen::Matrix4d pose = toTransform(rotation, translation);
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      const Eigen::Vector3d axis = jacobian.block<3, 1>(3, i);
+      jacobian.block<3, 1>(0, i) = axis.cross(pose.topRightCorner<3, 1>() - origins.col(i));
+    }
+    return pose;
+  }
+
+  /*!
+   * \brief Calculates the flange poses of many joint vectors.
+   *
+   * The batch is evaluated in cache-sized chunks of joint vectors. Within a chunk every joint is applied to all
+   * joint vectors at once, so the frame updates run vectorised.
+   *
+   * \param joint_values Joint vectors, one per column
+   * \param poses Receives the poses in the layout described at PoseBatch
+   */
+  void forward(const JointBatch& joint_values, PoseBatch& poses) const
+  {
+    poses.resize(12, joint_values.cols());
+    for (Eigen::Index start = 0; start < joint_values.cols(); start += BATCH_CHUNK) {
+      const Eigen::Index count = std::min<Eigen::Index>(BATCH_CHUNK, joint_values.cols() - start);
+
+      // Element 3 * column + row of the accumulated rotation
+      Chunk rotation[9];
+      Chunk translation[3];
+      Chunk frame[9];
+      for (size_t k = 0; k < 9; ++k) {
+        rotation[k] = Chunk::Constant(count, k % 4 == 0 ? 1.0 : 0.0);
+      }
+      for (size_t k = 0; k < 3; ++k) {
+        translation[k] = Chunk::Zero(count);
+      }
+
+      for (size_t i = 0; i < JOINT_COUNT; ++i) {
+        const Eigen::Matrix3d& link_rotation = rotations_[i];
+        const Eigen::Vector3d& link_translation = translations_[i];
+        for (size_t row = 0; row < 3; ++row) {
+          translation[row] += rotation[row] * link_translation(0) + rotation[3 + row] * link_translation(1) +
+                              rotation[6 + row] * link_translation(2);
+          for (size_t col = 0; col < 3; ++col) {
+            frame[3 * col + row] = rotation[row] * link_rotation(0, col) +
+                                   rotation[3 + row] * link_rotation(1, col) +
+                                   rotation[6 + row] * link_rotation(2, col);
+          }
+        }
+        // Eigen has no vectorised sine and cosine for double, so these are evaluated pairwise per joint vector
+        Chunk cos(count);
+        Chunk sin(count);
+        for (Eigen::Index k = 0; k < count; ++k) {
+          cos(k) = std::cos(joint_values(i, start + k));
+          sin(k) = std::sin(joint_values(i, start + k));
+        }
+        for (size_t row = 0; row < 3; ++row) {
+          rotation[row] = cos * frame[row] + sin * frame[3 + row];
+          rotation[3 + row] = cos * frame[3 + row] - sin * frame[row];
+          rotation[6 + row] = frame[6 + row];
+        }
+      }
+
+      for (size_t k = 0; k < 9; ++k) {
+        poses.block(k, start, 1, count) = rotation[k].matrix();
+      }
+      for (size_t k = 0; k < 3; ++k) {
+        poses.block(9 + k, start, 1, count) = translation[k].matrix();
+      }
+    }
+  }
+
+  /*!
+   * \brief Extracts a single pose from a batch as homogeneous transform.
+   */
+  static Eigen::Matrix4d pose(const PoseBatch& poses, const Eigen::Index index)
+  {
+    Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+    pose.topLeftCorner<3, 3>() = Eigen::Map<const Eigen::Matrix3d>(poses.col(index).data());
+    pose.topRightCorner<3, 1>() = poses.block<3, 1>(9, index);
+    return pose;
+  }
+
+private:
+  static constexpr size_t JOINT_COUNT = 6;
+  static constexpr Eigen::Index BATCH_CHUNK = 64;
+
+  // Row of joint vector components within a chunk, kept on the stack
+  using Chunk = Eigen::Array<double, 1, Eigen::Dynamic, Eigen::RowMajor, 1, BATCH_CHUNK>;
+
+  static void rotateJoint(const Eigen::Matrix3d& frame, const double angle, Eigen::Matrix3d& rotation)
+  {
+    const double cos = std::cos(angle);
+    const double sin = std::sin(angle);
+    rotation.col(0) = cos * frame.col(0) + sin * frame.col(1);
+    rotation.col(1) = cos * frame.col(1) - sin * frame.col(0);
+    rotation.col(2) = frame.col(2);
+  }
+
+  static Eigen::Matrix4d toTransform(const Eigen::Matrix3d& rotation, const Eigen::Vector3d& translation)
+  {
+    Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+    pose.topLeftCorner<3, 3>() = rotation;
+    pose.topRightCorner<3, 1>() = translation;
+    return pose;
+  }
+
+  Eigen::Matrix3d rotations_[JOINT_COUNT];
+  Eigen::Vector3d translations_[JOINT_COUNT];
+};
+}  // namespace ur_calibration
+#endif  // UR_CALIBRATION__CALIBRATED_FK_HPP_
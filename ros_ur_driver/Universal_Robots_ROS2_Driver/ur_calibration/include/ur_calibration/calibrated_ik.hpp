@@ -0,0 +1,363 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_CALIBRATION__CALIBRATED_IK_HPP_
+#define UR_CALIBRATION__CALIBRATED_IK_HPP_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ur_calibration/calibrated_fk.hpp"
+#include "ur_calibration/calibration.hpp"
+
+namespace ur_calibration
+{
+/*!
+ * \brief Inverse kinematics of a calibrated UR robot.
+ *
+ * A UR arm's nominal DH parameters allow solving the inverse kinematics in closed form, giving up to eight
+ * solutions (shoulder left / right, wrist up / down, elbow up / down). The calibrated chain deviates slightly from
+ * that model, so every closed-form solution is refined iteratively on the calibrated forward kinematics, which
+ * converges within a few steps.
+ */
+class CalibratedIK
+{
+public:
+  using JointVector = CalibratedFK::JointVector;
+
+  /*!
+   * \brief Creates the inverse kinematics of a robot.
+   *
+   * \param nominal DH parameters used for the closed-form solution. Of these, only d of the first and the last
+   * three joints, a of the second and third joint and all theta are used, the remaining parameters are the ones of
+   * an ideal UR arm.
+   * \param fk Forward kinematics of the calibrated chain the solutions are refined on
+   * \param tolerance Maximum remaining error of a solution, the norm of the position error in meters and the
+   * orientation error in radians
+   * \param max_iterations Maximum number of refinement steps per solution
+   */
+  CalibratedIK(const DHRobot& nominal, const CalibratedFK& fk, const double tolerance = 1e-10,
+               const size_t max_iterations = 100)
+    : fk_(fk), tolerance_(tolerance), max_iterations_(max_iterations)
+  {
+    if (nominal.segments_.size() != JOINT_COUNT) {
+      throw std::invalid_argument("The nominal model has to consist of " + std::to_string(JOINT_COUNT) +
+                                  " segments, got " + std::to_string(nominal.segments_.size()));
+    }
+    // The closed-form solution is exact for these link lengths and twists only
+    const double alpha[JOINT_COUNT] = { M_PI_2, 0.0, 0.0, M_PI_2, -M_PI_2, 0.0 };
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      const DHSegment& segment = nominal.segments_[i];
+      segments_.emplace_back(i == 1 || i == 2 ? 0.0 : segment.d_, i == 1 || i == 2 ? segment.a_ : 0.0,
+                             segment.theta_, alpha[i]);
+    }
+  }
+
+  /*!
+   * \brief Solves the inverse kinematics of the nominal model in closed form.
+   *
+   * \param pose Flange pose in the base frame
+   * \param seed Joint positions whose wrist 3 position is used where it is undetermined, i.e. if the wrist 1 and
+   * wrist 3 axes are aligned
+   * \param reach_margin Relative amount by which the pose may be out of reach of a branch. Such branches yield the
+   * configuration closest to the pose. The default only absorbs rounding errors.
+   *
+   * \returns Up to eight solutions with each joint in [-pi, pi]. Branches the pose is out of reach for are left out.
+   */
+  std::vector<JointVector> solveNominal(const Eigen::Matrix4d& pose, const JointVector& seed = JointVector::Zero(),
+                                        const double reach_margin = 1e-9) const
+  {
+    std::vector<JointVector> solutions;
+    for (size_t branch = 0; branch < BRANCH_COUNT; ++branch) {
+      JointVector solution;
+      if (solveBranch(pose, branch, seed, reach_margin, solution)) {
+        solutions.push_back(solution);
+      }
+    }
+    return solutions;
+  }
+
+  /*!
+   * \brief Moves joint positions onto the calibrated chain's solution for a pose.
+   *
+   * Runs a Levenberg-Marquardt iteration on the calibrated forward kinematics. Its damping adapts to the progress,
+   * so steps stay bounded close to singularities.
+   *
+   * \param pose Flange pose in the base frame
+   * \param joint_values Starting point, receives the refined joint positions
+   *
+   * \returns True if the remaining error is within tolerance
+   */
+  bool refine(const Eigen::Matrix4d& pose, JointVector& joint_values) const
+  {
+    return refine(pose, joint_values, max_iterations_);
+  }
+
+  /*!
+   * \brief Solves the inverse kinematics of the calibrated chain.
+   *
+   * \param pose Flange pose in the base frame
+   * \param seed Joint positions the solutions should be close to
+   *
+   * \returns Up to eight distinct solutions, ordered by their distance to \p seed. Every joint is shifted by a
+   * multiple of 2 pi to lie within pi of its seed position.
+   */
+  std::vector<JointVector> solve(const Eigen::Matrix4d& pose, const JointVector& seed) const
+  {
+    std::vector<JointVector> solutions;
+    auto add = [&](JointVector solution) {
+      for (size_t i = 0; i < JOINT_COUNT; ++i) {
+        solution(i) = seed(i) + std::remainder(solution(i) - seed(i), 2 * M_PI);
+      }
+      // Close to singularities, several starting points converge onto the same solution
+      const bool duplicate = std::any_of(solutions.begin(), solutions.end(), [&solution](const JointVector& other) {
+        return (other - solution).cwiseAbs().maxCoeff() < DUPLICATE_THRESHOLD;
+      });
+      if (!duplicate) {
+        solutions.push_back(solution);
+      }
+    };
+
+    for (size_t branch = 0; branch < BRANCH_COUNT; ++branch) {
+      JointVector solution;
+      if (solveBranch(pose, branch, seed, REACH_MARGIN, solution) && refineBranch(pose, branch, solution)) {
+        add(solution);
+      }
+    }
+    // Close to singularities, the solution next to the seed may not be reached from any branch. Unless no branch
+    // converged at all, this only matters for seeds close to a solution, so few iterations suffice.
+    JointVector solution = seed;
+    const size_t seed_iterations = solutions.empty() ? max_iterations_ : std::min(max_iterations_, SEED_ITERATIONS);
+    if (refine(pose, solution, seed_iterations)) {
+      add(solution);
+    }
+
+    std::sort(solutions.begin(), solutions.end(), [&seed](const JointVector& a, const JointVector& b) {
+      return (a - seed).squaredNorm() < (b - seed).squaredNorm();
+    });
+    return solutions;
+  }
+
+private:
+  static constexpr size_t JOINT_COUNT = 6;
+  static constexpr size_t BRANCH_COUNT = 8;
+  static constexpr size_t SEED_ITERATIONS = 10;
+  static constexpr double SINGULARITY_THRESHOLD = 1e-10;
+  static constexpr double DUPLICATE_THRESHOLD = 1e-6;
+  static constexpr double INITIAL_DAMPING = 1e-12;
+  // Poses the calibrated chain reaches can be slightly out of the nominal model's reach
+  static constexpr double REACH_MARGIN = 0.05;
+
+  // Clamps a sine or cosine that is out of range by less than the margin
+  static bool clampUnit(const double value, const double margin, double& clamped)
+  {
+    if (!std::isfinite(value) || std::abs(value) > 1.0 + margin) {
+      return false;
+    }
+    clamped = std::clamp(value, -1.0, 1.0);
+    return true;
+  }
+
+  // Position error and orientation error as rotation vector, both in the base frame
+  static Eigen::Matrix<double, 6, 1> poseError(const Eigen::Matrix4d& expected, const Eigen::Matrix4d& actual)
+  {
+    const Eigen::AngleAxisd rotation_error(expected.topLeftCorner<3, 3>() *
+                                           actual.topLeftCorner<3, 3>().transpose());
+    Eigen::Matrix<double, 6, 1> error;
+    error << expected.topRightCorner<3, 1>() - actual.topRightCorner<3, 1>(),
+        rotation_error.angle() * rotation_error.axis();
+    return error;
+  }
+
+  // Levenberg-Marquardt iteration on the calibrated forward kinematics
+  bool refine(const Eigen::Matrix4d& pose, JointVector& joint_values, const size_t max_iterations) const
+  {
+    CalibratedFK::Jacobian jacobian;
+    Eigen::Matrix<double, 6, 1> error = poseError(pose, fk_.forward(joint_values, jacobian));
+    double damping = INITIAL_DAMPING;
+    for (size_t i = 0; i < max_iterations; ++i) {
+      if (error.norm() < tolerance_) {
+        return true;
+      }
+      const Eigen::Matrix<double, 6, 6> damped =
+          jacobian * jacobian.transpose() + damping * Eigen::Matrix<double, 6, 6>::Identity();
+      const JointVector candidate = joint_values + jacobian.transpose() * damped.ldlt().solve(error);
+      CalibratedFK::Jacobian candidate_jacobian;
+      const Eigen::Matrix<double, 6, 1> candidate_error =
+          poseError(pose, fk_.forward(candidate, candidate_jacobian));
+      if (candidate_error.norm() < error.norm()) {
+        joint_values = candidate;
+        jacobian = candidate_jacobian;
+        error = candidate_error;
+        damping = std::max(damping / 10, INITIAL_DAMPING);
+      } else {
+        damping *= 10;
+      }
+    }
+    return error.norm() < tolerance_;
+  }
+
+  /*
+   * Closed-form solution of the nominal model for one of the eight branches. Bit 2 of the branch selects the
+   * shoulder, bit 1 the wrist and bit 0 the elbow configuration.
+   */
+  bool solveBranch(const Eigen::Matrix4d& pose, const size_t branch, const JointVector& seed,
+                   const double reach_margin, JointVector& solution) const
+  {
+    const double a2 = segments_[1].a_;
+    const double a3 = segments_[2].a_;
+    const double d4 = segments_[3].d_;
+    const double d6 = segments_[5].d_;
+    const Eigen::Matrix3d rotation = pose.topLeftCorner<3, 3>();
+    const Eigen::Vector3d position = pose.topRightCorner<3, 1>();
+
+    // The shoulder pan angle places the wrist 2 joint at distance d4 of the arm's plane
+    const Eigen::Vector3d wrist = position - d6 * rotation.col(2);
+    double sin_shoulder_offset;
+    if (!clampUnit(d4 / wrist.head<2>().norm(), reach_margin, sin_shoulder_offset)) {
+      return false;
+    }
+    const double shoulder_offset = std::asin(sin_shoulder_offset);
+    const double theta1 =
+        std::atan2(wrist.y(), wrist.x()) + (branch & 4 ? M_PI - shoulder_offset : shoulder_offset);
+
+    // Axis of the shoulder lift, elbow and wrist 1 joints
+    const Eigen::Vector3d axis(std::sin(theta1), -std::cos(theta1), 0.0);
+    double cos5;
+    if (!clampUnit((axis.dot(position) - d4) / d6, reach_margin, cos5)) {
+      return false;
+    }
+    const double theta5 = branch & 2 ? -std::acos(cos5) : std::acos(cos5);
+    const double sin5 = std::sin(theta5);
+    double theta6 = seed(5) + segments_[5].theta_;
+    if (std::abs(sin5) > SINGULARITY_THRESHOLD) {
+      theta6 = std::atan2(-axis.dot(rotation.col(1)) / sin5, axis.dot(rotation.col(0)) / sin5);
+    }
+
+    // The remaining joints form a planar arm from the shoulder lift to the wrist 1 joint
+    const Eigen::Matrix4d wrist_1 = invert(dh(0, theta1)) * pose * invert(dh(4, theta5) * dh(5, theta6));
+    const double x = wrist_1(0, 3);
+    const double y = wrist_1(1, 3);
+    double cos3;
+    if (!clampUnit((x * x + y * y - a2 * a2 - a3 * a3) / (2 * a2 * a3), reach_margin, cos3)) {
+      return false;
+    }
+    const double theta3 = branch & 1 ? -std::acos(cos3) : std::acos(cos3);
+    const double theta2 = std::atan2(y, x) - std::atan2(a3 * std::sin(theta3), a2 + a3 * std::cos(theta3));
+    const double theta4 = std::atan2(wrist_1(1, 0), wrist_1(0, 0)) - theta2 - theta3;
+
+    solution << theta1, theta2, theta3, theta4, theta5, theta6;
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      solution(i) = std::remainder(solution(i) - segments_[i].theta_, 2 * M_PI);
+    }
+    return true;
+  }
+
+  /*
+   * Refines a solution while staying on its branch. The calibrated chain is treated as the nominal model followed by
+   * a correction that changes little with the joint positions. Each step solves the nominal model for the pose
+   * corrected by the current deviation, which unlike a Jacobian-based step doesn't degrade close to singularities.
+   * If this doesn't converge, e.g. as the pose is out of the branch's reach, the Jacobian-based refinement takes
+   * over.
+   */
+  bool refineBranch(const Eigen::Matrix4d& pose, const size_t branch, JointVector& joint_values) const
+  {
+    for (size_t i = 0; i < max_iterations_; ++i) {
+      const Eigen::Matrix4d current = fk_.forward(joint_values);
+      if (poseError(pose, current).norm() < tolerance_) {
+        return true;
+      }
+      JointVector next;
+      const Eigen::Matrix4d corrected_pose = nominalForward(joint_values) * invert(current) * pose;
+      if (!solveBranch(corrected_pose, branch, joint_values, REACH_MARGIN, next)) {
+        break;
+      }
+      const double step = (next - joint_values).cwiseAbs().maxCoeff();
+      joint_values = next;
+      if (step < tolerance_) {
+        break;
+      }
+    }
+    return refine(pose, joint_values);
+  }
+
+  static Eigen::Matrix4d invert(const Eigen::Matrix4d& transform)
+  {
+    Eigen::Matrix4d inverse = Eigen::Matrix4d::Identity();
+    inverse.topLeftCorner<3, 3>() = transform.topLeftCorner<3, 3>().transpose();
+    inverse.topRightCorner<3, 1>() = -inverse.topLeftCorner<3, 3>() * transform.topRightCorner<3, 1>();
+    return inverse;
+  }
+
+  Eigen::Matrix4d nominalForward(const JointVector& joint_values) const
+  {
+    Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+    for (size_t i = 0; i < JOINT_COUNT; ++i) {
+      pose *= dh(i, joint_values(i) + segments_[i].theta_);
+    }
+    return pose;
+  }
+
+  Eigen::Matrix4d dh(const size_t index, const double theta) const
+  {
+    const DHSegment& segment = segments_[index];
+    const double cos_theta = std::cos(theta);
+    const double sin_theta = std::sin(theta);
+    const double cos_alpha = std::cos(segment.alpha_);
+    const double sin_alpha = std::sin(segment.alpha_);
+    Eigen::Matrix4d transform;
+    transform << cos_theta, -sin_theta * cos_alpha, sin_theta * sin_alpha, segment.a_ * cos_theta,  //
+        sin_theta, cos_theta * cos_alpha, -cos_theta * sin_alpha, segment.a_ * sin_theta,           //
+        0, sin_alpha, cos_alpha, segment.d_,                                                        //
+        0, 0, 0, 1;
+    return transform;
+  }
+
+  CalibratedFK fk_;
+  std::vector<DHSegment> segments_;
+  double tolerance_;
+  size_t max_iterations_;
+};
+}  // namespace ur_calibration
+#endif  // UR_CALIBRATION__CALIBRATED_IK_HPP_
@@ -44,7 +44,11 @@
 #ifndef UR_CALIBRATION__CALIBRATION_CONSUMER_HPP_
 #define UR_CALIBRATION__CALIBRATION_CONSUMER_HPP_
 
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
 
 #include "ur_client_library/comm/pipeline.h"
 #include "ur_client_library/primary/robot_state/kinematics_info.h"
@@ -56,20 +60,53 @@ namespace ur_calibration
 class CalibrationConsumer : public urcl::comm::IConsumer<urcl::primary_interface::PrimaryPackage>
 {
 public:
-  CalibrationConsumer();
+  /*!
+   * \brief Creates a consumer calculating the calibration from the first kinematics info received.
+   *
+   * \param known_hash Hash of an existing calibration. If the robot reports the same hash, the calibration isn't
+   * calculated again and isUpToDate() returns true.
+   */
+  explicit CalibrationConsumer(const std::string& known_hash = "");
   virtual ~CalibrationConsumer() = default;
 
   virtual bool consume(std::shared_ptr<urcl::primary_interface::PrimaryPackage> product);
 
   bool isCalibrated() const
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     return calibrated_;
   }
 
+  /*!
+   * \brief Waits until the kinematics info has been received.
+   *
+   * \returns Whether the kinematics info has been received before the timeout
+   */
+  bool waitForCalibration(std::chrono::milliseconds timeout) const;
+
+  /*!
+   * \brief Whether the robot reported the known hash given on construction.
+   */
+  bool isUpToDate() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return up_to_date_;
+  }
+
+  /*!
+   * \brief Hash of the kinematics info received from the robot.
+   */
+  std::string getHash() const;
+
   YAML::Node getCalibrationParameters() const;
 
 private:
+  mutable std::mutex mutex_;
+  mutable std::condition_variable calibrated_cv_;
   bool calibrated_;
+  bool up_to_date_;
+  std::string known_hash_;
+  std::string hash_;
   YAML::Node calibration_parameters_;
 };
 }  // namespace ur_calibration
@@ -0,0 +1,104 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_CALIBRATION__FLEET_CALIBRATION_HPP_
+#define UR_CALIBRATION__FLEET_CALIBRATION_HPP_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ur_calibration
+{
+/*!
+ * \brief A robot whose calibration should be extracted.
+ */
+struct RobotCalibrationTarget
+{
+  std::string name;
+  std::string robot_ip;
+  int port;
+  std::string output_filename;
+};
+
+struct RobotCalibrationResult
+{
+  enum class Outcome
+  {
+    WRITTEN,     ///< The calibration has been written to the output file
+    UP_TO_DATE,  ///< The output file already contains the robot's calibration
+    TIMED_OUT,   ///< The robot didn't report its kinematics in time
+    FAILED       ///< Extracting or writing the calibration failed, see message
+  };
+
+  std::string name;
+  Outcome outcome = Outcome::FAILED;
+  std::string hash;
+  std::string message;
+};
+
+/*!
+ * \brief Reads the kinematics hash of an existing calibration file.
+ *
+ * \returns The hash, or an empty string if the file doesn't exist or doesn't contain a hash
+ */
+std::string readCalibrationHash(const std::string& filename);
+
+/*!
+ * \brief Extracts the calibration of a single robot and writes it to the robot's output file.
+ *
+ * If the output file already contains a calibration with the hash reported by the robot, it is left untouched.
+ *
+ * \param timeout Time to wait for the robot accepting the connection and reporting its kinematics. Connecting to a
+ * host that doesn't respond at all may additionally take as long as the operating system's connection timeout.
+ */
+RobotCalibrationResult calibrateRobot(const RobotCalibrationTarget& robot, std::chrono::milliseconds timeout);
+
+/*!
+ * \brief Extracts the calibrations of several robots concurrently, see calibrateRobot().
+ *
+ * \returns The results in the order of the robots
+ */
+std::vector<RobotCalibrationResult> calibrateRobots(const std::vector<RobotCalibrationTarget>& robots,
+                                                    std::chrono::milliseconds timeout);
+
+std::string toString(RobotCalibrationResult::Outcome outcome);
+}  // namespace ur_calibration
+#endif  // UR_CALIBRATION__FLEET_CALIBRATION_HPP_
@@ -44,17 +44,30 @@
 #include "ur_calibration/calibration_consumer.hpp"
 
 #include <memory>
+#include <string>
 
 namespace ur_calibration
 {
-CalibrationConsumer::CalibrationConsumer() : calibrated_(false)
+CalibrationConsumer::CalibrationConsumer(const std::string& known_hash)
+  : calibrated_(false), up_to_date_(false), known_hash_(known_hash)
 {
 }
 
 bool CalibrationConsumer::consume(std::shared_ptr<urcl::primary_interface::PrimaryPackage> product)
 {
   auto kin_info = std::dynamic_pointer_cast<urcl::primary_interface::KinematicsInfo>(product);
-  if (kin_info != nullptr) {
+  if (kin_info != nullptr && !isCalibrated()) {
+    const std::string hash = kin_info->toHash();
+    if (!known_hash_.empty() && hash == known_hash_) {
+      // The existing calibration stems from the same kinematics, no need to calculate it again
+      std::lock_guard<std::mutex> lock(mutex_);
+      hash_ = hash;
+      up_to_date_ = true;
+      calibrated_ = true;
+      calibrated_cv_.notify_all();
+      return true;
+    }
+
     RCLCPP_INFO(rclcpp::get_logger("ur_calibration"), "%s", product->toString().c_str());
     DHRobot my_robot;
     for (size_t i = 0; i < kin_info->dh_a_.size(); ++i) {
@@ -64,18 +77,40 @@ bool CalibrationConsumer::consume(std::shared_ptr<urcl::primary_interface::Prima
     Calibration calibration(my_robot);
     calibration.correctChain();
 
+    std::lock_guard<std::mutex> lock(mutex_);
     calibration_parameters_ = calibration.toYaml();
-    calibration_parameters_["kinematics"]["hash"] = kin_info->toHash();
+    calibration_parameters_["kinematics"]["hash"] = hash;
+    hash_ = hash;
     calibrated_ = true;
+    calibrated_cv_.notify_all();
   }
   return true;
 }
 
+bool CalibrationConsumer::waitForCalibration(std::chrono::milliseconds timeout) const
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  return calibrated_cv_.wait_for(lock, timeout, [this]() { return calibrated_; });
+}
+
+std::string CalibrationConsumer::getHash() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!calibrated_) {
+    throw(std::runtime_error("Cannot get hash, as no calibration data received yet"));
+  }
+  return hash_;
+}
+
 YAML::Node CalibrationConsumer::getCalibrationParameters() const
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (!calibrated_) {
     throw(std::runtime_error("Cannot get calibration, as no calibration data received yet"));
   }
+  if (up_to_date_) {
+    throw(std::runtime_error("Cannot get calibration, as the known calibration is up to date"));
+  }
   return calibration_parameters_;
 }
 }  // namespace ur_calibration
@@ -42,10 +42,13 @@
 //----------------------------------------------------------------------
 
 #include "ur_calibration/calibration_consumer.hpp"
+#include "ur_calibration/fleet_calibration.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "ur_client_library/comm/parser.h"
 #include "ur_client_library/comm/pipeline.h"
@@ -73,6 +76,8 @@ using urcl::primary_interface::PrimaryParser;
 using urcl::primary_interface::UR_PRIMARY_PORT;
 
 using ur_calibration::CalibrationConsumer;
+using ur_calibration::RobotCalibrationResult;
+using ur_calibration::RobotCalibrationTarget;
 
 class CalibrationCorrection : public rclcpp::Node
 {
@@ -84,6 +89,11 @@ public:
   {
     std::string output_package_name;
 
+    if (this->has_parameter("robot_ips")) {
+      readFleetParameters();
+      return;
+    }
+
     try {
       // The robot's IP address
       robot_ip_ = this->get_parameter("robot_ip").as_string();
@@ -97,6 +107,34 @@ public:
 
   virtual ~CalibrationCorrection() = default;
 
+  bool isFleet() const
+  {
+    return !fleet_.empty();
+  }
+
+  /*!
+   * \brief Extracts the calibrations of all robots of the fleet concurrently.
+   *
+   * \returns Whether all calibration files are up to date afterwards
+   */
+  bool runFleet()
+  {
+    const auto results = ur_calibration::calibrateRobots(fleet_, timeout_);
+    bool success = true;
+    for (const auto& result : results) {
+      if (result.outcome == RobotCalibrationResult::Outcome::WRITTEN ||
+          result.outcome == RobotCalibrationResult::Outcome::UP_TO_DATE) {
+        RCLCPP_INFO(this->get_logger(), "%s: %s (%s)", result.name.c_str(),
+                    ur_calibration::toString(result.outcome).c_str(), result.hash.c_str());
+      } else {
+        RCLCPP_ERROR(this->get_logger(), "%s: %s. %s", result.name.c_str(),
+                     ur_calibration::toString(result.outcome).c_str(), result.message.c_str());
+        success = false;
+      }
+    }
+    return success;
+  }
+
   void run()
   {
     URStream<PrimaryPackage> stream(robot_ip_, UR_PRIMARY_PORT);
@@ -108,8 +146,10 @@ public:
 
     Pipeline<PrimaryPackage> pipeline(prod, &consumer, "Pipeline", notifier);
     pipeline.run();
-    while (!consumer.isCalibrated()) {
-      rclcpp::sleep_for(rclcpp::Duration::from_seconds(0.1).to_chrono<std::chrono::nanoseconds>());
+    while (!consumer.waitForCalibration(std::chrono::seconds(1))) {
+      if (!rclcpp::ok()) {
+        return;
+      }
     }
     calibration_data_.reset(new YAML::Node);
     *calibration_data_ = consumer.getCalibrationParameters();
@@ -146,9 +186,37 @@ public:
   }
 
 private:
+  void readFleetParameters()
+  {
+    try {
+      // The robots' IP addresses
+      const auto robot_ips = this->get_parameter("robot_ips").as_string_array();
+      // The robots' names, each robot's calibration is written to <output_directory>/<name>_calibration.yaml
+      const auto robot_names = this->get_parameter("robot_names").as_string_array();
+      const std::string output_directory = this->get_parameter("output_directory").as_string();
+      // Time in seconds to wait for a robot reporting its kinematics
+      const double timeout = this->get_parameter_or("timeout", 30.0);
+      if (robot_names.size() != robot_ips.size()) {
+        RCLCPP_FATAL(this->get_logger(), "robot_names and robot_ips must be of the same size");
+        exit(1);
+      }
+
+      timeout_ = std::chrono::milliseconds(static_cast<int64_t>(timeout * 1000));
+      for (size_t i = 0; i < robot_ips.size(); ++i) {
+        fleet_.push_back({ robot_names[i], robot_ips[i], UR_PRIMARY_PORT,
+                           (fs::path(output_directory) / (robot_names[i] + "_calibration.yaml")).string() });
+      }
+    } catch (rclcpp::exceptions::ParameterNotDeclaredException& e) {
+      RCLCPP_FATAL_STREAM(this->get_logger(), e.what());
+      exit(1);
+    }
+  }
+
   std::string robot_ip_;
   std::string output_filename_;
   std::shared_ptr<YAML::Node> calibration_data_;
+  std::vector<RobotCalibrationTarget> fleet_;
+  std::chrono::milliseconds timeout_;
 };
 
 int main(int argc, char* argv[])
@@ -159,6 +227,11 @@ int main(int argc, char* argv[])
 
   try {
     auto calib_node = std::make_shared<CalibrationCorrection>();
+    if (calib_node->isFleet()) {
+      const bool success = calib_node->runFleet();
+      rclcpp::shutdown();
+      return success ? 0 : -1;
+    }
     calib_node->run();
     if (!calib_node->writeCalibrationData()) {
       RCLCPP_ERROR_STREAM(calib_node->get_logger(), "Failed writing calibration data. See errors above for details.");
@@ -0,0 +1,177 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_calibration/fleet_calibration.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/comm/producer.h"
+#include "ur_client_library/comm/stream.h"
+#include "ur_client_library/primary/primary_parser.h"
+
+#include "ur_calibration/calibration_consumer.hpp"
+
+namespace fs = std::filesystem;
+
+using urcl::comm::INotifier;
+using urcl::comm::Pipeline;
+using urcl::comm::URProducer;
+using urcl::comm::URStream;
+using urcl::primary_interface::PrimaryPackage;
+using urcl::primary_interface::PrimaryParser;
+
+namespace
+{
+// Interval between attempts to connect to a robot that doesn't accept the connection yet
+constexpr std::chrono::milliseconds CONNECT_RETRY_INTERVAL(500);
+}  // namespace
+
+namespace ur_calibration
+{
+std::string readCalibrationHash(const std::string& filename)
+{
+  if (!fs::exists(filename)) {
+    return "";
+  }
+  try {
+    const YAML::Node calibration = YAML::LoadFile(filename);
+    if (calibration["kinematics"] && calibration["kinematics"]["hash"]) {
+      return calibration["kinematics"]["hash"].as<std::string>();
+    }
+  } catch (const YAML::Exception& e) {
+    RCLCPP_WARN(rclcpp::get_logger("ur_calibration"), "Could not read existing calibration %s: %s", filename.c_str(),
+                e.what());
+  }
+  return "";
+}
+
+RobotCalibrationResult calibrateRobot(const RobotCalibrationTarget& robot, std::chrono::milliseconds timeout)
+{
+  RobotCalibrationResult result;
+  result.name = robot.name;
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  try {
+    const fs::path out_path = fs::absolute(robot.output_filename);
+    if (!fs::exists(out_path.parent_path())) {
+      result.message = "Parent folder " + out_path.parent_path().string() + " does not exist";
+      return result;
+    }
+
+    URStream<PrimaryPackage> stream(robot.robot_ip, robot.port);
+    PrimaryParser parser;
+    URProducer<PrimaryPackage> prod(stream, parser);
+    CalibrationConsumer consumer(readCalibrationHash(robot.output_filename));
+
+    INotifier notifier;
+
+    Pipeline<PrimaryPackage> pipeline(prod, &consumer, "Pipeline " + robot.name, notifier);
+    // Connecting is limited to the timeout, the pipeline would otherwise keep retrying to connect to an unreachable
+    // robot forever. Throws if the robot can't be connected to.
+    const size_t connect_attempts = std::max<size_t>(1, timeout / CONNECT_RETRY_INTERVAL);
+    pipeline.init(true, connect_attempts, CONNECT_RETRY_INTERVAL);
+    pipeline.run();
+    const auto remaining =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (!consumer.waitForCalibration(std::max(remaining, std::chrono::milliseconds(0)))) {
+      result.outcome = RobotCalibrationResult::Outcome::TIMED_OUT;
+      result.message = "No kinematics info received from " + robot.robot_ip;
+      return result;
+    }
+    pipeline.stop();
+
+    result.hash = consumer.getHash();
+    if (consumer.isUpToDate()) {
+      result.outcome = RobotCalibrationResult::Outcome::UP_TO_DATE;
+      return result;
+    }
+
+    std::ofstream file(out_path);
+    if (!file.is_open()) {
+      result.message = "Could not open " + out_path.string() + " for writing";
+      return result;
+    }
+    file << consumer.getCalibrationParameters();
+    result.outcome = RobotCalibrationResult::Outcome::WRITTEN;
+  } catch (const std::exception& e) {
+    result.message = e.what();
+  }
+  return result;
+}
+
+std::vector<RobotCalibrationResult> calibrateRobots(const std::vector<RobotCalibrationTarget>& robots,
+                                                    std::chrono::milliseconds timeout)
+{
+  // Each robot gets its own pipeline, so slow or unreachable robots don't hold up the others
+  std::vector<std::future<RobotCalibrationResult>> pending;
+  pending.reserve(robots.size());
+  for (const auto& robot : robots) {
+    pending.push_back(std::async(std::launch::async, calibrateRobot, robot, timeout));
+  }
+
+  std::vector<RobotCalibrationResult> results;
+  results.reserve(robots.size());
+  for (auto& result : pending) {
+    results.push_back(result.get());
+  }
+  return results;
+}
+
+std::string toString(RobotCalibrationResult::Outcome outcome)
+{
+  switch (outcome) {
+    case RobotCalibrationResult::Outcome::WRITTEN:
+      return "written";
+    case RobotCalibrationResult::Outcome::UP_TO_DATE:
+      return "up to date";
+    case RobotCalibrationResult::Outcome::TIMED_OUT:
+      return "timed out";
+    case RobotCalibrationResult::Outcome::FAILED:
+      return "failed";
+  }
+  return "unknown";
+}
+}  // namespace ur_calibration
@@ -0,0 +1,197 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "ur_calibration/calibrated_fk.hpp"
+#include "ur_calibration/calibration.hpp"
+
+using ur_calibration::CalibratedFK;
+using ur_calibration::Calibration;
+using ur_calibration::DHRobot;
+using ur_calibration::DHSegment;
+
+namespace
+{
+const double pi_2 = 1.570796327;  // This is what the simulated robot reports as pi/2
+
+DHRobot model_from_dh(std::array<double, 6> d, std::array<double, 6> a, std::array<double, 6> theta,
+                      std::array<double, 6> alpha)
+{
+  DHRobot robot;
+  for (size_t i = 0; i < 6; ++i) {
+    robot.segments_.emplace_back(DHSegment(d[i], a[i], theta[i], alpha[i]));
+  }
+  return robot;
+}
+
+DHRobot ur10()
+{
+  return model_from_dh({ 0.1273, 0, 0, 0.163941, 0.1157, 0.0922 },  // d
+                       { 0, -0.612, -0.5723, 0, 0, 0 },             // a
+                       { 0, 0, 0, 0, 0, 0 },                        // theta
+                       { pi_2, 0, 0, pi_2, -pi_2, 0 }               // alpha
+  );
+}
+
+// A ur10e model including a calibration as stored on the robot controller
+DHRobot calibratedUr10e()
+{
+  return model_from_dh({ 0.1807, 0, 0, 0.17415, 0.11985, 0.11655 },  // d
+                       { 0, -0.6127, -0.57155, 0, 0, 0 },            // a
+                       { 0, 0, 0, 0, 0, 0 },                         // theta
+                       { pi_2, 0, 0, pi_2, -pi_2, 0 }                // alpha
+                       ) +
+         model_from_dh({ -0.000144894975118076141, 303.469135666158195, -309.88394307789747, 6.41459904397394975,
+                         -4.48232900190081995e-05, -0.00087071402790364627 },  // d
+                       { 0.000108651068627930392, 0.240324175250532346, 0.00180628180213493472,
+                         2.63076149165684402e-05, 3.96638632500012715e-06, 0 },  // a
+                       { 1.59613525316931737e-07, -0.917209621528830232, 7.12936131346499469, 0.0710299029424392298,
+                         -1.64258976526054923e-06, 9.17286101034808787e-08 },  // theta
+                       { -0.000444781952841921679, -0.00160215112531214153, 0.00631917793331091861,
+                         -0.00165055247340828437, 0.000763682515545038854, 0 }  // alpha
+         );
+}
+
+void expectPoseNear(const Eigen::Matrix4d& expected, const Eigen::Matrix4d& actual, const double precision)
+{
+  for (Eigen::Index row = 0; row < 4; ++row) {
+    for (Eigen::Index col = 0; col < 4; ++col) {
+      EXPECT_NEAR(expected(row, col), actual(row, col), precision) << "at (" << row << ", " << col << ")";
+    }
+  }
+}
+}  // namespace
+
+TEST(CalibratedFKTest, reference_poses)
+{
+  // Positions taken from a simulated robot, see calibration_test.cpp
+  Calibration calibration(ur10());
+  const CalibratedFK fk(calibration);
+
+  CalibratedFK::JointVector jointvalues;
+  jointvalues << -1.6007002035724084976209269370884, -1.7271001974688928726209269370884,
+      -2.2029998938189905288709269370884, -0.80799991289247685699592693708837, 1.59510004520416259765625,
+      -0.03099996248354131012092693708837;
+  Eigen::Vector3d position = fk.forward(jointvalues).topRightCorner<3, 1>();
+  EXPECT_NEAR(position.x(), -0.179925914147547, 1e-15);
+  EXPECT_NEAR(position.y(), -0.606869755162764, 1e-15);
+  EXPECT_NEAR(position.z(), 0.230789102067257, 1e-15);
+
+  jointvalues << 1.32645022869110107421875, 2.426007747650146484375, 5.951572895050048828125,
+      1.27409040927886962890625, -0.54105216661562138824592693708837, 0.122173048555850982666015625;
+  position = fk.forward(jointvalues).topRightCorner<3, 1>();
+  EXPECT_NEAR(position.x(), 0.39922988003280424074148413637886, 1e-15);
+  EXPECT_NEAR(position.y(), 0.59688365069340565405298093537567, 1e-15);
+  EXPECT_NEAR(position.z(), -0.6677819040276375961440180617501, 1e-15);
+}
+
+TEST(CalibratedFKTest, matches_corrected_chain)
+{
+  Calibration calibration(calibratedUr10e());
+  calibration.correctChain();
+  const CalibratedFK fk(calibration);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const CalibratedFK::JointVector jointvalues = 2 * M_PI * CalibratedFK::JointVector::Random();
+    expectPoseNear(calibration.calcForwardKinematics(jointvalues), fk.forward(jointvalues), 1e-12);
+  }
+}
+
+TEST(CalibratedFKTest, jacobian_matches_finite_differences)
+{
+  Calibration calibration(calibratedUr10e());
+  calibration.correctChain();
+  const CalibratedFK fk(calibration);
+  const double step = 1e-6;
+
+  for (size_t i = 0; i < 100; ++i) {
+    const CalibratedFK::JointVector jointvalues = 2 * M_PI * CalibratedFK::JointVector::Random();
+    CalibratedFK::Jacobian jacobian;
+    const Eigen::Matrix4d pose = fk.forward(jointvalues, jacobian);
+    expectPoseNear(fk.forward(jointvalues), pose, 1e-15);
+
+    for (Eigen::Index joint = 0; joint < 6; ++joint) {
+      CalibratedFK::JointVector delta = CalibratedFK::JointVector::Zero();
+      delta(joint) = step;
+      const Eigen::Matrix4d forward = fk.forward(jointvalues + delta);
+      const Eigen::Matrix4d backward = fk.forward(jointvalues - delta);
+
+      const Eigen::Vector3d linear = (forward.topRightCorner<3, 1>() - backward.topRightCorner<3, 1>()) / (2 * step);
+      // Angular velocity from the skew-symmetric part of dR/dq * R^T
+      const Eigen::Matrix3d skew = (forward.topLeftCorner<3, 3>() - backward.topLeftCorner<3, 3>()) / (2 * step) *
+                                   pose.topLeftCorner<3, 3>().transpose();
+      const Eigen::Vector3d angular(skew(2, 1), skew(0, 2), skew(1, 0));
+
+      for (Eigen::Index k = 0; k < 3; ++k) {
+        EXPECT_NEAR(jacobian(k, joint), linear(k), 1e-8);
+        EXPECT_NEAR(jacobian(3 + k, joint), angular(k), 1e-8);
+      }
+    }
+  }
+}
+
+TEST(CalibratedFKTest, batch_matches_single_evaluation)
+{
+  Calibration calibration(calibratedUr10e());
+  calibration.correctChain();
+  const CalibratedFK fk(calibration);
+
+  const CalibratedFK::JointBatch jointvalues = 2 * M_PI * CalibratedFK::JointBatch::Random(6, 257);
+  CalibratedFK::PoseBatch poses;
+  fk.forward(jointvalues, poses);
+
+  ASSERT_EQ(poses.cols(), jointvalues.cols());
+  for (Eigen::Index i = 0; i < jointvalues.cols(); ++i) {
+    expectPoseNear(fk.forward(CalibratedFK::JointVector(jointvalues.col(i))), CalibratedFK::pose(poses, i), 1e-14);
+  }
+}
+
+TEST(CalibratedFKTest, rejects_short_chain)
+{
+  Calibration calibration(ur10());
+  std::vector<Eigen::Matrix4d> chain = calibration.getSimplified();
+  chain.resize(5);
+  EXPECT_THROW(CalibratedFK fk(chain), std::invalid_argument);
+}
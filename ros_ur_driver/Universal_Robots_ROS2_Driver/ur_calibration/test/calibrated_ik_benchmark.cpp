@@ -0,0 +1,138 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "ur_calibration/calibrated_fk.hpp"
+#include "ur_calibration/calibrated_ik.hpp"
+#include "ur_calibration/calibration.hpp"
+
+using ur_calibration::CalibratedFK;
+using ur_calibration::CalibratedIK;
+using ur_calibration::Calibration;
+using ur_calibration::DHRobot;
+using ur_calibration::DHSegment;
+using JointVector = CalibratedIK::JointVector;
+
+namespace
+{
+const double pi_2 = 1.570796327;  // This is what the simulated robot reports as pi/2
+
+DHRobot model_from_dh(std::array<double, 6> d, std::array<double, 6> a, std::array<double, 6> theta,
+                      std::array<double, 6> alpha)
+{
+  DHRobot robot;
+  for (size_t i = 0; i < 6; ++i) {
+    robot.segments_.emplace_back(DHSegment(d[i], a[i], theta[i], alpha[i]));
+  }
+  return robot;
+}
+
+DHRobot ur10e()
+{
+  return model_from_dh({ 0.1807, 0, 0, 0.17415, 0.11985, 0.11655 },  // d
+                       { 0, -0.6127, -0.57155, 0, 0, 0 },            // a
+                       { 0, 0, 0, 0, 0, 0 },                         // theta
+                       { pi_2, 0, 0, pi_2, -pi_2, 0 }                // alpha
+  );
+}
+
+// The calibration of a ur10e as stored on the robot controller
+DHRobot ur10eCalibration()
+{
+  return model_from_dh({ -0.000144894975118076141, 303.469135666158195, -309.88394307789747, 6.41459904397394975,
+                         -4.48232900190081995e-05, -0.00087071402790364627 },  // d
+                       { 0.000108651068627930392, 0.240324175250532346, 0.00180628180213493472,
+                         2.63076149165684402e-05, 3.96638632500012715e-06, 0 },  // a
+                       { 1.59613525316931737e-07, -0.917209621528830232, 7.12936131346499469, 0.0710299029424392298,
+                         -1.64258976526054923e-06, 9.17286101034808787e-08 },  // theta
+                       { -0.000444781952841921679, -0.00160215112531214153, 0.00631917793331091861,
+                         -0.00165055247340828437, 0.000763682515545038854, 0 }  // alpha
+  );
+}
+
+CalibratedFK calibratedUr10e()
+{
+  Calibration calibration(ur10e() + ur10eCalibration());
+  calibration.correctChain();
+  return CalibratedFK(calibration);
+}
+}  // namespace
+
+TEST(CalibratedIKBenchmark, solve_speed)
+{
+  constexpr size_t COUNT = 10000;
+  const CalibratedFK fk = calibratedUr10e();
+  const CalibratedIK ik(ur10e(), fk);
+
+  std::vector<Eigen::Matrix4d> poses;
+  std::vector<JointVector> seeds;
+  for (size_t i = 0; i < COUNT; ++i) {
+    poses.push_back(fk.forward(M_PI * JointVector::Random()));
+    seeds.push_back(M_PI * JointVector::Random());
+  }
+
+  size_t closed_form_solved = 0;
+  const auto closed_form_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < COUNT; ++i) {
+    closed_form_solved += ik.solve(poses[i], seeds[i]).empty() ? 0 : 1;
+  }
+  const std::chrono::duration<double> closed_form = std::chrono::steady_clock::now() - closed_form_start;
+
+  // For comparison, a purely iterative solver like KDL's, starting from the seed
+  const CalibratedIK iterative_ik(ur10e(), fk, 1e-10, 100);
+  size_t iterative_solved = 0;
+  const auto iterative_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < COUNT; ++i) {
+    JointVector solution = seeds[i];
+    iterative_solved += iterative_ik.refine(poses[i], solution) ? 1 : 0;
+  }
+  const std::chrono::duration<double> iterative = std::chrono::steady_clock::now() - iterative_start;
+
+  EXPECT_EQ(closed_form_solved, COUNT);
+  std::cout << "Inverse kinematics: " << COUNT / closed_form.count() << " calls/s solving " << closed_form_solved
+            << " of " << COUNT << " poses closed-form, " << COUNT / iterative.count() << " calls/s solving "
+            << iterative_solved << " poses iteratively from the seed" << std::endl;
+}
@@ -0,0 +1,234 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "ur_calibration/calibrated_fk.hpp"
+#include "ur_calibration/calibrated_ik.hpp"
+#include "ur_calibration/calibration.hpp"
+
+using ur_calibration::CalibratedFK;
+using ur_calibration::CalibratedIK;
+using ur_calibration::Calibration;
+using ur_calibration::DHRobot;
+using ur_calibration::DHSegment;
+using JointVector = CalibratedIK::JointVector;
+
+namespace
+{
+const double pi_2 = 1.570796327;  // This is what the simulated robot reports as pi/2
+
+DHRobot model_from_dh(std::array<double, 6> d, std::array<double, 6> a, std::array<double, 6> theta,
+                      std::array<double, 6> alpha)
+{
+  DHRobot robot;
+  for (size_t i = 0; i < 6; ++i) {
+    robot.segments_.emplace_back(DHSegment(d[i], a[i], theta[i], alpha[i]));
+  }
+  return robot;
+}
+
+DHRobot ur5()
+{
+  return model_from_dh({ 0.089159, 0, 0, 0.10915, 0.09465, 0.0823 },  // d
+                       { 0, -0.425, -0.39225, 0, 0, 0 },              // a
+                       { 0, 0, 0, 0, 0, 0 },                          // theta
+                       { pi_2, 0, 0, pi_2, -pi_2, 0 }                 // alpha
+  );
+}
+
+DHRobot ur10e()
+{
+  return model_from_dh({ 0.1807, 0, 0, 0.17415, 0.11985, 0.11655 },  // d
+                       { 0, -0.6127, -0.57155, 0, 0, 0 },            // a
+                       { 0, 0, 0, 0, 0, 0 },                         // theta
+                       { pi_2, 0, 0, pi_2, -pi_2, 0 }                // alpha
+  );
+}
+
+CalibratedFK ur5Kinematics()
+{
+  return CalibratedFK(Calibration(ur5()));
+}
+
+// The calibration of a ur10e as stored on the robot controller
+DHRobot ur10eCalibration()
+{
+  return model_from_dh({ -0.000144894975118076141, 303.469135666158195, -309.88394307789747, 6.41459904397394975,
+                         -4.48232900190081995e-05, -0.00087071402790364627 },  // d
+                       { 0.000108651068627930392, 0.240324175250532346, 0.00180628180213493472,
+                         2.63076149165684402e-05, 3.96638632500012715e-06, 0 },  // a
+                       { 1.59613525316931737e-07, -0.917209621528830232, 7.12936131346499469, 0.0710299029424392298,
+                         -1.64258976526054923e-06, 9.17286101034808787e-08 },  // theta
+                       { -0.000444781952841921679, -0.00160215112531214153, 0.00631917793331091861,
+                         -0.00165055247340828437, 0.000763682515545038854, 0 }  // alpha
+  );
+}
+
+CalibratedFK calibratedUr10e()
+{
+  Calibration calibration(ur10e() + ur10eCalibration());
+  calibration.correctChain();
+  return CalibratedFK(calibration);
+}
+
+double poseError(const Eigen::Matrix4d& expected, const Eigen::Matrix4d& actual)
+{
+  const Eigen::AngleAxisd rotation_error(expected.topLeftCorner<3, 3>() * actual.topLeftCorner<3, 3>().transpose());
+  return (expected.topRightCorner<3, 1>() - actual.topRightCorner<3, 1>()).norm() + rotation_error.angle();
+}
+
+double jointDistance(const JointVector& a, const JointVector& b)
+{
+  double distance = 0.0;
+  for (Eigen::Index i = 0; i < 6; ++i) {
+    distance = std::max(distance, std::abs(std::remainder(a(i) - b(i), 2 * M_PI)));
+  }
+  return distance;
+}
+}  // namespace
+
+TEST(CalibratedIKTest, nominal_solutions_reproduce_pose)
+{
+  const CalibratedFK fk = ur5Kinematics();
+  const CalibratedIK ik(ur5(), fk);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const JointVector jointvalues = M_PI * JointVector::Random();
+    const Eigen::Matrix4d pose = fk.forward(jointvalues);
+
+    const std::vector<JointVector> solutions = ik.solveNominal(pose);
+    // Poses close to the base axis or the workspace boundary can't be reached with every branch
+    ASSERT_GE(solutions.size(), 1u);
+    ASSERT_LE(solutions.size(), 8u);
+    double nearest = M_PI;
+    for (const auto& solution : solutions) {
+      EXPECT_LT(poseError(pose, fk.forward(solution)), 1e-9);
+      nearest = std::min(nearest, jointDistance(jointvalues, solution));
+    }
+    // Joint positions are less accurate than the pose close to singularities
+    EXPECT_LT(nearest, 1e-5);
+  }
+}
+
+TEST(CalibratedIKTest, solutions_reach_calibrated_pose)
+{
+  const CalibratedFK fk = calibratedUr10e();
+  const CalibratedIK ik(ur10e(), fk);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const JointVector jointvalues = M_PI * JointVector::Random();
+    const Eigen::Matrix4d pose = fk.forward(jointvalues);
+    const JointVector seed = jointvalues + 0.1 * JointVector::Random();
+
+    const std::vector<JointVector> solutions = ik.solve(pose, seed);
+    ASSERT_FALSE(solutions.empty());
+    double nearest = M_PI;
+    for (const auto& solution : solutions) {
+      EXPECT_LT(poseError(pose, fk.forward(solution)), 1e-9);
+      EXPECT_LE((solution - seed).cwiseAbs().maxCoeff(), M_PI + 1e-12);
+      nearest = std::min(nearest, (solution - jointvalues).cwiseAbs().maxCoeff());
+    }
+    // Close to singularities, the pose hardly determines some of the joints, so another solution may be found
+    // instead
+    CalibratedFK::Jacobian jacobian;
+    fk.forward(jointvalues, jacobian);
+    if (std::abs(jacobian.determinant()) > 1e-3) {
+      EXPECT_LE((solutions.front() - seed).squaredNorm(), (jointvalues - seed).squaredNorm() + 1e-6);
+      EXPECT_LT(nearest, 1e-6);
+    }
+  }
+}
+
+TEST(CalibratedIKTest, nominal_model_misses_calibrated_pose)
+{
+  // Without the refinement, the closed-form solution is off by the calibration
+  const CalibratedFK fk = calibratedUr10e();
+  const CalibratedIK ik(ur10e(), fk, 1e-10, 0);
+
+  JointVector jointvalues;
+  jointvalues << 0.3, -1.2, 1.5, -0.4, 1.1, 0.2;
+  const Eigen::Matrix4d pose = fk.forward(jointvalues);
+  const JointVector seed = jointvalues + JointVector::Constant(0.05);
+  EXPECT_TRUE(ik.solve(pose, seed).empty());
+
+  const CalibratedIK refining_ik(ur10e(), fk);
+  EXPECT_FALSE(refining_ik.solve(pose, seed).empty());
+}
+
+TEST(CalibratedIKTest, wrist_singularity_keeps_seed)
+{
+  const CalibratedFK fk = ur5Kinematics();
+  const CalibratedIK ik(ur5(), fk);
+
+  // With wrist 2 at zero, wrist 1 and wrist 3 rotate about the same axis
+  JointVector jointvalues;
+  jointvalues << 0.3, -1.2, 1.5, -0.4, 0.0, 0.2;
+  const Eigen::Matrix4d pose = fk.forward(jointvalues);
+
+  const std::vector<JointVector> solutions = ik.solve(pose, jointvalues);
+  ASSERT_FALSE(solutions.empty());
+  EXPECT_LT((solutions.front() - jointvalues).cwiseAbs().maxCoeff(), 1e-8);
+  for (const auto& solution : solutions) {
+    EXPECT_LT(poseError(pose, fk.forward(solution)), 1e-9);
+  }
+}
+
+TEST(CalibratedIKTest, unreachable_pose)
+{
+  const CalibratedFK fk = ur5Kinematics();
+  const CalibratedIK ik(ur5(), fk);
+
+  Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+  pose(0, 3) = 2.0;
+  EXPECT_TRUE(ik.solveNominal(pose).empty());
+  EXPECT_TRUE(ik.solve(pose, JointVector::Zero()).empty());
+}
+
+TEST(CalibratedIKTest, rejects_incomplete_model)
+{
+  DHRobot robot = ur5();
+  robot.segments_.pop_back();
+  EXPECT_THROW(CalibratedIK(robot, ur5Kinematics()), std::invalid_argument);
+}
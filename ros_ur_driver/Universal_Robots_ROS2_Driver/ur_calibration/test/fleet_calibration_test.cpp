@@ -0,0 +1,319 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Created on behalf of Universal Robots A/S
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// -- END LICENSE BLOCK ------------------------------------------------
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_calibration/fleet_calibration.hpp"
+
+namespace fs = std::filesystem;
+
+using ur_calibration::RobotCalibrationResult;
+using ur_calibration::RobotCalibrationTarget;
+using namespace std::chrono_literals;
+
+namespace
+{
+using DHParameters = std::array<std::array<double, 6>, 4>;  // theta, a, d, alpha
+
+const double pi_2 = 1.570796327;  // This is what the simulated robot reports as pi/2
+const DHParameters UR10 = { { { 0, 0, 0, 0, 0, 0 },
+                              { 0, -0.612, -0.5723, 0, 0, 0 },
+                              { 0.1273, 0, 0, 0.163941, 0.1157, 0.0922 },
+                              { pi_2, 0, 0, pi_2, -pi_2, 0 } } };
+const DHParameters UR10E = { { { 0, 0, 0, 0, 0, 0 },
+                               { 0, -0.6127, -0.57155, 0, 0, 0 },
+                               { 0.1807, 0, 0, 0.17415, 0.11985, 0.11655 },
+                               { pi_2, 0, 0, pi_2, -pi_2, 0 } } };
+
+void appendUInt32(std::vector<uint8_t>& package, uint32_t value)
+{
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    package.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void appendDouble(std::vector<uint8_t>& package, double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    package.push_back(static_cast<uint8_t>(bits >> shift));
+  }
+}
+
+/*!
+ * \brief Local stand-in for a robot's primary interface, sending a robot state with the kinematics info.
+ *
+ * Every connected client gets the robot state at 50 Hz, until the client disconnects.
+ */
+class FakePrimaryServer
+{
+public:
+  explicit FakePrimaryServer(const DHParameters& dh) : dh_(dh)
+  {
+    server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    bind(server_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    listen(server_fd_, 4);
+    socklen_t length = sizeof(address);
+    getsockname(server_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    accept_thread_ = std::thread([this]() {
+      int client_fd;
+      while ((client_fd = accept(server_fd_, nullptr, nullptr)) >= 0) {
+        client_threads_.emplace_back(&FakePrimaryServer::serve, this, client_fd);
+      }
+    });
+  }
+
+  ~FakePrimaryServer()
+  {
+    running_ = false;
+    shutdown(server_fd_, SHUT_RDWR);
+    close(server_fd_);
+    accept_thread_.join();
+    for (auto& thread : client_threads_) {
+      thread.join();
+    }
+  }
+
+  int port() const
+  {
+    return port_;
+  }
+
+  void setKinematics(const DHParameters& dh)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dh_ = dh;
+  }
+
+  // Keeps the connection open without ever sending anything
+  void setSilent(bool silent)
+  {
+    silent_ = silent;
+  }
+
+private:
+  std::vector<uint8_t> robotState()
+  {
+    std::vector<uint8_t> kinematics_info;
+    appendUInt32(kinematics_info, 4 + 1 + 6 * 4 + 4 * 6 * 8 + 4);
+    kinematics_info.push_back(5);
+    for (size_t i = 0; i < 6; ++i) {
+      appendUInt32(kinematics_info, 0);  // checksum
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& parameter : dh_) {
+        for (const double value : parameter) {
+          appendDouble(kinematics_info, value);
+        }
+      }
+    }
+    appendUInt32(kinematics_info, 1);  // calibration status
+
+    std::vector<uint8_t> package;
+    appendUInt32(package, static_cast<uint32_t>(4 + 1 + kinematics_info.size()));
+    package.push_back(16);
+    package.insert(package.end(), kinematics_info.begin(), kinematics_info.end());
+    return package;
+  }
+
+  void serve(int client_fd)
+  {
+    while (running_) {
+      if (!silent_) {
+        const auto package = robotState();
+        if (send(client_fd, package.data(), package.size(), MSG_NOSIGNAL) <= 0) {
+          break;
+        }
+      }
+      std::this_thread::sleep_for(20ms);
+    }
+    close(client_fd);
+  }
+
+  int server_fd_;
+  int port_;
+  std::mutex mutex_;
+  DHParameters dh_;
+  std::atomic<bool> running_{ true };
+  std::atomic<bool> silent_{ false };
+  std::thread accept_thread_;
+  std::vector<std::thread> client_threads_;
+};
+
+class FleetCalibrationTest : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    output_directory_ = fs::temp_directory_path() / ("ur_calibration_fleet_test_" + std::to_string(getpid()));
+    fs::create_directories(output_directory_);
+  }
+  void TearDown()
+  {
+    fs::remove_all(output_directory_);
+  }
+
+protected:
+  RobotCalibrationTarget target(const std::string& name, const FakePrimaryServer& server) const
+  {
+    return { name, "127.0.0.1", server.port(), (output_directory_ / (name + "_calibration.yaml")).string() };
+  }
+
+  fs::path output_directory_;
+};
+}  // namespace
+
+TEST_F(FleetCalibrationTest, writes_calibration_per_robot_and_skips_unchanged_robots)
+{
+  FakePrimaryServer ur10(UR10);
+  FakePrimaryServer ur10e(UR10E);
+  const std::vector<RobotCalibrationTarget> robots = { target("ex-ur10-1", ur10), target("ex-ur10e-1", ur10e) };
+
+  auto results = ur_calibration::calibrateRobots(robots, 10s);
+  ASSERT_EQ(results.size(), 2u);
+  for (size_t i = 0; i < robots.size(); ++i) {
+    EXPECT_EQ(results[i].name, robots[i].name);
+    EXPECT_EQ(results[i].outcome, RobotCalibrationResult::Outcome::WRITTEN) << results[i].message;
+    EXPECT_EQ(ur_calibration::readCalibrationHash(robots[i].output_filename), results[i].hash);
+  }
+  EXPECT_NE(results[0].hash, results[1].hash);
+  const std::string ur10_hash = results[0].hash;
+  const auto ur10e_write_time = fs::last_write_time(robots[1].output_filename);
+
+  // Nothing changed, so the files are left untouched
+  results = ur_calibration::calibrateRobots(robots, 10s);
+  EXPECT_EQ(results[0].outcome, RobotCalibrationResult::Outcome::UP_TO_DATE);
+  EXPECT_EQ(results[1].outcome, RobotCalibrationResult::Outcome::UP_TO_DATE);
+  EXPECT_EQ(results[0].hash, ur10_hash);
+  EXPECT_EQ(fs::last_write_time(robots[1].output_filename), ur10e_write_time);
+
+  // Only the recalibrated robot gets a new file
+  DHParameters recalibrated = UR10;
+  recalibrated[2][0] += 0.0001;
+  ur10.setKinematics(recalibrated);
+  results = ur_calibration::calibrateRobots(robots, 10s);
+  EXPECT_EQ(results[0].outcome, RobotCalibrationResult::Outcome::WRITTEN);
+  EXPECT_NE(results[0].hash, ur10_hash);
+  EXPECT_EQ(ur_calibration::readCalibrationHash(robots[0].output_filename), results[0].hash);
+  EXPECT_EQ(results[1].outcome, RobotCalibrationResult::Outcome::UP_TO_DATE);
+}
+
+TEST_F(FleetCalibrationTest, reports_robots_without_kinematics_info)
+{
+  FakePrimaryServer ur10(UR10);
+  FakePrimaryServer silent(UR10E);
+  silent.setSilent(true);
+
+  const auto results =
+      ur_calibration::calibrateRobots({ target("ex-ur10-1", ur10), target("ex-ur10e-1", silent) }, 500ms);
+  EXPECT_EQ(results[0].outcome, RobotCalibrationResult::Outcome::WRITTEN) << results[0].message;
+  EXPECT_EQ(results[1].outcome, RobotCalibrationResult::Outcome::TIMED_OUT);
+  EXPECT_FALSE(fs::exists(target("ex-ur10e-1", silent).output_filename));
+}
+
+TEST_F(FleetCalibrationTest, reports_unreachable_robots_within_timeout)
+{
+  // A port nobody listens on, like the primary interface of a powered off robot
+  const int closed_fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(closed_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  socklen_t length = sizeof(address);
+  getsockname(closed_fd, reinterpret_cast<sockaddr*>(&address), &length);
+  close(closed_fd);
+
+  FakePrimaryServer ur10(UR10);
+  const RobotCalibrationTarget unreachable = {
+    "ex-ur10e-1", "127.0.0.1", ntohs(address.sin_port), (output_directory_ / "ex-ur10e-1_calibration.yaml").string()
+  };
+  const auto start = std::chrono::steady_clock::now();
+  const auto results = ur_calibration::calibrateRobots({ target("ex-ur10-1", ur10), unreachable }, 2s);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 4s);
+
+  EXPECT_EQ(results[0].outcome, RobotCalibrationResult::Outcome::WRITTEN) << results[0].message;
+  EXPECT_THAT(results[1].outcome, ::testing::AnyOf(RobotCalibrationResult::Outcome::FAILED,
+                                                   RobotCalibrationResult::Outcome::TIMED_OUT));
+  EXPECT_FALSE(fs::exists(unreachable.output_filename));
+}
+
+TEST_F(FleetCalibrationTest, reports_missing_output_directory)
+{
+  FakePrimaryServer ur10(UR10);
+  RobotCalibrationTarget robot = target("ex-ur10-1", ur10);
+  robot.output_filename = (output_directory_ / "missing" / "ex-ur10-1_calibration.yaml").string();
+
+  const auto result = ur_calibration::calibrateRobot(robot, 10s);
+  EXPECT_EQ(result.outcome, RobotCalibrationResult::Outcome::FAILED);
+  EXPECT_THAT(result.message, ::testing::HasSubstr("does not exist"));
+}
+
+TEST_F(FleetCalibrationTest, reads_no_hash_from_missing_or_foreign_files)
+{
+  EXPECT_EQ(ur_calibration::readCalibrationHash((output_directory_ / "missing.yaml").string()), "");
+
+  const std::string foreign = (output_directory_ / "foreign.yaml").string();
+  std::ofstream(foreign) << "kinematics:\n  shoulder:\n    x: 0\n";
+  EXPECT_EQ(ur_calibration::readCalibrationHash(foreign), "");
+}
@@ -0,0 +1,147 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_CONTROLLERS__FINISHED_GOAL_HANDOFF_HPP_
+#define UR_CONTROLLERS__FINISHED_GOAL_HANDOFF_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ur_controllers/spsc_queue.hpp"
+
+namespace ur_controllers
+{
+/*!
+ * \brief Hands goals finished in the real-time loop over to a non-real-time thread, which removes them from the goal
+ * buffer.
+ *
+ * Writing the goal buffer locks a mutex, so the real-time loop only marks a goal as finished. The finished goal may
+ * still be read from the goal buffer afterwards and has to be skipped then, otherwise it would be finished twice.
+ *
+ * \tparam GoalPtr Shared pointer to a goal
+ * \tparam Capacity Maximum number of finished goals waiting to be released
+ */
+template <typename GoalPtr, size_t Capacity>
+class FinishedGoalHandoff
+{
+public:
+  /*!
+   * \brief Marks a goal as finished, may only be called from the real-time thread.
+   *
+   * \param goal Finished goal, may be empty if only \p next_goal should be put into the goal buffer
+   * \param next_goal Goal to put into the goal buffer instead, if the finished goal is still in there
+   *
+   * \returns False if too many goals are waiting to be released, the goal buffer has to be written directly then
+   */
+  bool finish(const GoalPtr& goal, const GoalPtr& next_goal)
+  {
+    const uint64_t epoch = epoch_ + 1;
+    if (finished_goals_[epoch % finished_goals_.size()] != nullptr || !queue_.push(Entry{ goal, next_goal, epoch })) {
+      return false;
+    }
+    epoch_ = epoch;
+    finished_goals_[epoch % finished_goals_.size()] = goal.get();
+    return true;
+  }
+
+  /*!
+   * \brief Checks whether the goal read from the goal buffer was finished already, has to be called from the
+   * real-time thread in every cycle.
+   *
+   * \param goal Goal read from the goal buffer in this cycle, may be empty
+   */
+  bool is_finished(const GoalPtr& goal)
+  {
+    // A RealtimeBuffer keeps returning its previous goal while it can't be locked, so a finished goal can only be
+    // forgotten once it is released and a different goal has been read. Until then it is referenced, so no new goal
+    // can get its address.
+    const uint64_t released_epoch = released_epoch_.load(std::memory_order_acquire);
+    bool finished = false;
+    for (uint64_t epoch = forgotten_epoch_ + 1; epoch <= epoch_; ++epoch) {
+      const void*& finished_goal = finished_goals_[epoch % finished_goals_.size()];
+      if (finished_goal == nullptr) {
+        continue;
+      }
+      if (finished_goal == goal.get()) {
+        finished = true;
+      } else if (epoch <= released_epoch) {
+        finished_goal = nullptr;
+      }
+    }
+    while (forgotten_epoch_ < epoch_ && finished_goals_[(forgotten_epoch_ + 1) % finished_goals_.size()] == nullptr) {
+      ++forgotten_epoch_;
+    }
+    return finished;
+  }
+
+  /*!
+   * \brief Releases all finished goals, may only be called from the non-real-time thread.
+   *
+   * \param release_goal Called with each finished goal and its next goal, has to replace the finished goal in the goal
+   * buffer by the next goal, if the finished goal is still in there
+   */
+  template <typename ReleaseFunction>
+  void release(ReleaseFunction&& release_goal)
+  {
+    Entry entry;
+    while (queue_.pop(entry)) {
+      release_goal(entry.goal, entry.next_goal);
+      released_epoch_.store(entry.epoch, std::memory_order_release);
+      entry = Entry();
+    }
+  }
+
+private:
+  struct Entry
+  {
+    GoalPtr goal;
+    GoalPtr next_goal;
+    uint64_t epoch{};
+  };
+
+  SPSCQueue<Entry, Capacity> queue_;
+  std::atomic<uint64_t> released_epoch_{ 0 };
+
+  // Only used by the real-time thread, a goal stays in here after its release until it is forgotten
+  std::array<const void*, Capacity + 1> finished_goals_{};
+  uint64_t epoch_{ 0 };
+  uint64_t forgotten_epoch_{ 0 };
+};
+}  // namespace ur_controllers
+
+#endif  // UR_CONTROLLERS__FINISHED_GOAL_HANDOFF_HPP_
@@ -38,7 +38,11 @@
 #ifndef UR_CONTROLLERS__GPIO_CONTROLLER_HPP_
 #define UR_CONTROLLERS__GPIO_CONTROLLER_HPP_
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -46,10 +50,12 @@
 #include "std_srvs/srv/trigger.hpp"
 
 #include "controller_interface/controller_interface.hpp"
+#include "realtime_tools/realtime_publisher.h"
 #include "ur_msgs/msg/io_states.hpp"
 #include "ur_msgs/msg/tool_data_msg.hpp"
 #include "ur_dashboard_msgs/msg/robot_mode.hpp"
 #include "ur_dashboard_msgs/msg/safety_mode.hpp"
+#include "ur_dashboard_msgs/srv/set_io_batch.hpp"
 #include "ur_msgs/srv/set_io.hpp"
 #include "ur_msgs/srv/set_speed_slider_fraction.hpp"
 #include "ur_msgs/srv/set_payload.hpp"
@@ -79,6 +85,8 @@ enum CommandInterfaces
   ZERO_FTSENSOR_ASYNC_SUCCESS = 32,
   HAND_BACK_CONTROL_CMD = 33,
   HAND_BACK_CONTROL_ASYNC_SUCCESS = 34,
+  IO_BATCH_SEQUENCE_CMD = 35,
+  IO_BATCH_ACKNOWLEDGED = 36,
 };
 
 enum StateInterfaces
@@ -102,6 +110,33 @@ enum StateInterfaces
   PROGRAM_RUNNING = 70,
 };
 
+/*!
+ * \brief Decides when one of the GPIOController's topics is due for publishing.
+ *
+ * Changed messages are published right away, but at most with the configured maximum rate. Unchanged messages are
+ * published again with the heartbeat rate. A rate of 0 removes the respective limit or disables the heartbeat.
+ */
+class PublishSchedule
+{
+public:
+  void configure(double max_rate, double heartbeat_rate);
+
+  /*!
+   * \brief Makes the next call to isDue() return true regardless of the message having changed.
+   */
+  void reset();
+
+  bool isDue(int64_t now_ns, bool changed) const;
+
+  void published(int64_t now_ns);
+
+private:
+  int64_t min_period_ns_ = 0;
+  int64_t heartbeat_period_ns_ = 0;
+  int64_t last_publish_ns_ = 0;
+  bool force_publish_ = true;
+};
+
 class GPIOController : public controller_interface::ControllerInterface
 {
 public:
@@ -122,6 +157,9 @@ public:
 private:
   bool setIO(ur_msgs::srv::SetIO::Request::SharedPtr req, ur_msgs::srv::SetIO::Response::SharedPtr resp);
 
+  bool setIOBatch(ur_dashboard_msgs::srv::SetIOBatch::Request::SharedPtr req,
+                  ur_dashboard_msgs::srv::SetIOBatch::Response::SharedPtr resp);
+
   bool setSpeedSlider(ur_msgs::srv::SetSpeedSliderFraction::Request::SharedPtr req,
                       ur_msgs::srv::SetSpeedSliderFraction::Response::SharedPtr resp);
 
@@ -136,15 +174,15 @@ private:
 
   bool zeroFTSensor(std_srvs::srv::Trigger::Request::SharedPtr req, std_srvs::srv::Trigger::Response::SharedPtr resp);
 
-  void publishIO();
+  void publishIO(const rclcpp::Time& time);
 
-  void publishToolData();
+  void publishToolData(const rclcpp::Time& time);
 
-  void publishRobotMode();
+  void publishRobotMode(const rclcpp::Time& time);
 
-  void publishSafetyMode();
+  void publishSafetyMode(const rclcpp::Time& time);
 
-  void publishProgramRunning();
+  void publishProgramRunning(const rclcpp::Time& time);
 
 protected:
   void initMsgs();
@@ -156,20 +194,36 @@ protected:
   std::array<double, 18> standard_analog_output_cmd_;
   double target_speed_fraction_cmd_;
 
+  // IO commands of a batch service call, indexed like the command interfaces and NaN for unused entries. They are
+  // handed to update() through io_batch_pending_, which writes them to the command interfaces along with
+  // io_batch_sequence_. The hardware takes all IO command interfaces over at once and reports the sequence number
+  // as acknowledged after sending them.
+  std::array<double, CommandInterfaces::IO_ASYNC_SUCCESS> io_batch_cmd_;
+  double io_batch_sequence_ = 0.0;
+  std::atomic<bool> io_batch_pending_{ false };
+
   // services
   rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr resend_robot_program_srv_;
   rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr hand_back_control_srv_;
   rclcpp::Service<ur_msgs::srv::SetSpeedSliderFraction>::SharedPtr set_speed_slider_srv_;
   rclcpp::Service<ur_msgs::srv::SetIO>::SharedPtr set_io_srv_;
+  rclcpp::Service<ur_dashboard_msgs::srv::SetIOBatch>::SharedPtr set_io_batch_srv_;
   rclcpp::Service<ur_msgs::srv::SetPayload>::SharedPtr set_payload_srv_;
   rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr tare_sensor_srv_;
 
-  std::shared_ptr<rclcpp::Publisher<ur_msgs::msg::IOStates>> io_pub_;
-  std::shared_ptr<rclcpp::Publisher<ur_msgs::msg::ToolDataMsg>> tool_data_pub_;
-  std::shared_ptr<rclcpp::Publisher<ur_dashboard_msgs::msg::RobotMode>> robot_mode_pub_;
-  std::shared_ptr<rclcpp::Publisher<ur_dashboard_msgs::msg::SafetyMode>> safety_mode_pub_;
-  std::shared_ptr<rclcpp::Publisher<std_msgs::msg::Bool>> program_state_pub_;
+  std::unique_ptr<realtime_tools::RealtimePublisher<ur_msgs::msg::IOStates>> io_pub_;
+  std::unique_ptr<realtime_tools::RealtimePublisher<ur_msgs::msg::ToolDataMsg>> tool_data_pub_;
+  std::unique_ptr<realtime_tools::RealtimePublisher<ur_dashboard_msgs::msg::RobotMode>> robot_mode_pub_;
+  std::unique_ptr<realtime_tools::RealtimePublisher<ur_dashboard_msgs::msg::SafetyMode>> safety_mode_pub_;
+  std::unique_ptr<realtime_tools::RealtimePublisher<std_msgs::msg::Bool>> program_state_pub_;
+
+  PublishSchedule io_schedule_;
+  PublishSchedule tool_data_schedule_;
+  PublishSchedule robot_mode_schedule_;
+  PublishSchedule safety_mode_schedule_;
+  PublishSchedule program_state_schedule_;
 
+  // Current state, only handed to the realtime publishers when they are due
   ur_msgs::msg::IOStates io_msg_;
   ur_msgs::msg::ToolDataMsg tool_data_msg_;
   ur_dashboard_msgs::msg::RobotMode robot_mode_msg_;
@@ -181,6 +235,12 @@ protected:
   gpio_controller::Params params_;
 
   static constexpr double ASYNC_WAITING = 2.0;
+
+  // update() wakes up service callbacks waiting for an async command as long as there are any
+  std::mutex async_command_mutex_;
+  std::condition_variable async_command_cv_;
+  std::atomic<int> async_command_waiters_{ 0 };
+
   // TODO(anyone) publishers to add: tcp_pose_pub_
   // TODO(anyone) subscribers to add: script_command_sub_
   // TODO(anyone) service servers to add: resend_robot_program_srv_, deactivate_srv_, set_payload_srv_, tare_sensor_srv_
@@ -188,8 +248,17 @@ protected:
   /**
    * @brief wait until a command interface isn't in state ASYNC_WAITING anymore or until the parameter maximum_retries
    * have been reached
+   *
+   * The hardware's async thread sends the command right after the control cycle that wrote it and acknowledges it
+   * once the robot accepted it. The waiting thread gets woken up by every update() until then, so it notices the
+   * acknowledgement within a control cycle. The retries only serve as timeout.
    */
   bool waitForAsyncCommand(std::function<double(void)> get_value);
+
+  /**
+   * @brief wait until acknowledged returns true or until the parameter maximum_retries have been reached
+   */
+  bool waitForAcknowledgement(std::function<bool(void)> acknowledged);
 };
 }  // namespace ur_controllers
 
@@ -37,6 +37,10 @@
 #ifndef UR_CONTROLLERS__SCALED_JOINT_TRAJECTORY_CONTROLLER_HPP_
 #define UR_CONTROLLERS__SCALED_JOINT_TRAJECTORY_CONTROLLER_HPP_
 
+#include <array>
+#include <cstdint>
+#include <memory>
+
 #include "angles/angles.h"
 #include "joint_trajectory_controller/joint_trajectory_controller.hpp"
 #include "joint_trajectory_controller/trajectory.hpp"
@@ -44,19 +48,46 @@
 #include "rclcpp/time.hpp"
 #include "rclcpp/duration.hpp"
 #include "scaled_joint_trajectory_controller_parameters.hpp"
+#include "ur_controllers/finished_goal_handoff.hpp"
+#include "ur_controllers/speed_scaling_filter.hpp"
+#include "ur_controllers/tolerance_evaluator.hpp"
+#include "ur_controllers/trajectory_queue.hpp"
+#include "ur_controllers/trajectory_sampler.hpp"
 
 namespace ur_controllers
 {
+/*!
+ * \brief Handshake states of the hardware's trajectory forwarding interface.
+ *
+ * These have to match the states used by the hardware interface in ur_robot_driver.
+ */
+enum TrajectoryTransferState
+{
+  TRANSFER_IDLE = 0,
+  TRANSFER_START = 1,
+  TRANSFER_READY = 2,
+  TRANSFER_POINT = 3,
+  TRANSFER_DONE = 4,
+  TRANSFER_FAILED = 5,
+  TRANSFER_CANCEL = 6
+};
+
 class ScaledJointTrajectoryController : public joint_trajectory_controller::JointTrajectoryController
 {
 public:
   ScaledJointTrajectoryController() = default;
   ~ScaledJointTrajectoryController() override = default;
 
+  controller_interface::CallbackReturn on_configure(const rclcpp_lifecycle::State& previous_state) override;
+
+  controller_interface::InterfaceConfiguration command_interface_configuration() const override;
+
   controller_interface::InterfaceConfiguration state_interface_configuration() const override;
 
   controller_interface::CallbackReturn on_activate(const rclcpp_lifecycle::State& state) override;
 
+  controller_interface::CallbackReturn on_deactivate(const rclcpp_lifecycle::State& state) override;
+
   controller_interface::return_type update(const rclcpp::Time& time, const rclcpp::Duration& period) override;
 
   CallbackReturn on_init() override;
@@ -73,9 +104,127 @@ protected:
   };
 
 private:
+  static constexpr size_t MAX_QUEUED_GOALS = 16;
+  static constexpr size_t FINISHED_GOAL_QUEUE_SIZE = 16;
+
+  using QueuedGoal = TrajectoryQueue<RealtimeGoalHandlePtr, MAX_QUEUED_GOALS>::QueuedGoal;
+
+  /*!
+   * \brief Upper limit of the speed scaling factor, so the trajectory within the look ahead time doesn't exceed the
+   * configured joint acceleration.
+   *
+   * \returns 1.0 if looking ahead is disabled
+   */
+  double look_ahead_scaling_limit() const;
+
+  /*!
+   * \brief Returns a preallocated feedback message if feedback is due according to the feedback rate.
+   *
+   * The message is stamped with the given time, the joint states have to be filled in. Returns nullptr if no
+   * feedback should be sent in this cycle.
+   *
+   * \param time Current time of the control loop
+   */
+  std::shared_ptr<FollowJTrajAction::Feedback> get_feedback_msg(const rclcpp::Time& time);
+
+  /*!
+   * \brief Marks the active goal as finished without locking, may be called from the real-time loop.
+   *
+   * The result has to be set on the goal handle before.
+   *
+   * \param active_goal Goal to finish, may be empty if only \p next_goal should be activated
+   * \param next_goal Goal taken from the trajectory queue to continue with
+   */
+  void finish_active_goal(const RealtimeGoalHandlePtr& active_goal,
+                          const RealtimeGoalHandlePtr& next_goal = RealtimeGoalHandlePtr());
+
+  /*!
+   * \brief Removes the goals marked by finish_active_goal() from the goal buffers, runs outside of the real-time
+   * loop.
+   */
+  void release_finished_goals();
+
+  /*!
+   * \brief Number of goals that may be queued behind the active goal, 0 if the trajectory queue is disabled.
+   */
+  size_t trajectory_queue_depth() const;
+
+  /*!
+   * \brief Checks whether the goal in the goal buffers is still executed, runs outside of the real-time loop.
+   */
+  bool active_goal_in_progress() const;
+
+  rclcpp_action::GoalResponse queueing_goal_received_callback(const rclcpp_action::GoalUUID& uuid,
+                                                              std::shared_ptr<const FollowJTrajAction::Goal> goal);
+
+  rclcpp_action::CancelResponse queueing_goal_cancelled_callback(
+      const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle);
+
+  void queueing_goal_accepted_callback(std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle);
+
+  /*!
+   * \brief Tracks the goal taken from the trajectory queue until it is in the goal buffer, handles replaced and
+   * canceled queued goals and starts the next queued goal when idle.
+   *
+   * \param active_goal Active goal of this cycle, gets set to the queued goal being executed
+   * \param has_pending_goal Whether a goal is pending in this cycle
+   */
+  void update_queued_goals(RealtimeGoalHandlePtr& active_goal, bool has_pending_goal);
+
+  /*!
+   * \brief Takes the next goal from the trajectory queue that was not canceled and starts its trajectory.
+   *
+   * \returns The started goal, empty if the queue is empty
+   */
+  RealtimeGoalHandlePtr start_next_queued_goal();
+
+  /*!
+   * \brief Aborts all goals in the trajectory queue and the one taken from it but not yet in the goal buffer.
+   *
+   * \param reason Error string of the abort results
+   * \param handed_over Whether to abort the goal taken from the queue as well
+   */
+  void abort_queued_goals(const std::string& reason, bool handed_over = true);
+
+  /*!
+   * \brief Hands the active trajectory point by point to the hardware's trajectory forwarding interface and
+   * finishes the goal once the robot reports the trajectory as done.
+   *
+   * \param time Current time of the control loop
+   * \param active_goal Goal the active trajectory belongs to, may be empty for trajectories sent via topic
+   */
+  void forward_trajectory(const rclcpp::Time& time, const RealtimeGoalHandlePtr& active_goal);
+
   double scaling_factor_{};
+
+  // trajectory forwarding
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> forwarded_trajectory_msg_;
+  size_t next_forwarded_point_{};
+
   realtime_tools::RealtimeBuffer<TimeData> time_data_;
 
+  // Keeps track of the current segment of the active trajectory
+  TrajectorySampler trajectory_sampler_;
+
+  // Computes the tracking error and checks the tolerances of all joints
+  ToleranceEvaluator tolerance_evaluator_;
+
+  // Smoothes the speed scaling the trajectory time advances with, if configured
+  SpeedScalingFilter speed_scaling_filter_;
+
+  // Reused feedback messages, one may be held by the goal handle while the other one is filled
+  std::array<std::shared_ptr<FollowJTrajAction::Feedback>, 2> feedback_msgs_;
+  int64_t last_feedback_ns_{ 0 };
+
+  // Goals finished in the real-time loop, handed over to release_finished_goals()
+  FinishedGoalHandoff<RealtimeGoalHandlePtr, FINISHED_GOAL_QUEUE_SIZE> finished_goals_;
+  rclcpp::TimerBase::SharedPtr finished_goal_timer_;
+
+  // Trajectory queue, goals appended outside of the real-time loop are started by update()
+  TrajectoryQueue<RealtimeGoalHandlePtr, MAX_QUEUED_GOALS> trajectory_queue_;
+  // Last goal started from the queue, its tolerances apply while it is the active goal
+  QueuedGoal running_queued_goal_;
+
   std::shared_ptr<scaled_joint_trajectory_controller::ParamListener> scaled_param_listener_;
   scaled_joint_trajectory_controller::Params scaled_params_;
 };
@@ -0,0 +1,88 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_CONTROLLERS__SPEED_SCALING_FILTER_HPP_
+#define UR_CONTROLLERS__SPEED_SCALING_FILTER_HPP_
+
+namespace ur_controllers
+{
+/*!
+ * \brief Smoothes the speed scaling factor the trajectory time is advanced with.
+ *
+ * Rising speed scaling, e.g. when the robot's ramp up after a pause ends, and changes of the upper limit are
+ * followed with a limited rate and a limited rate of change. Speed scaling reported lower than the filtered value
+ * is followed immediately, so the trajectory is never advanced faster than the robot executes it.
+ */
+class SpeedScalingFilter
+{
+public:
+  SpeedScalingFilter() = default;
+
+  /*!
+   * \brief Sets the limits of the filter.
+   *
+   * \param max_rate Maximum change of the scaling factor per second
+   * \param max_acceleration Maximum change of the rate per second, 0 limits the rate only
+   */
+  void configure(double max_rate, double max_acceleration);
+
+  /*!
+   * \brief Sets the filtered value without smoothing, e.g. while no trajectory is executed.
+   *
+   * \param scaling_factor Value the filter continues from
+   */
+  void reset(double scaling_factor);
+
+  /*!
+   * \brief Advances the filter by one control cycle.
+   *
+   * \param measured_scaling_factor Speed scaling reported by the robot
+   * \param limit Upper limit for the scaling factor, e.g. from looking ahead in the trajectory
+   * \param dt Time since the last update in seconds
+   *
+   * \returns Filtered scaling factor
+   */
+  double update(double measured_scaling_factor, double limit, double dt);
+
+private:
+  double max_rate_{ 0.0 };
+  double max_acceleration_{ 0.0 };
+  double value_{ 1.0 };
+  double rate_{ 0.0 };
+};
+}  // namespace ur_controllers
+
+#endif  // UR_CONTROLLERS__SPEED_SCALING_FILTER_HPP_
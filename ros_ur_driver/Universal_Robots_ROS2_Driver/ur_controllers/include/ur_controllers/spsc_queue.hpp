@@ -0,0 +1,103 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_CONTROLLERS__SPSC_QUEUE_HPP_
+#define UR_CONTROLLERS__SPSC_QUEUE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace ur_controllers
+{
+/*!
+ * \brief Bounded lock-free queue for handing data from exactly one producer thread to exactly one consumer thread.
+ *
+ * Neither push() nor pop() allocate memory or block, so either side may be a real-time thread.
+ *
+ * \tparam T Type of the queued elements, popped elements are reset to a default constructed T
+ * \tparam Capacity Maximum number of elements in the queue
+ */
+template <typename T, size_t Capacity>
+class SPSCQueue
+{
+public:
+  /*!
+   * \brief Appends an element to the queue, may only be called from the producer thread.
+   *
+   * \param value Element to append
+   *
+   * \returns False if the queue is full
+   */
+  bool push(const T& value)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    buffer_[head % Capacity] = value;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /*!
+   * \brief Takes the oldest element from the queue, may only be called from the consumer thread.
+   *
+   * \param value Receives the element
+   *
+   * \returns False if the queue is empty
+   */
+  bool pop(T& value)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = std::move(buffer_[tail % Capacity]);
+    buffer_[tail % Capacity] = T();
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  std::array<T, Capacity> buffer_;
+  std::atomic<size_t> head_{ 0 };
+  std::atomic<size_t> tail_{ 0 };
+};
+}  // namespace ur_controllers
+
+#endif  // UR_CONTROLLERS__SPSC_QUEUE_HPP_
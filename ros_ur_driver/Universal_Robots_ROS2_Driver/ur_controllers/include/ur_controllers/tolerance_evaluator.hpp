@@ -0,0 +1,108 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_CONTROLLERS__TOLERANCE_EVALUATOR_HPP_
+#define UR_CONTROLLERS__TOLERANCE_EVALUATOR_HPP_
+
+#include <vector>
+
+#include "joint_trajectory_controller/tolerances.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+
+namespace ur_controllers
+{
+/*!
+ * \brief Result of evaluating the tolerances of all joints.
+ */
+struct ToleranceCheck
+{
+  bool state_violated{ false };
+  bool goal_violated{ false };
+};
+
+/*!
+ * \brief Computes the tracking error of all joints and checks it against the state and goal tolerances in one
+ * pass over the joints.
+ *
+ * Gives the same results as calling joint_trajectory_controller::check_state_tolerance_per_joint() for each joint.
+ * The errors are computed in separate loops over the position, velocity and acceleration arrays, the tolerances are
+ * only checked up to the first violation.
+ */
+class ToleranceEvaluator
+{
+public:
+  ToleranceEvaluator() = default;
+
+  /*!
+   * \brief Sets up the evaluator for the controller's joints.
+   *
+   * \param angle_wraparound Whether the error of each joint has to be computed as shortest angular distance
+   * \param compare_velocities Whether the velocity error should be computed
+   * \param compare_accelerations Whether the acceleration error should be computed
+   */
+  void configure(const std::vector<bool>& angle_wraparound, bool compare_velocities, bool compare_accelerations);
+
+  /*!
+   * \brief Computes the error between current and desired state and checks the tolerances.
+   *
+   * Errors that are not compared keep their previous value in \p error, same as in the joint_trajectory_controller.
+   *
+   * \param current Current state of the joints
+   * \param desired Desired state of the joints
+   * \param tolerances Tolerances of the active segment
+   * \param check_state Whether the state tolerances should be checked
+   * \param check_goal Whether the goal state tolerances should be checked
+   * \param error Receives the error of all joints, has to be sized for all joints
+   *
+   * \returns Which of the checked tolerances are violated by any joint
+   */
+  ToleranceCheck evaluate(const trajectory_msgs::msg::JointTrajectoryPoint& current,
+                          const trajectory_msgs::msg::JointTrajectoryPoint& desired,
+                          const joint_trajectory_controller::SegmentTolerances& tolerances, bool check_state,
+                          bool check_goal, trajectory_msgs::msg::JointTrajectoryPoint& error) const;
+
+private:
+  bool violates(const trajectory_msgs::msg::JointTrajectoryPoint& error,
+                const std::vector<joint_trajectory_controller::StateTolerances>& tolerances) const;
+
+  size_t dof_{ 0 };
+  std::vector<size_t> wraparound_joints_;
+  bool compare_velocities_{ false };
+  bool compare_accelerations_{ false };
+};
+}  // namespace ur_controllers
+
+#endif  // UR_CONTROLLERS__TOLERANCE_EVALUATOR_HPP_
@@ -0,0 +1,308 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_CONTROLLERS__TRAJECTORY_QUEUE_HPP_
+#define UR_CONTROLLERS__TRAJECTORY_QUEUE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "joint_trajectory_controller/tolerances.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "ur_controllers/spsc_queue.hpp"
+
+namespace ur_controllers
+{
+/*!
+ * \brief Queue of goals whose trajectories are executed one after another, filled by the action server callbacks and
+ * emptied by the real-time loop.
+ *
+ * A goal is appended if the first point of its trajectory matches the last point of the previously accepted goal.
+ * Each goal's trajectory is executed on its own, so there is no blending between queued goals.
+ *
+ * \tparam GoalPtr Shared pointer to a realtime_tools::RealtimeServerGoalHandle
+ * \tparam Capacity Maximum number of queued goals
+ */
+template <typename GoalPtr, size_t Capacity>
+class TrajectoryQueue
+{
+public:
+  struct QueuedGoal
+  {
+    GoalPtr goal;
+    std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory;
+    // Tolerances of the goal, as the active tolerances are only set for goals that aren't queued
+    std::shared_ptr<joint_trajectory_controller::SegmentTolerances> tolerances;
+    std::shared_ptr<std::atomic<bool>> canceled;
+  };
+
+  /*!
+   * \brief Checks whether a goal with the given trajectory would be appended but can't be, as the queue is full.
+   *
+   * \param trajectory Trajectory of the new goal
+   * \param active_goal_in_progress Whether the goal in the goal buffer is still executed
+   * \param append_tolerance Maximum position difference of each joint for the trajectory to be appended
+   * \param depth Maximum number of queued goals, 0 disables the queue
+   */
+  bool is_full_for(const trajectory_msgs::msg::JointTrajectory& trajectory, bool active_goal_in_progress,
+                   double append_tolerance, size_t depth)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return depth > 0 && appends(trajectory, active_goal_in_progress, append_tolerance) && queued_goal_count_ >= depth;
+  }
+
+  /*!
+   * \brief Appends an accepted goal if its trajectory continues the last accepted one, otherwise the goal replaces
+   * all queued goals.
+   *
+   * The goal is set to executing if it is appended. A replaced queue is aborted by the next call to
+   * take_flush_request() from the real-time loop.
+   *
+   * \param queued Accepted goal
+   * \param active_goal_in_progress Whether the goal in the goal buffer is still executed
+   * \param append_tolerance Maximum position difference of each joint for the trajectory to be appended
+   * \param depth Maximum number of queued goals, 0 disables the queue
+   *
+   * \returns True if the goal was appended, otherwise it has to be started like any other goal
+   */
+  bool accept(const QueuedGoal& queued, bool active_goal_in_progress, double append_tolerance, size_t depth)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (appends(*queued.trajectory, active_goal_in_progress, append_tolerance) && queued_goal_count_ < depth) {
+      queued.goal->execute();
+      if (queued_goals_.push(queued)) {
+        ++queued_goal_count_;
+        queued_goal_handles_.push_back(queued);
+        last_accepted_trajectory_ = queued.trajectory;
+        return true;
+      }
+    }
+
+    // The new goal replaces the active one, so nothing queued behind it may be executed anymore
+    for (const auto& handle : queued_goal_handles_) {
+      if (handle.goal->gh_->is_active()) {
+        flush_requested_.store(true);
+        break;
+      }
+    }
+    last_accepted_trajectory_ = queued.trajectory;
+    return false;
+  }
+
+  /*!
+   * \brief Marks a queued goal as canceled, the real-time loop cancels it once it gets to it.
+   *
+   * \param goal_handle Action server goal handle of the goal to cancel
+   */
+  template <typename ServerGoalHandlePtr>
+  void cancel(const ServerGoalHandlePtr& goal_handle)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& handle : queued_goal_handles_) {
+      if (handle.goal->gh_ == goal_handle) {
+        handle.canceled->store(true);
+      }
+    }
+  }
+
+  /*!
+   * \brief Requests aborting all queued goals, as the goal they continue was canceled while being executed.
+   *
+   * The real-time loop aborts them on the next call to take_cancel_flush_request(), which happens before it would start
+   * the next queued goal. Thereby none of them starts from wherever the canceled goal stopped.
+   */
+  void cancel_queued_behind_active()
+  {
+    cancel_flush_requested_.store(true);
+  }
+
+  /*!
+   * \brief Publishes the results of queued goals and forgets the finished ones, runs outside of the real-time loop.
+   */
+  void run_non_realtime()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto& handle : queued_goal_handles_) {
+      handle.goal->runNonRealtime();
+    }
+    queued_goal_handles_.erase(std::remove_if(queued_goal_handles_.begin(), queued_goal_handles_.end(),
+                                              [](const QueuedGoal& handle) { return !handle.goal->gh_->is_active(); }),
+                               queued_goal_handles_.end());
+  }
+
+  size_t size() const
+  {
+    return queued_goal_count_.load();
+  }
+
+  /*!
+   * \brief Returns whether the queue was replaced by a new goal since the last call, real-time safe.
+   */
+  bool take_flush_request()
+  {
+    return flush_requested_.exchange(false);
+  }
+
+  /*!
+   * \brief Returns whether the goal the queue continues was canceled since the last call, real-time safe.
+   */
+  bool take_cancel_flush_request()
+  {
+    return cancel_flush_requested_.exchange(false);
+  }
+
+  /*!
+   * \brief Takes the next goal that was not canceled from the queue, real-time safe.
+   *
+   * The goal stays handed over until it arrived in the goal buffer, see handed_over().
+   *
+   * \param cancel_goal Called with each canceled goal taken from the queue, has to set its result
+   * \param next Receives the next goal
+   *
+   * \returns False if the queue is empty
+   */
+  template <typename CancelFunction>
+  bool start_next(CancelFunction&& cancel_goal, QueuedGoal& next)
+  {
+    QueuedGoal queued;
+    while (queued_goals_.pop(queued)) {
+      --queued_goal_count_;
+      if (queued.canceled->load()) {
+        cancel_goal(queued.goal);
+        continue;
+      }
+      handed_over_goal_ = queued;
+      next = queued;
+      return true;
+    }
+    return false;
+  }
+
+  /*!
+   * \brief Goal taken from the queue that didn't arrive in the goal buffer yet, empty if there is none.
+   */
+  const QueuedGoal& handed_over() const
+  {
+    return handed_over_goal_;
+  }
+
+  void clear_handed_over()
+  {
+    handed_over_goal_ = QueuedGoal();
+  }
+
+  /*!
+   * \brief Aborts the handed over goal and all queued goals, in the order they would have been executed.
+   *
+   * \param abort_goal Called with each goal to abort, has to set its result
+   */
+  template <typename AbortFunction>
+  void abort_all(AbortFunction&& abort_goal)
+  {
+    if (handed_over_goal_.goal) {
+      abort_goal(handed_over_goal_.goal);
+      handed_over_goal_ = QueuedGoal();
+    }
+    abort_queued(abort_goal);
+  }
+
+  /*!
+   * \brief Aborts all queued goals in the order they would have been executed, but not the handed over goal.
+   *
+   * \param abort_goal Called with each goal to abort, has to set its result
+   */
+  template <typename AbortFunction>
+  void abort_queued(AbortFunction&& abort_goal)
+  {
+    QueuedGoal queued;
+    while (queued_goals_.pop(queued)) {
+      --queued_goal_count_;
+      abort_goal(queued.goal);
+    }
+  }
+
+private:
+  bool appends(const trajectory_msgs::msg::JointTrajectory& trajectory, bool active_goal_in_progress,
+               double append_tolerance) const
+  {
+    if (!last_accepted_trajectory_ || last_accepted_trajectory_->points.empty() || trajectory.points.empty() ||
+        trajectory.joint_names != last_accepted_trajectory_->joint_names || flush_requested_.load() ||
+        cancel_flush_requested_.load()) {
+      return false;
+    }
+
+    // Only append while the trajectory it continues is still executed
+    bool goal_in_progress = active_goal_in_progress;
+    for (const auto& handle : queued_goal_handles_) {
+      goal_in_progress = goal_in_progress || handle.goal->gh_->is_active();
+    }
+    if (!goal_in_progress) {
+      return false;
+    }
+
+    const auto& first_point = trajectory.points.front();
+    const auto& last_point = last_accepted_trajectory_->points.back();
+    if (first_point.positions.size() != last_point.positions.size()) {
+      return false;
+    }
+    for (size_t index = 0; index < first_point.positions.size(); ++index) {
+      if (std::abs(first_point.positions[index] - last_point.positions[index]) > append_tolerance) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  SPSCQueue<QueuedGoal, Capacity> queued_goals_;
+  std::atomic<size_t> queued_goal_count_{ 0 };
+  std::atomic<bool> flush_requested_{ false };
+  std::atomic<bool> cancel_flush_requested_{ false };
+
+  // Only used by the real-time loop
+  QueuedGoal handed_over_goal_;
+
+  // Only used by the action server callbacks
+  std::mutex mutex_;
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> last_accepted_trajectory_;
+  std::vector<QueuedGoal> queued_goal_handles_;
+};
+}  // namespace ur_controllers
+
+#endif  // UR_CONTROLLERS__TRAJECTORY_QUEUE_HPP_
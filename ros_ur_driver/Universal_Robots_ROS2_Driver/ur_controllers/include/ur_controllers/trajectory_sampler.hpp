@@ -0,0 +1,145 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_CONTROLLERS__TRAJECTORY_SAMPLER_HPP_
+#define UR_CONTROLLERS__TRAJECTORY_SAMPLER_HPP_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "joint_trajectory_controller/interpolation_methods.hpp"
+#include "joint_trajectory_controller/trajectory.hpp"
+#include "rclcpp/time.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+
+namespace ur_controllers
+{
+/*!
+ * \brief Samples a joint_trajectory_controller::Trajectory from a cursor on the current segment.
+ *
+ * Trajectory::sample() searches the segment containing the sample time from the first point on and computes the
+ * spline coefficients of that segment in every call, so its cost grows with the trajectory length. As the
+ * (scaled) trajectory time only moves forward, this sampler remembers the current segment, advances it
+ * monotonically and computes the coefficients only once when entering a segment. The samples are the same as
+ * the ones of Trajectory::sample().
+ *
+ * Sampling doesn't allocate memory once reserve() has been called with the number of joints.
+ */
+class TrajectorySampler
+{
+public:
+  TrajectorySampler() = default;
+
+  /*!
+   * \brief Allocates the coefficient storage for the given number of joints.
+   *
+   * \param dof Number of joints of the sampled trajectories
+   */
+  void reserve(size_t dof);
+
+  /*!
+   * \brief Forgets the current segment, the next sample searches the segment from the start again.
+   */
+  void reset();
+
+  /*!
+   * \brief Samples the trajectory at the given time, same interface as Trajectory::sample().
+   *
+   * Sampling before the first point of the trajectory message is delegated to the trajectory itself, as this
+   * doesn't involve a segment search.
+   *
+   * \param trajectory Trajectory to sample, a new trajectory message is detected automatically
+   * \param sample_time Time at which to sample the trajectory
+   * \param interpolation_method Interpolation method used between the points
+   * \param output_state Sampled state
+   * \param start_segment_itr Iterator to the point the sampled segment starts at
+   * \param end_segment_itr Iterator to the point the sampled segment ends at, end() once the trajectory is finished
+   *
+   * \returns Whether the sample is valid, false e.g. for a segment between points with accelerations, but without
+   * velocities
+   */
+  bool sample(joint_trajectory_controller::Trajectory& trajectory, const rclcpp::Time& sample_time,
+              const joint_trajectory_controller::interpolation_methods::InterpolationMethod interpolation_method,
+              trajectory_msgs::msg::JointTrajectoryPoint& output_state,
+              joint_trajectory_controller::TrajectoryPointConstIter& start_segment_itr,
+              joint_trajectory_controller::TrajectoryPointConstIter& end_segment_itr);
+
+  /*!
+   * \brief Largest joint acceleration of the trajectory points from the current segment on within the given time.
+   *
+   * Uses the points' accelerations if given, otherwise the velocity differences between the points.
+   *
+   * \param look_ahead_time Trajectory time to look ahead in seconds
+   *
+   * \returns Largest absolute joint acceleration in trajectory time, 0 if not known
+   */
+  double max_acceleration_ahead(double look_ahead_time) const;
+
+private:
+  enum class SegmentType
+  {
+    UNDEFINED,
+    LINEAR,
+    CUBIC,
+    QUINTIC
+  };
+
+  /*!
+   * \brief Computes the polynomial coefficients of the segment between the given points.
+   */
+  void compute_coefficients(const trajectory_msgs::msg::JointTrajectoryPoint& start_point,
+                            const trajectory_msgs::msg::JointTrajectoryPoint& end_point, double duration);
+
+  /*!
+   * \brief Evaluates the polynomials of the current segment at the given time since the segment's start.
+   */
+  void evaluate(double t, trajectory_msgs::msg::JointTrajectoryPoint& output_state) const;
+
+  static constexpr size_t NO_SEGMENT = static_cast<size_t>(-1);
+
+  std::shared_ptr<trajectory_msgs::msg::JointTrajectory> trajectory_msg_;
+  size_t current_segment_{ NO_SEGMENT };
+  size_t coefficients_segment_{ NO_SEGMENT };
+  SegmentType segment_type_{ SegmentType::UNDEFINED };
+
+  // Coefficients of the segment's quintic polynomial per joint, lower orders leave the higher coefficients at zero
+  std::vector<std::array<double, 6>> coefficients_;
+};
+}  // namespace ur_controllers
+
+#endif  // UR_CONTROLLERS__TRAJECTORY_SAMPLER_HPP_
@@ -37,10 +37,73 @@
 
 #include "ur_controllers/gpio_controller.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace ur_controllers
 {
+namespace
+{
+/*!
+ * \brief Hands \p msg to \p publisher if it differs from the last published message or the heartbeat is due.
+ *
+ * If the publisher's thread is still busy with the previous message, this is retried in the next cycle.
+ */
+template <typename MessageT>
+void publishIfDue(realtime_tools::RealtimePublisher<MessageT>& publisher, const MessageT& msg,
+                  PublishSchedule& schedule, const rclcpp::Time& time)
+{
+  if (!publisher.trylock()) {
+    return;
+  }
+  const int64_t now_ns = time.nanoseconds();
+  if (schedule.isDue(now_ns, publisher.msg_ != msg)) {
+    publisher.msg_ = msg;
+    publisher.unlockAndPublish();
+    schedule.published(now_ns);
+  } else {
+    publisher.unlock();
+  }
+}
+
+int64_t periodFromRate(double rate)
+{
+  return rate > 0.0 ? static_cast<int64_t>(1e9 / rate) : 0;
+}
+}  // namespace
+
+void PublishSchedule::configure(double max_rate, double heartbeat_rate)
+{
+  min_period_ns_ = periodFromRate(max_rate);
+  heartbeat_period_ns_ = periodFromRate(heartbeat_rate);
+}
+
+void PublishSchedule::reset()
+{
+  force_publish_ = true;
+}
+
+bool PublishSchedule::isDue(int64_t now_ns, bool changed) const
+{
+  if (force_publish_) {
+    return true;
+  }
+  const int64_t elapsed_ns = now_ns - last_publish_ns_;
+  if (changed) {
+    return elapsed_ns >= min_period_ns_;
+  }
+  return heartbeat_period_ns_ > 0 && elapsed_ns >= heartbeat_period_ns_;
+}
+
+void PublishSchedule::published(int64_t now_ns)
+{
+  last_publish_ns_ = now_ns;
+  force_publish_ = false;
+}
+
 controller_interface::CallbackReturn GPIOController::on_init()
 {
   try {
@@ -97,6 +160,10 @@ controller_interface::InterfaceConfiguration GPIOController::command_interface_c
   config.names.emplace_back(tf_prefix + "hand_back_control/hand_back_control_cmd");
   config.names.emplace_back(tf_prefix + "hand_back_control/hand_back_control_async_success");
 
+  // IO batches
+  config.names.emplace_back(tf_prefix + "gpio/io_batch_sequence");
+  config.names.emplace_back(tf_prefix + "gpio/io_batch_acknowledged");
+
   return config;
 }
 
@@ -161,14 +228,31 @@ controller_interface::InterfaceConfiguration ur_controllers::GPIOController::sta
   return config;
 }
 
-controller_interface::return_type ur_controllers::GPIOController::update(const rclcpp::Time& /*time*/,
+controller_interface::return_type ur_controllers::GPIOController::update(const rclcpp::Time& time,
                                                                          const rclcpp::Duration& /*period*/)
 {
-  publishIO();
-  publishToolData();
-  publishRobotMode();
-  publishSafetyMode();
-  publishProgramRunning();
+  // The hardware's async thread acknowledges async commands after sending them. That happens outside of the control
+  // loop, so waiting service callbacks get to check the command interfaces once per cycle. Notifying every cycle
+  // while someone waits keeps this free of locks.
+  if (async_command_waiters_.load(std::memory_order_acquire) > 0) {
+    async_command_cv_.notify_all();
+  }
+
+  if (io_batch_pending_.load(std::memory_order_acquire)) {
+    for (size_t i = 0; i < io_batch_cmd_.size(); ++i) {
+      if (!std::isnan(io_batch_cmd_[i])) {
+        command_interfaces_[i].set_value(io_batch_cmd_[i]);
+      }
+    }
+    command_interfaces_[CommandInterfaces::IO_BATCH_SEQUENCE_CMD].set_value(io_batch_sequence_);
+    io_batch_pending_.store(false, std::memory_order_release);
+  }
+
+  publishIO(time);
+  publishToolData(time);
+  publishRobotMode(time);
+  publishSafetyMode(time);
+  publishProgramRunning(time);
   return controller_interface::return_type::OK;
 }
 
@@ -191,7 +275,7 @@ ur_controllers::GPIOController::on_configure(const rclcpp_lifecycle::State& /*pr
   return LifecycleNodeInterface::CallbackReturn::SUCCESS;
 }
 
-void GPIOController::publishIO()
+void GPIOController::publishIO(const rclcpp::Time& time)
 {
   for (size_t i = 0; i < 18; ++i) {
     io_msg_.digital_out_states[i].pin = i;
@@ -218,10 +302,10 @@ void GPIOController::publishIO()
         static_cast<uint8_t>(state_interfaces_[i + StateInterfaces::ANALOG_IO_TYPES + 2].get_value());
   }
 
-  io_pub_->publish(io_msg_);
+  publishIfDue(*io_pub_, io_msg_, io_schedule_, time);
 }
 
-void GPIOController::publishToolData()
+void GPIOController::publishToolData(const rclcpp::Time& time)
 {
   tool_data_msg_.tool_mode = static_cast<uint8_t>(state_interfaces_[StateInterfaces::TOOL_MODE].get_value());
   tool_data_msg_.analog_input_range2 =
@@ -236,37 +320,26 @@ void GPIOController::publishToolData()
   tool_data_msg_.tool_current = static_cast<float>(state_interfaces_[StateInterfaces::TOOL_OUTPUT_CURRENT].get_value());
   tool_data_msg_.tool_temperature =
       static_cast<float>(state_interfaces_[StateInterfaces::TOOL_TEMPERATURE].get_value());
-  tool_data_pub_->publish(tool_data_msg_);
+  publishIfDue(*tool_data_pub_, tool_data_msg_, tool_data_schedule_, time);
 }
 
-void GPIOController::publishRobotMode()
+void GPIOController::publishRobotMode(const rclcpp::Time& time)
 {
-  auto robot_mode = static_cast<int8_t>(state_interfaces_[StateInterfaces::ROBOT_MODE].get_value());
-
-  if (robot_mode_msg_.mode != robot_mode) {
-    robot_mode_msg_.mode = robot_mode;
-    robot_mode_pub_->publish(robot_mode_msg_);
-  }
+  robot_mode_msg_.mode = static_cast<int8_t>(state_interfaces_[StateInterfaces::ROBOT_MODE].get_value());
+  publishIfDue(*robot_mode_pub_, robot_mode_msg_, robot_mode_schedule_, time);
 }
 
-void GPIOController::publishSafetyMode()
+void GPIOController::publishSafetyMode(const rclcpp::Time& time)
 {
-  auto safety_mode = static_cast<uint8_t>(state_interfaces_[StateInterfaces::SAFETY_MODE].get_value());
-
-  if (safety_mode_msg_.mode != safety_mode) {
-    safety_mode_msg_.mode = safety_mode;
-    safety_mode_pub_->publish(safety_mode_msg_);
-  }
+  safety_mode_msg_.mode = static_cast<uint8_t>(state_interfaces_[StateInterfaces::SAFETY_MODE].get_value());
+  publishIfDue(*safety_mode_pub_, safety_mode_msg_, safety_mode_schedule_, time);
 }
 
-void GPIOController::publishProgramRunning()
+void GPIOController::publishProgramRunning(const rclcpp::Time& time)
 {
   auto program_running_value = static_cast<uint8_t>(state_interfaces_[StateInterfaces::PROGRAM_RUNNING].get_value());
-  bool program_running = program_running_value == 1.0 ? true : false;
-  if (program_running_msg_.data != program_running) {
-    program_running_msg_.data = program_running;
-    program_state_pub_->publish(program_running_msg_);
-  }
+  program_running_msg_.data = program_running_value == 1.0 ? true : false;
+  publishIfDue(*program_state_pub_, program_running_msg_, program_state_schedule_, time);
 }
 
 controller_interface::CallbackReturn
@@ -281,19 +354,48 @@ ur_controllers::GPIOController::on_activate(const rclcpp_lifecycle::State& /*pre
     auto qos_latched = rclcpp::SystemDefaultsQoS();
     qos_latched.transient_local();
     // register publisher
-    io_pub_ = get_node()->create_publisher<ur_msgs::msg::IOStates>("~/io_states", rclcpp::SystemDefaultsQoS());
-
-    tool_data_pub_ =
-        get_node()->create_publisher<ur_msgs::msg::ToolDataMsg>("~/tool_data", rclcpp::SystemDefaultsQoS());
+    io_pub_ = std::make_unique<realtime_tools::RealtimePublisher<ur_msgs::msg::IOStates>>(
+        get_node()->create_publisher<ur_msgs::msg::IOStates>("~/io_states", rclcpp::SystemDefaultsQoS()));
+    // Size the published message up front, so handing over the first state doesn't allocate in update()
+    io_pub_->lock();
+    io_pub_->msg_ = io_msg_;
+    io_pub_->unlock();
+
+    tool_data_pub_ = std::make_unique<realtime_tools::RealtimePublisher<ur_msgs::msg::ToolDataMsg>>(
+        get_node()->create_publisher<ur_msgs::msg::ToolDataMsg>("~/tool_data", rclcpp::SystemDefaultsQoS()));
+
+    robot_mode_pub_ = std::make_unique<realtime_tools::RealtimePublisher<ur_dashboard_msgs::msg::RobotMode>>(
+        get_node()->create_publisher<ur_dashboard_msgs::msg::RobotMode>("~/robot_mode", qos_latched));
+
+    safety_mode_pub_ = std::make_unique<realtime_tools::RealtimePublisher<ur_dashboard_msgs::msg::SafetyMode>>(
+        get_node()->create_publisher<ur_dashboard_msgs::msg::SafetyMode>("~/safety_mode", qos_latched));
+
+    program_state_pub_ = std::make_unique<realtime_tools::RealtimePublisher<std_msgs::msg::Bool>>(
+        get_node()->create_publisher<std_msgs::msg::Bool>("~/robot_program_running", qos_latched));
+
+    // Every topic gets published in the first cycle, afterwards only on changes and with the heartbeat
+    io_schedule_.configure(params_.publish_rate.io_states, params_.heartbeat_rate.io_states);
+    tool_data_schedule_.configure(params_.publish_rate.tool_data, params_.heartbeat_rate.tool_data);
+    robot_mode_schedule_.configure(0.0, params_.heartbeat_rate.robot_mode);
+    safety_mode_schedule_.configure(0.0, params_.heartbeat_rate.safety_mode);
+    program_state_schedule_.configure(0.0, params_.heartbeat_rate.robot_program_running);
+    io_schedule_.reset();
+    tool_data_schedule_.reset();
+    robot_mode_schedule_.reset();
+    safety_mode_schedule_.reset();
+    program_state_schedule_.reset();
 
-    robot_mode_pub_ = get_node()->create_publisher<ur_dashboard_msgs::msg::RobotMode>("~/robot_mode", qos_latched);
-
-    safety_mode_pub_ = get_node()->create_publisher<ur_dashboard_msgs::msg::SafetyMode>("~/safety_mode", qos_latched);
-
-    program_state_pub_ = get_node()->create_publisher<std_msgs::msg::Bool>("~/robot_program_running", qos_latched);
     set_io_srv_ = get_node()->create_service<ur_msgs::srv::SetIO>(
         "~/set_io", std::bind(&GPIOController::setIO, this, std::placeholders::_1, std::placeholders::_2));
 
+    io_batch_pending_ = false;
+    // A previous activation may have left its last sequence number in the hardware, which must not match a new batch
+    const double last_acknowledged = command_interfaces_[CommandInterfaces::IO_BATCH_ACKNOWLEDGED].get_value();
+    io_batch_sequence_ = std::isnan(last_acknowledged) ? 0.0 : last_acknowledged;
+    set_io_batch_srv_ = get_node()->create_service<ur_dashboard_msgs::srv::SetIOBatch>(
+        "~/set_io_batch",
+        std::bind(&GPIOController::setIOBatch, this, std::placeholders::_1, std::placeholders::_2));
+
     set_speed_slider_srv_ = get_node()->create_service<ur_msgs::srv::SetSpeedSliderFraction>(
         "~/set_speed_slider",
         std::bind(&GPIOController::setSpeedSlider, this, std::placeholders::_1, std::placeholders::_2));
@@ -329,6 +431,7 @@ ur_controllers::GPIOController::on_deactivate(const rclcpp_lifecycle::State& /*p
     safety_mode_pub_.reset();
     program_state_pub_.reset();
     set_io_srv_.reset();
+    set_io_batch_srv_.reset();
     set_speed_slider_srv_.reset();
   } catch (...) {
     return LifecycleNodeInterface::CallbackReturn::ERROR;
@@ -385,6 +488,62 @@ bool GPIOController::setIO(ur_msgs::srv::SetIO::Request::SharedPtr req, ur_msgs:
   }
 }
 
+bool GPIOController::setIOBatch(ur_dashboard_msgs::srv::SetIOBatch::Request::SharedPtr req,
+                                ur_dashboard_msgs::srv::SetIOBatch::Response::SharedPtr resp)
+{
+  resp->results.assign(req->fun.size(), false);
+  resp->success = false;
+  if (req->pin.size() != req->fun.size() || req->state.size() != req->fun.size()) {
+    RCLCPP_WARN(get_node()->get_logger(), "The lists fun, pin and state of an IO batch need to have the same length. "
+                                          "Request ignored.");
+    return false;
+  }
+
+  io_batch_cmd_.fill(std::numeric_limits<double>::quiet_NaN());
+  std::vector<bool> valid(req->fun.size(), false);
+  for (size_t i = 0; i < req->fun.size(); ++i) {
+    const auto pin = req->pin[i];
+    if (req->fun[i] == req->FUN_SET_DIGITAL_OUT && pin >= 0 && pin <= 17) {
+      io_batch_cmd_[CommandInterfaces::DIGITAL_OUTPUTS_CMD + pin] = static_cast<double>(req->state[i]);
+    } else if (req->fun[i] == req->FUN_SET_ANALOG_OUT && pin >= 0 && pin <= 1) {
+      io_batch_cmd_[CommandInterfaces::ANALOG_OUTPUTS_CMD + pin] = static_cast<double>(req->state[i]);
+    } else if (req->fun[i] == req->FUN_SET_TOOL_VOLTAGE) {
+      io_batch_cmd_[CommandInterfaces::TOOL_VOLTAGE_CMD] = static_cast<double>(req->state[i]);
+    } else {
+      RCLCPP_WARN(get_node()->get_logger(), "Ignoring invalid entry %zu of IO batch (fun: %d, pin: %d).", i,
+                  req->fun[i], pin);
+      continue;
+    }
+    valid[i] = true;
+  }
+
+  const auto valid_count = std::count(valid.begin(), valid.end(), true);
+  if (valid_count == 0) {
+    return false;
+  }
+
+  RCLCPP_INFO(get_node()->get_logger(), "Setting %ld IOs.", static_cast<long>(valid_count));
+  // io_async_success belongs to this batch once the hardware acknowledged its sequence number
+  const double sequence = ++io_batch_sequence_;
+  io_batch_pending_.store(true, std::memory_order_release);
+
+  const bool acknowledged = waitForAcknowledgement(
+      [&]() { return command_interfaces_[CommandInterfaces::IO_BATCH_ACKNOWLEDGED].get_value() == sequence; });
+  if (!acknowledged) {
+    io_batch_pending_.store(false, std::memory_order_release);
+    RCLCPP_WARN(get_node()->get_logger(), "Could not verify that the ios were set. (This might happen when using the "
+                                          "mocked interface)");
+  }
+
+  const bool batch_success =
+      acknowledged && command_interfaces_[CommandInterfaces::IO_ASYNC_SUCCESS].get_value() == 1.0;
+  for (size_t i = 0; i < valid.size(); ++i) {
+    resp->results[i] = valid[i] && batch_success;
+  }
+  resp->success = batch_success && static_cast<size_t>(valid_count) == valid.size();
+  return resp->success;
+}
+
 bool GPIOController::setSpeedSlider(ur_msgs::srv::SetSpeedSliderFraction::Request::SharedPtr req,
                                     ur_msgs::srv::SetSpeedSliderFraction::Response::SharedPtr resp)
 {
@@ -529,17 +688,24 @@ void GPIOController::initMsgs()
 }
 
 bool GPIOController::waitForAsyncCommand(std::function<double(void)> get_value)
+{
+  return waitForAcknowledgement([&]() { return get_value() != ASYNC_WAITING; });
+}
+
+bool GPIOController::waitForAcknowledgement(std::function<bool(void)> acknowledged)
 {
   const auto maximum_retries = params_.check_io_successfull_retries;
-  int retries = 0;
-  while (get_value() == ASYNC_WAITING) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    retries++;
+  std::unique_lock<std::mutex> lock(async_command_mutex_);
+  async_command_waiters_.fetch_add(1, std::memory_order_release);
 
-    if (retries > maximum_retries)
-      return false;
+  // Waiting in slices keeps the old timeout and still finishes if the controller stops being updated meanwhile
+  bool done = false;
+  for (int retries = 0; !done && retries <= maximum_retries; ++retries) {
+    done = async_command_cv_.wait_for(lock, std::chrono::milliseconds(50), acknowledged);
   }
-  return true;
+
+  async_command_waiters_.fetch_sub(1, std::memory_order_release);
+  return done;
 }
 
 }  // namespace ur_controllers
@@ -35,7 +35,11 @@
  */
 //----------------------------------------------------------------------
 
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "ur_controllers/scaled_joint_trajectory_controller.hpp"
@@ -54,6 +58,60 @@ controller_interface::CallbackReturn ScaledJointTrajectoryController::on_init()
   return JointTrajectoryController::on_init();
 }
 
+controller_interface::CallbackReturn
+ScaledJointTrajectoryController::on_configure(const rclcpp_lifecycle::State& previous_state)
+{
+  const auto ret = JointTrajectoryController::on_configure(previous_state);
+  if (ret != controller_interface::CallbackReturn::SUCCESS) {
+    return ret;
+  }
+
+  if (scaled_params_.trajectory_queue_depth > 0) {
+    // The goal callbacks of the joint_trajectory_controller can't be overridden, so the action server is created
+    // again with callbacks that append matching goals to the trajectory queue
+    using std::placeholders::_1;
+    using std::placeholders::_2;
+    action_server_.reset();
+    action_server_ = rclcpp_action::create_server<FollowJTrajAction>(
+        get_node()->get_node_base_interface(), get_node()->get_node_clock_interface(),
+        get_node()->get_node_logging_interface(), get_node()->get_node_waitables_interface(),
+        std::string(get_node()->get_name()) + "/follow_joint_trajectory",
+        std::bind(&ScaledJointTrajectoryController::queueing_goal_received_callback, this, _1, _2),
+        std::bind(&ScaledJointTrajectoryController::queueing_goal_cancelled_callback, this, _1),
+        std::bind(&ScaledJointTrajectoryController::queueing_goal_accepted_callback, this, _1));
+  }
+
+  // Goals finished in update() get released from the goal buffers outside of the real-time loop
+  finished_goal_timer_ = get_node()->create_wall_timer(action_monitor_period_.to_chrono<std::chrono::nanoseconds>(),
+                                                       [this]() {
+                                                         release_finished_goals();
+                                                         trajectory_queue_.run_non_realtime();
+                                                       });
+  return ret;
+}
+
+controller_interface::InterfaceConfiguration ScaledJointTrajectoryController::command_interface_configuration() const
+{
+  controller_interface::InterfaceConfiguration conf;
+  conf = JointTrajectoryController::command_interface_configuration();
+
+  if (scaled_params_.trajectory_forwarding) {
+    // Layout is relied upon in forward_trajectory(): positions, velocities and accelerations of all joints followed
+    // by the time from start, the number of points and the transfer state
+    const std::string& prefix = scaled_params_.trajectory_forwarding_interface_name;
+    for (const char* kind : { "position_", "velocity_", "acceleration_" }) {
+      for (size_t i = 0; i < params_.joints.size(); ++i) {
+        conf.names.push_back(prefix + "/" + kind + std::to_string(i));
+      }
+    }
+    conf.names.push_back(prefix + "/time_from_start");
+    conf.names.push_back(prefix + "/point_count");
+    conf.names.push_back(prefix + "/transfer_state");
+  }
+
+  return conf;
+}
+
 controller_interface::InterfaceConfiguration ScaledJointTrajectoryController::state_interface_configuration() const
 {
   controller_interface::InterfaceConfiguration conf;
@@ -70,9 +128,39 @@ controller_interface::CallbackReturn ScaledJointTrajectoryController::on_activat
   time_data.period = rclcpp::Duration::from_nanoseconds(0);
   time_data.uptime = get_node()->now();
   time_data_.initRT(time_data);
+  forwarded_trajectory_msg_.reset();
+  next_forwarded_point_ = 0;
+  trajectory_sampler_.reset();
+  trajectory_sampler_.reserve(dof_);
+
+  tolerance_evaluator_.configure(
+      joints_angle_wraparound_,
+      has_velocity_state_interface_ && (has_velocity_command_interface_ || has_effort_command_interface_),
+      has_acceleration_state_interface_ && has_acceleration_command_interface_);
+  speed_scaling_filter_.configure(scaled_params_.time_warp.max_scaling_rate,
+                                  scaled_params_.time_warp.max_scaling_acceleration);
+  speed_scaling_filter_.reset(1.0);
+
+  // Feedback messages are filled in place, so they only need to be sized once
+  for (auto& feedback : feedback_msgs_) {
+    feedback = std::make_shared<FollowJTrajAction::Feedback>();
+    feedback->joint_names = params_.joints;
+    feedback->actual = state_current_;
+    feedback->desired = state_current_;
+    feedback->error = state_current_;
+  }
+  last_feedback_ns_ = 0;
   return JointTrajectoryController::on_activate(state);
 }
 
+controller_interface::CallbackReturn
+ScaledJointTrajectoryController::on_deactivate(const rclcpp_lifecycle::State& state)
+{
+  // update() doesn't run anymore, so the queue can be emptied from here
+  abort_queued_goals("Controller deactivated");
+  return JointTrajectoryController::on_deactivate(state);
+}
+
 controller_interface::return_type ScaledJointTrajectoryController::update(const rclcpp::Time& time,
                                                                           const rclcpp::Duration& period)
 {
@@ -93,32 +181,21 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
     default_tolerances_ = get_segment_tolerances(logger, params_);
   }
 
-  auto compute_error_for_joint = [&](JointTrajectoryPoint& error, int index, const JointTrajectoryPoint& current,
-                                     const JointTrajectoryPoint& desired) {
-    // error defined as the difference between current and desired
-    if (joints_angle_wraparound_[index]) {
-      // if desired, the shortest_angular_distance is calculated, i.e., the error is
-      //  normalized between -pi<error<pi
-      error.positions[index] = angles::shortest_angular_distance(current.positions[index], desired.positions[index]);
-    } else {
-      error.positions[index] = desired.positions[index] - current.positions[index];
-    }
-    if (has_velocity_state_interface_ && (has_velocity_command_interface_ || has_effort_command_interface_)) {
-      error.velocities[index] = desired.velocities[index] - current.velocities[index];
-    }
-    if (has_acceleration_state_interface_ && has_acceleration_command_interface_) {
-      error.accelerations[index] = desired.accelerations[index] - current.accelerations[index];
-    }
-  };
-
   // don't update goal after we sampled the trajectory to avoid any racecondition
-  const auto active_goal = *rt_active_goal_.readFromRT();
+  auto active_goal = *rt_active_goal_.readFromRT();
+  bool has_pending_goal = *rt_has_pending_goal_.readFromRT();
+  if (finished_goals_.is_finished(active_goal)) {
+    // Finished in a previous cycle, but not yet released from the goal buffers
+    active_goal.reset();
+    has_pending_goal = false;
+  }
+  update_queued_goals(active_goal, has_pending_goal);
 
   // Check if a new external message has been received from nonRT threads
   auto current_external_msg = traj_external_point_ptr_->get_trajectory_msg();
   auto new_external_msg = traj_msg_external_point_ptr_.readFromRT();
   // Discard, if a goal is pending but still not active (somewhere stuck in goal_handle_timer_)
-  if (current_external_msg != *new_external_msg && (*(rt_has_pending_goal_.readFromRT()) && !active_goal) == false) {
+  if (current_external_msg != *new_external_msg && (has_pending_goal && !active_goal) == false) {
     fill_partial_goal(*new_external_msg);
     sort_to_local_joint_order(*new_external_msg);
     // TODO(denis): Add here integration of position and velocity
@@ -137,6 +214,15 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
   state_current_.time_from_start.set__sec(0);
   read_state_from_state_interfaces(state_current_);
 
+  if (scaled_params_.trajectory_forwarding) {
+    // The robot interpolates and scales the trajectory itself
+    if (has_active_trajectory()) {
+      forward_trajectory(time, active_goal);
+    }
+    publish_state(state_desired_, state_current_, state_error_);
+    return controller_interface::return_type::OK;
+  }
+
   // currently carrying out a trajectory
   if (has_active_trajectory()) {
     // Main Speed scaling difference...
@@ -144,7 +230,11 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
     TimeData time_data;
     time_data.time = time;
     rcl_duration_value_t t_period = (time_data.time - time_data_.readFromRT()->time).nanoseconds();
-    time_data.period = rclcpp::Duration::from_nanoseconds(scaling_factor_ * t_period);
+    double scaling_factor = scaling_factor_;
+    if (scaled_params_.time_warp.max_scaling_rate > 0.0) {
+      scaling_factor = speed_scaling_filter_.update(scaling_factor_, look_ahead_scaling_limit(), t_period * 1e-9);
+    }
+    time_data.period = rclcpp::Duration::from_nanoseconds(scaling_factor * t_period);
     time_data.uptime = time_data_.readFromRT()->uptime + time_data.period;
     rclcpp::Time traj_time = time_data_.readFromRT()->uptime + rclcpp::Duration::from_nanoseconds(t_period);
     time_data_.reset();
@@ -164,8 +254,8 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
 
     // find segment for current timestamp
     joint_trajectory_controller::TrajectoryPointConstIter start_segment_itr, end_segment_itr;
-    const bool valid_point = traj_external_point_ptr_->sample(traj_time, interpolation_method_, state_desired_,
-                                                              start_segment_itr, end_segment_itr);
+    const bool valid_point = trajectory_sampler_.sample(*traj_external_point_ptr_, traj_time, interpolation_method_,
+                                                        state_desired_, start_segment_itr, end_segment_itr);
 
     if (valid_point) {
       const rclcpp::Time traj_start = traj_external_point_ptr_->time_from_start();
@@ -181,7 +271,11 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
       bool outside_goal_tolerance = false;
       bool within_goal_time = true;
       const bool before_last_point = end_segment_itr != traj_external_point_ptr_->end();
-      auto active_tol = active_tolerances_.readFromRT();
+      // The active tolerances are only set for goals that didn't come from the trajectory queue
+      const joint_trajectory_controller::SegmentTolerances* active_tol = active_tolerances_.readFromRT();
+      if (active_goal && active_goal == running_queued_goal_.goal) {
+        active_tol = running_queued_goal_.tolerances.get();
+      }
 
       // have we reached the end, are not holding position, and is a timeout configured?
       // Check independently of other tolerances
@@ -193,29 +287,34 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
         traj_msg_external_point_ptr_.initRT(set_hold_position());
       }
 
-      // Check state/goal tolerance
-      for (size_t index = 0; index < dof_; ++index) {
-        compute_error_for_joint(state_error_, index, state_current_, state_desired_);
-
-        // Always check the state tolerance on the first sample in case the first sample
-        // is the last point
+      // Check state/goal tolerance of all joints at once
+      const bool is_holding = *(rt_is_holding_.readFromRT());
+      // Always check the state tolerance on the first sample in case the first sample
+      // is the last point
+      const bool check_state_tolerance = (before_last_point || first_sample) && !is_holding;
+      // past the final point, check that we end up inside goal tolerance
+      const bool check_goal_tolerance = !before_last_point && !is_holding;
+      const ToleranceCheck tolerance_check = tolerance_evaluator_.evaluate(
+          state_current_, state_desired_, *active_tol, check_state_tolerance, check_goal_tolerance, state_error_);
+
+      if (tolerance_check.state_violated) {
+        tolerance_violated_while_moving = true;
         // print output per default, goal will be aborted afterwards
-        if ((before_last_point || first_sample) && *(rt_is_holding_.readFromRT()) == false &&
-            !check_state_tolerance_per_joint(state_error_, index, active_tol->state_tolerance[index],
-                                             true /* show_errors */)) {
-          tolerance_violated_while_moving = true;
+        for (size_t index = 0; index < dof_; ++index) {
+          check_state_tolerance_per_joint(state_error_, index, active_tol->state_tolerance[index],
+                                          true /* show_errors */);
         }
-        // past the final point, check that we end up inside goal tolerance
-        if (!before_last_point && *(rt_is_holding_.readFromRT()) == false &&
-            !check_state_tolerance_per_joint(state_error_, index, active_tol->goal_state_tolerance[index],
-                                             false /* show_errors */)) {
-          outside_goal_tolerance = true;
-
-          if (active_tol->goal_time_tolerance != 0.0) {
-            // if we exceed goal_time_tolerance set it to aborted
-            if (time_difference > active_tol->goal_time_tolerance) {
-              within_goal_time = false;
-              // print once, goal will be aborted afterwards
+      }
+      if (tolerance_check.goal_violated) {
+        outside_goal_tolerance = true;
+
+        // if we exceed goal_time_tolerance set it to aborted
+        if (active_tol->goal_time_tolerance != 0.0 && time_difference > active_tol->goal_time_tolerance) {
+          within_goal_time = false;
+          // print once, goal will be aborted afterwards
+          for (size_t index = 0; index < dof_; ++index) {
+            if (!check_state_tolerance_per_joint(state_error_, index, active_tol->goal_state_tolerance[index],
+                                                 false /* show_errors */)) {
               check_state_tolerance_per_joint(state_error_, index, default_tolerances_.goal_state_tolerance[index],
                                               true /* show_errors */);
             }
@@ -258,14 +357,13 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
 
       if (active_goal) {
         // send feedback
-        auto feedback = std::make_shared<FollowJTrajAction::Feedback>();
-        feedback->header.stamp = time;
-        feedback->joint_names = params_.joints;
-
-        feedback->actual = state_current_;
-        feedback->desired = state_desired_;
-        feedback->error = state_error_;
-        active_goal->setFeedback(feedback);
+        auto feedback = get_feedback_msg(time);
+        if (feedback) {
+          feedback->actual = state_current_;
+          feedback->desired = state_desired_;
+          feedback->error = state_error_;
+          active_goal->setFeedback(feedback);
+        }
 
         // check abort
         if (tolerance_violated_while_moving) {
@@ -273,10 +371,8 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
           result->set__error_code(FollowJTrajAction::Result::PATH_TOLERANCE_VIOLATED);
           result->set__error_string("Aborted due to path tolerance violation");
           active_goal->setAborted(result);
-          // TODO(matthew-reynolds): Need a lock-free write here
-          // See https://github.com/ros-controls/ros2_controllers/issues/168
-          rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
-          rt_has_pending_goal_.writeFromNonRT(false);
+          finish_active_goal(active_goal);
+          abort_queued_goals("Aborted as a previous goal violated the path tolerance");
 
           RCLCPP_WARN(logger, "Aborted due to state tolerance violation");
 
@@ -289,15 +385,16 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
             result->set__error_code(FollowJTrajAction::Result::SUCCESSFUL);
             result->set__error_string("Goal successfully reached!");
             active_goal->setSucceeded(result);
-            // TODO(matthew-reynolds): Need a lock-free write here
-            // See https://github.com/ros-controls/ros2_controllers/issues/168
-            rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
-            rt_has_pending_goal_.writeFromNonRT(false);
+            // Continue with the next queued goal right away instead of settling at its first point
+            const auto next_goal = start_next_queued_goal();
+            finish_active_goal(active_goal, next_goal);
 
             RCLCPP_INFO(logger, "Goal reached, success!");
 
-            traj_msg_external_point_ptr_.reset();
-            traj_msg_external_point_ptr_.initRT(set_success_trajectory_point());
+            if (!next_goal) {
+              traj_msg_external_point_ptr_.reset();
+              traj_msg_external_point_ptr_.initRT(set_success_trajectory_point());
+            }
           } else if (!within_goal_time) {
             const std::string error_string =
                 "Aborted due to goal_time_tolerance exceeding by " + std::to_string(time_difference) + " seconds";
@@ -306,10 +403,8 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
             result->set__error_code(FollowJTrajAction::Result::GOAL_TOLERANCE_VIOLATED);
             result->set__error_string(error_string);
             active_goal->setAborted(result);
-            // TODO(matthew-reynolds): Need a lock-free write here
-            // See https://github.com/ros-controls/ros2_controllers/issues/168
-            rt_active_goal_.writeFromNonRT(RealtimeGoalHandlePtr());
-            rt_has_pending_goal_.writeFromNonRT(false);
+            finish_active_goal(active_goal);
+            abort_queued_goals("Aborted as a previous goal exceeded the goal time tolerance");
 
             RCLCPP_WARN(logger, error_string.c_str());
 
@@ -317,13 +412,13 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
             traj_msg_external_point_ptr_.initRT(set_hold_position());
           }
         }
-      } else if (tolerance_violated_while_moving && *(rt_has_pending_goal_.readFromRT()) == false) {
+      } else if (tolerance_violated_while_moving && !has_pending_goal) {
         // we need to ensure that there is no pending goal -> we get a race condition otherwise
         RCLCPP_ERROR(logger, "Holding position due to state tolerance violation");
 
         traj_msg_external_point_ptr_.reset();
         traj_msg_external_point_ptr_.initRT(set_hold_position());
-      } else if (!before_last_point && !within_goal_time && *(rt_has_pending_goal_.readFromRT()) == false) {
+      } else if (!before_last_point && !within_goal_time && !has_pending_goal) {
         RCLCPP_ERROR(logger, "Exceeded goal_time_tolerance: holding position...");
 
         traj_msg_external_point_ptr_.reset();
@@ -333,12 +428,328 @@ controller_interface::return_type ScaledJointTrajectoryController::update(const
       // to be satisfied (will stay in this state until new message arrives)
       // or outside_goal_tolerance violated within the goal_time_tolerance
     }
+  } else {
+    speed_scaling_filter_.reset(scaling_factor_);
   }
 
   publish_state(state_desired_, state_current_, state_error_);
   return controller_interface::return_type::OK;
 }
 
+double ScaledJointTrajectoryController::look_ahead_scaling_limit() const
+{
+  const auto& time_warp = scaled_params_.time_warp;
+  if (time_warp.look_ahead_time <= 0.0 || time_warp.max_joint_acceleration <= 0.0) {
+    return 1.0;
+  }
+  // Accelerations scale with the square of the speed scaling factor
+  const double max_acceleration = trajectory_sampler_.max_acceleration_ahead(time_warp.look_ahead_time);
+  if (max_acceleration <= time_warp.max_joint_acceleration) {
+    return 1.0;
+  }
+  return std::sqrt(time_warp.max_joint_acceleration / max_acceleration);
+}
+
+std::shared_ptr<control_msgs::action::FollowJointTrajectory::Feedback>
+ScaledJointTrajectoryController::get_feedback_msg(const rclcpp::Time& time)
+{
+  const double feedback_rate = scaled_params_.feedback_rate;
+  if (feedback_rate > 0.0 && last_feedback_ns_ != 0 &&
+      static_cast<double>(time.nanoseconds() - last_feedback_ns_) < 1e9 / feedback_rate) {
+    return nullptr;
+  }
+
+  // The goal handle keeps the last feedback until it got published, that one must not be touched
+  for (auto& feedback : feedback_msgs_) {
+    if (feedback.use_count() == 1) {
+      last_feedback_ns_ = time.nanoseconds();
+      feedback->header.stamp = time;
+      return feedback;
+    }
+  }
+  return nullptr;
+}
+
+void ScaledJointTrajectoryController::finish_active_goal(const RealtimeGoalHandlePtr& active_goal,
+                                                         const RealtimeGoalHandlePtr& next_goal)
+{
+  if (active_goal && trajectory_queue_.handed_over().goal == active_goal) {
+    trajectory_queue_.clear_handed_over();
+  }
+
+  // Writing to the goal buffers locks a mutex, so the goal is only marked as finished here and released from the
+  // buffers by release_finished_goals().
+  if (!finished_goals_.finish(active_goal, next_goal)) {
+    RCLCPP_WARN(get_node()->get_logger(), "Too many finished goals waiting to be released, releasing goal directly.");
+    rt_active_goal_.writeFromNonRT(next_goal);
+    rt_has_pending_goal_.writeFromNonRT(false);
+  }
+}
+
+void ScaledJointTrajectoryController::release_finished_goals()
+{
+  finished_goals_.release([this](const RealtimeGoalHandlePtr& goal, const RealtimeGoalHandlePtr& next_goal) {
+    // A new goal might have been accepted in the meantime, which must be kept
+    if (*rt_active_goal_.readFromNonRT() == goal) {
+      rt_active_goal_.writeFromNonRT(next_goal);
+      rt_has_pending_goal_.writeFromNonRT(false);
+    }
+  });
+}
+
+size_t ScaledJointTrajectoryController::trajectory_queue_depth() const
+{
+  if (scaled_params_.trajectory_queue_depth <= 0 || scaled_params_.trajectory_forwarding) {
+    return 0;
+  }
+  return static_cast<size_t>(scaled_params_.trajectory_queue_depth);
+}
+
+bool ScaledJointTrajectoryController::active_goal_in_progress() const
+{
+  const auto active_goal = *rt_active_goal_.readFromNonRT();
+  return active_goal && active_goal->gh_->is_active();
+}
+
+rclcpp_action::GoalResponse
+ScaledJointTrajectoryController::queueing_goal_received_callback(const rclcpp_action::GoalUUID& uuid,
+                                                                 std::shared_ptr<const FollowJTrajAction::Goal> goal)
+{
+  if (trajectory_queue_.is_full_for(goal->trajectory, active_goal_in_progress(),
+                                    scaled_params_.trajectory_append_tolerance, trajectory_queue_depth())) {
+    RCLCPP_ERROR(get_node()->get_logger(), "Trajectory queue is full, rejecting goal that would be appended.");
+    return rclcpp_action::GoalResponse::REJECT;
+  }
+  return goal_received_callback(uuid, goal);
+}
+
+rclcpp_action::CancelResponse ScaledJointTrajectoryController::queueing_goal_cancelled_callback(
+    const std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+{
+  // Queued goals are canceled by update() once it gets to them
+  trajectory_queue_.cancel(goal_handle);
+  const auto active_goal = *rt_active_goal_.readFromNonRT();
+  if (active_goal && active_goal->gh_ == goal_handle) {
+    // The queued goals continue the canceled trajectory, so none of them may start from the held position. Requested
+    // before the goal is canceled below, so update() aborts them before it could start the next one.
+    trajectory_queue_.cancel_queued_behind_active();
+  }
+  return goal_cancelled_callback(goal_handle);
+}
+
+void ScaledJointTrajectoryController::queueing_goal_accepted_callback(
+    std::shared_ptr<rclcpp_action::ServerGoalHandle<FollowJTrajAction>> goal_handle)
+{
+  auto logger = get_node()->get_logger();
+  const QueuedGoal queued{
+    std::make_shared<RealtimeGoalHandle>(goal_handle),
+    std::make_shared<trajectory_msgs::msg::JointTrajectory>(goal_handle->get_goal()->trajectory),
+    std::make_shared<joint_trajectory_controller::SegmentTolerances>(
+        get_segment_tolerances(logger, default_tolerances_, *goal_handle->get_goal(), params_.joints)),
+    std::make_shared<std::atomic<bool>>(false)
+  };
+  if (trajectory_queue_.accept(queued, active_goal_in_progress(), scaled_params_.trajectory_append_tolerance,
+                               trajectory_queue_depth())) {
+    RCLCPP_INFO(logger, "Appended goal to the trajectory queue.");
+    return;
+  }
+  goal_accepted_callback(goal_handle);
+}
+
+void ScaledJointTrajectoryController::update_queued_goals(RealtimeGoalHandlePtr& active_goal, bool has_pending_goal)
+{
+  if (trajectory_queue_.take_flush_request()) {
+    abort_queued_goals("Replaced by a new goal");
+  }
+  if (trajectory_queue_.take_cancel_flush_request()) {
+    // A goal taken from the queue already followed the canceled one in update(), only the goals behind it are aborted
+    abort_queued_goals("Aborted as a previous goal was canceled", false);
+  }
+
+  // A copy, as finishing the goal clears the handed over goal
+  const QueuedGoal handed_over = trajectory_queue_.handed_over();
+  if (handed_over.goal) {
+    if (active_goal == handed_over.goal) {
+      // Arrived in the goal buffer, from now on it is handled like any other goal
+      trajectory_queue_.clear_handed_over();
+    } else if (active_goal) {
+      // Replaced by a new goal before it arrived in the goal buffer
+      abort_queued_goals("Replaced by a new goal");
+    } else if (handed_over.canceled->load()) {
+      auto result = std::make_shared<FollowJTrajAction::Result>();
+      result->set__error_code(FollowJTrajAction::Result::SUCCESSFUL);
+      result->set__error_string("Goal canceled");
+      handed_over.goal->setCanceled(result);
+      finish_active_goal(handed_over.goal);
+      abort_queued_goals("Aborted as a previous goal was canceled");
+
+      traj_msg_external_point_ptr_.reset();
+      traj_msg_external_point_ptr_.initRT(set_hold_position());
+    } else {
+      active_goal = handed_over.goal;
+    }
+  }
+
+  // Goals appended while the last goal was finishing
+  if (!active_goal && !has_pending_goal && trajectory_queue_.size() > 0) {
+    active_goal = start_next_queued_goal();
+    if (active_goal) {
+      finish_active_goal(RealtimeGoalHandlePtr(), active_goal);
+    }
+  }
+}
+
+ScaledJointTrajectoryController::RealtimeGoalHandlePtr ScaledJointTrajectoryController::start_next_queued_goal()
+{
+  auto cancel = [](const RealtimeGoalHandlePtr& goal) {
+    auto result = std::make_shared<FollowJTrajAction::Result>();
+    result->set__error_code(FollowJTrajAction::Result::SUCCESSFUL);
+    result->set__error_string("Goal canceled");
+    goal->setCanceled(result);
+  };
+  if (!trajectory_queue_.start_next(cancel, running_queued_goal_)) {
+    return RealtimeGoalHandlePtr();
+  }
+
+  traj_msg_external_point_ptr_.reset();
+  traj_msg_external_point_ptr_.initRT(running_queued_goal_.trajectory);
+  rt_is_holding_.initRT(false);
+  return running_queued_goal_.goal;
+}
+
+void ScaledJointTrajectoryController::abort_queued_goals(const std::string& reason, bool handed_over)
+{
+  auto abort = [&reason](const RealtimeGoalHandlePtr& goal) {
+    auto result = std::make_shared<FollowJTrajAction::Result>();
+    result->set__error_code(FollowJTrajAction::Result::INVALID_GOAL);
+    result->set__error_string(reason);
+    goal->setAborted(result);
+  };
+  if (handed_over) {
+    trajectory_queue_.abort_all(abort);
+  } else {
+    trajectory_queue_.abort_queued(abort);
+  }
+}
+
+void ScaledJointTrajectoryController::forward_trajectory(const rclcpp::Time& time,
+                                                         const RealtimeGoalHandlePtr& active_goal)
+{
+  auto logger = this->get_node()->get_logger();
+
+  const size_t offset = command_interfaces_.size() - (3 * dof_ + 3);
+  auto& time_from_start_interface = command_interfaces_[offset + 3 * dof_];
+  auto& point_count_interface = command_interfaces_[offset + 3 * dof_ + 1];
+  auto& transfer_state_interface = command_interfaces_[offset + 3 * dof_ + 2];
+  const int transfer_state = static_cast<int>(transfer_state_interface.get_value());
+
+  // Keep the position commands at the current state, so servoing continues without a jump once forwarding stopped
+  state_desired_.positions = state_current_.positions;
+  if (has_position_command_interface_) {
+    for (size_t index = 0; index < dof_; ++index) {
+      joint_command_interface_[0][index].get().set_value(state_current_.positions[index]);
+    }
+  }
+
+  const auto trajectory_msg = traj_external_point_ptr_->get_trajectory_msg();
+  if (trajectory_msg != forwarded_trajectory_msg_) {
+    // A trajectory that is still running on the robot has to be canceled before the new one can be started
+    if (transfer_state != TrajectoryTransferState::TRANSFER_IDLE &&
+        transfer_state != TrajectoryTransferState::TRANSFER_DONE &&
+        transfer_state != TrajectoryTransferState::TRANSFER_FAILED) {
+      transfer_state_interface.set_value(TrajectoryTransferState::TRANSFER_CANCEL);
+      return;
+    }
+
+    forwarded_trajectory_msg_ = trajectory_msg;
+    next_forwarded_point_ = 0;
+    if (*(rt_is_holding_.readFromRT()) || trajectory_msg->points.empty()) {
+      // Holding is done by servoing to the current position
+      transfer_state_interface.set_value(TrajectoryTransferState::TRANSFER_IDLE);
+      return;
+    }
+
+    point_count_interface.set_value(static_cast<double>(trajectory_msg->points.size()));
+    transfer_state_interface.set_value(TrajectoryTransferState::TRANSFER_START);
+    return;
+  }
+
+  if (transfer_state == TrajectoryTransferState::TRANSFER_READY &&
+      next_forwarded_point_ < trajectory_msg->points.size()) {
+    // Hand over one point per cycle, the robot buffers the points it has not reached yet
+    const auto& point = trajectory_msg->points[next_forwarded_point_];
+    for (size_t index = 0; index < dof_; ++index) {
+      command_interfaces_[offset + index].set_value(point.positions[index]);
+      command_interfaces_[offset + dof_ + index].set_value(point.velocities.empty() ? 0.0 : point.velocities[index]);
+      command_interfaces_[offset + 2 * dof_ + index].set_value(
+          point.accelerations.empty() ? 0.0 : point.accelerations[index]);
+    }
+    time_from_start_interface.set_value(rclcpp::Duration(point.time_from_start).seconds());
+    transfer_state_interface.set_value(TrajectoryTransferState::TRANSFER_POINT);
+    ++next_forwarded_point_;
+  } else if (transfer_state == TrajectoryTransferState::TRANSFER_DONE ||
+             transfer_state == TrajectoryTransferState::TRANSFER_FAILED) {
+    transfer_state_interface.set_value(TrajectoryTransferState::TRANSFER_IDLE);
+
+    bool outside_goal_tolerance = false;
+    const auto active_tol = active_tolerances_.readFromRT();
+    state_desired_.positions = trajectory_msg->points.back().positions;
+    for (size_t index = 0; index < dof_; ++index) {
+      if (joints_angle_wraparound_[index]) {
+        state_error_.positions[index] =
+            angles::shortest_angular_distance(state_current_.positions[index], state_desired_.positions[index]);
+      } else {
+        state_error_.positions[index] = state_desired_.positions[index] - state_current_.positions[index];
+      }
+      if (!check_state_tolerance_per_joint(state_error_, index, active_tol->goal_state_tolerance[index],
+                                           true /* show_errors */)) {
+        outside_goal_tolerance = true;
+      }
+    }
+
+    auto result = std::make_shared<FollowJTrajAction::Result>();
+    if (transfer_state == TrajectoryTransferState::TRANSFER_FAILED) {
+      result->set__error_code(FollowJTrajAction::Result::PATH_TOLERANCE_VIOLATED);
+      result->set__error_string("Robot aborted the forwarded trajectory");
+    } else if (outside_goal_tolerance) {
+      result->set__error_code(FollowJTrajAction::Result::GOAL_TOLERANCE_VIOLATED);
+      result->set__error_string("Forwarded trajectory finished outside of the goal tolerance");
+    } else {
+      result->set__error_code(FollowJTrajAction::Result::SUCCESSFUL);
+      result->set__error_string("Goal successfully reached!");
+    }
+
+    if (active_goal) {
+      if (result->error_code == FollowJTrajAction::Result::SUCCESSFUL) {
+        active_goal->setSucceeded(result);
+      } else {
+        active_goal->setAborted(result);
+      }
+      finish_active_goal(active_goal);
+    }
+
+    traj_msg_external_point_ptr_.reset();
+    if (result->error_code == FollowJTrajAction::Result::SUCCESSFUL) {
+      RCLCPP_INFO(logger, "Goal reached, success!");
+      traj_msg_external_point_ptr_.initRT(set_success_trajectory_point());
+    } else {
+      RCLCPP_WARN(logger, "%s", result->error_string.c_str());
+      traj_msg_external_point_ptr_.initRT(set_hold_position());
+    }
+    return;
+  }
+
+  if (active_goal) {
+    // The robot does not report its setpoints, so there is no tracking error to report
+    auto feedback = get_feedback_msg(time);
+    if (feedback) {
+      feedback->actual = state_current_;
+      feedback->desired = state_current_;
+      active_goal->setFeedback(feedback);
+    }
+  }
+}
+
 }  // namespace ur_controllers
 
 #include "pluginlib/class_list_macros.hpp"
@@ -0,0 +1,88 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+
+#include "ur_controllers/speed_scaling_filter.hpp"
+
+namespace ur_controllers
+{
+
+void SpeedScalingFilter::configure(double max_rate, double max_acceleration)
+{
+  max_rate_ = max_rate;
+  max_acceleration_ = max_acceleration;
+}
+
+void SpeedScalingFilter::reset(double scaling_factor)
+{
+  value_ = scaling_factor;
+  rate_ = 0.0;
+}
+
+double SpeedScalingFilter::update(double measured_scaling_factor, double limit, double dt)
+{
+  if (measured_scaling_factor < value_) {
+    // The robot slowed down, the trajectory must not run ahead of it
+    value_ = measured_scaling_factor;
+    rate_ = 0.0;
+  }
+  if (dt <= 0.0) {
+    return value_;
+  }
+
+  const double target = std::min(measured_scaling_factor, limit);
+  const double error = target - value_;
+  if (max_acceleration_ > 0.0) {
+    // Fastest rate from which the target can still be reached without overshooting
+    const double stopping_rate = std::sqrt(2.0 * max_acceleration_ * std::abs(error));
+    const double desired_rate = std::copysign(std::min(max_rate_, stopping_rate), error);
+    rate_ += std::clamp(desired_rate - rate_, -max_acceleration_ * dt, max_acceleration_ * dt);
+  } else {
+    rate_ = std::clamp(error / dt, -max_rate_, max_rate_);
+  }
+
+  value_ += rate_ * dt;
+  if ((rate_ > 0.0 && value_ > target) || (rate_ < 0.0 && value_ < target)) {
+    value_ = target;
+    rate_ = 0.0;
+  }
+  return value_;
+}
+
+}  // namespace ur_controllers
@@ -0,0 +1,118 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <cmath>
+
+#include "angles/angles.h"
+#include "ur_controllers/tolerance_evaluator.hpp"
+
+namespace ur_controllers
+{
+
+void ToleranceEvaluator::configure(const std::vector<bool>& angle_wraparound, bool compare_velocities,
+                                   bool compare_accelerations)
+{
+  dof_ = angle_wraparound.size();
+  wraparound_joints_.clear();
+  for (size_t index = 0; index < dof_; ++index) {
+    if (angle_wraparound[index]) {
+      wraparound_joints_.push_back(index);
+    }
+  }
+  compare_velocities_ = compare_velocities;
+  compare_accelerations_ = compare_accelerations;
+}
+
+ToleranceCheck ToleranceEvaluator::evaluate(const trajectory_msgs::msg::JointTrajectoryPoint& current,
+                                            const trajectory_msgs::msg::JointTrajectoryPoint& desired,
+                                            const joint_trajectory_controller::SegmentTolerances& tolerances,
+                                            bool check_state, bool check_goal,
+                                            trajectory_msgs::msg::JointTrajectoryPoint& error) const
+{
+  // error defined as the difference between current and desired
+  for (size_t index = 0; index < dof_; ++index) {
+    error.positions[index] = desired.positions[index] - current.positions[index];
+  }
+  // the error of these joints is normalized between -pi<error<pi
+  for (const size_t index : wraparound_joints_) {
+    error.positions[index] = angles::shortest_angular_distance(current.positions[index], desired.positions[index]);
+  }
+  if (compare_velocities_) {
+    for (size_t index = 0; index < dof_; ++index) {
+      error.velocities[index] = desired.velocities[index] - current.velocities[index];
+    }
+  }
+  if (compare_accelerations_) {
+    for (size_t index = 0; index < dof_; ++index) {
+      error.accelerations[index] = desired.accelerations[index] - current.accelerations[index];
+    }
+  }
+
+  ToleranceCheck result;
+  if (check_state) {
+    result.state_violated = violates(error, tolerances.state_tolerance);
+  }
+  if (check_goal) {
+    result.goal_violated = violates(error, tolerances.goal_state_tolerance);
+  }
+  return result;
+}
+
+bool ToleranceEvaluator::violates(const trajectory_msgs::msg::JointTrajectoryPoint& error,
+                                  const std::vector<joint_trajectory_controller::StateTolerances>& tolerances) const
+{
+  // Tolerances of 0 are not checked. Missing velocity or acceleration errors count as 0, same as in
+  // check_state_tolerance_per_joint().
+  const bool has_velocities = !error.velocities.empty();
+  const bool has_accelerations = !error.accelerations.empty();
+  for (size_t index = 0; index < dof_; ++index) {
+    const auto& tolerance = tolerances[index];
+    if (tolerance.position > 0.0 && std::abs(error.positions[index]) > tolerance.position) {
+      return true;
+    }
+    if (has_velocities && tolerance.velocity > 0.0 && std::abs(error.velocities[index]) > tolerance.velocity) {
+      return true;
+    }
+    if (has_accelerations && tolerance.acceleration > 0.0 &&
+        std::abs(error.accelerations[index]) > tolerance.acceleration) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace ur_controllers
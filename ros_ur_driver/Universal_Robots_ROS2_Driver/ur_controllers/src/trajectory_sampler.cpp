@@ -0,0 +1,266 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+
+#include "ur_controllers/trajectory_sampler.hpp"
+#include "rclcpp/duration.hpp"
+
+namespace ur_controllers
+{
+
+void TrajectorySampler::reserve(size_t dof)
+{
+  coefficients_.resize(dof);
+}
+
+void TrajectorySampler::reset()
+{
+  trajectory_msg_.reset();
+  current_segment_ = NO_SEGMENT;
+  coefficients_segment_ = NO_SEGMENT;
+}
+
+bool TrajectorySampler::sample(
+    joint_trajectory_controller::Trajectory& trajectory, const rclcpp::Time& sample_time,
+    const joint_trajectory_controller::interpolation_methods::InterpolationMethod interpolation_method,
+    trajectory_msgs::msg::JointTrajectoryPoint& output_state,
+    joint_trajectory_controller::TrajectoryPointConstIter& start_segment_itr,
+    joint_trajectory_controller::TrajectoryPointConstIter& end_segment_itr)
+{
+  const auto trajectory_msg = trajectory.get_trajectory_msg();
+  if (trajectory_msg != trajectory_msg_) {
+    trajectory_msg_ = trajectory_msg;
+    current_segment_ = NO_SEGMENT;
+    coefficients_segment_ = NO_SEGMENT;
+  }
+
+  // The trajectory's start time is set when sampling it the first time. Before the first point there are no
+  // segments to search, so the trajectory can handle that itself.
+  if (!trajectory_msg_ || trajectory_msg_->points.empty() || !trajectory.is_sampled_already()) {
+    return trajectory.sample(sample_time, interpolation_method, output_state, start_segment_itr, end_segment_itr);
+  }
+  auto& points = trajectory_msg_->points;
+  const rclcpp::Time trajectory_start = trajectory.time_from_start();
+  if (sample_time < trajectory_start + points[0].time_from_start) {
+    return trajectory.sample(sample_time, interpolation_method, output_state, start_segment_itr, end_segment_itr);
+  }
+
+  // Sample time only moves backwards, if the trajectory's time got reset
+  if (current_segment_ == NO_SEGMENT || sample_time < trajectory_start + points[current_segment_].time_from_start) {
+    current_segment_ = 0;
+  }
+  const size_t last_idx = points.size() - 1;
+  while (current_segment_ < last_idx &&
+         sample_time >= trajectory_start + points[current_segment_ + 1].time_from_start) {
+    ++current_segment_;
+  }
+
+  if (current_segment_ == last_idx) {
+    // whole trajectory has played out
+    start_segment_itr = trajectory.begin() + last_idx;
+    end_segment_itr = trajectory.end();
+    output_state = points[last_idx];
+    // the points of the message may have empty velocities/accelerations
+    if (output_state.velocities.empty()) {
+      output_state.velocities.resize(output_state.positions.size(), 0.0);
+    }
+    if (output_state.accelerations.empty()) {
+      output_state.accelerations.resize(output_state.positions.size(), 0.0);
+    }
+    return true;
+  }
+
+  auto& point = points[current_segment_];
+  auto& next_point = points[current_segment_ + 1];
+  const rclcpp::Time segment_start = trajectory_start + point.time_from_start;
+  if (interpolation_method == joint_trajectory_controller::interpolation_methods::InterpolationMethod::NONE) {
+    output_state = next_point;
+  } else {
+    if (coefficients_segment_ != current_segment_) {
+      const double duration = ((trajectory_start + next_point.time_from_start) - segment_start).seconds();
+      // it changes points only if position and velocity do not exist, but their derivatives
+      trajectory.deduce_from_derivatives(point, next_point, point.positions.size(), duration);
+      compute_coefficients(point, next_point, duration);
+      coefficients_segment_ = current_segment_;
+    }
+    // Points with accelerations, but without velocities can't be interpolated
+    if (segment_type_ == SegmentType::UNDEFINED) {
+      return false;
+    }
+    evaluate((sample_time - segment_start).seconds(), output_state);
+  }
+
+  start_segment_itr = trajectory.begin() + current_segment_;
+  end_segment_itr = trajectory.begin() + (current_segment_ + 1);
+  return true;
+}
+
+double TrajectorySampler::max_acceleration_ahead(double look_ahead_time) const
+{
+  if (!trajectory_msg_ || trajectory_msg_->points.empty()) {
+    return 0.0;
+  }
+  const auto& points = trajectory_msg_->points;
+  const size_t first = current_segment_ == NO_SEGMENT ? 0 : current_segment_;
+  const double horizon = rclcpp::Duration(points[first].time_from_start).seconds() + look_ahead_time;
+
+  double max_acceleration = 0.0;
+  for (size_t i = first; i < points.size(); ++i) {
+    const auto& point = points[i];
+    const double point_time = rclcpp::Duration(point.time_from_start).seconds();
+    if (point_time > horizon) {
+      break;
+    }
+    if (!point.accelerations.empty()) {
+      for (const double acceleration : point.accelerations) {
+        max_acceleration = std::max(max_acceleration, std::abs(acceleration));
+      }
+    } else if (i > 0 && !point.velocities.empty() && !points[i - 1].velocities.empty()) {
+      const double dt = point_time - rclcpp::Duration(points[i - 1].time_from_start).seconds();
+      if (dt <= 0.0) {
+        continue;
+      }
+      for (size_t j = 0; j < point.velocities.size(); ++j) {
+        max_acceleration = std::max(max_acceleration, std::abs(point.velocities[j] - points[i - 1].velocities[j]) / dt);
+      }
+    }
+  }
+  return max_acceleration;
+}
+
+void TrajectorySampler::compute_coefficients(const trajectory_msgs::msg::JointTrajectoryPoint& start_point,
+                                             const trajectory_msgs::msg::JointTrajectoryPoint& end_point,
+                                             double duration)
+{
+  const bool has_velocity = !start_point.velocities.empty() && !end_point.velocities.empty();
+  const bool has_accel = !start_point.accelerations.empty() && !end_point.accelerations.empty();
+  if (!has_velocity && !has_accel) {
+    segment_type_ = SegmentType::LINEAR;
+  } else if (has_velocity && !has_accel) {
+    segment_type_ = SegmentType::CUBIC;
+  } else if (has_velocity && has_accel) {
+    segment_type_ = SegmentType::QUINTIC;
+  } else {
+    segment_type_ = SegmentType::UNDEFINED;
+    return;
+  }
+
+  // Only allocates if reserve() wasn't called with the trajectory's number of joints
+  coefficients_.resize(start_point.positions.size());
+
+  double T[6];
+  T[0] = 1.0;
+  for (size_t i = 1; i < 6; ++i) {
+    T[i] = T[i - 1] * duration;
+  }
+
+  for (size_t i = 0; i < coefficients_.size(); ++i) {
+    auto& c = coefficients_[i];
+    c.fill(0.0);
+    const double start_pos = start_point.positions[i];
+    const double end_pos = end_point.positions[i];
+    c[0] = start_pos;
+
+    if (segment_type_ == SegmentType::LINEAR) {
+      if (duration != 0.0) {
+        c[1] = (end_pos - start_pos) / duration;
+      }
+      continue;
+    }
+
+    const double start_vel = start_point.velocities[i];
+    const double end_vel = end_point.velocities[i];
+    c[1] = start_vel;
+    if (segment_type_ == SegmentType::CUBIC) {
+      if (duration != 0.0) {
+        c[2] = (-3.0 * start_pos + 3.0 * end_pos - 2.0 * start_vel * T[1] - end_vel * T[1]) / T[2];
+        c[3] = (2.0 * start_pos - 2.0 * end_pos + start_vel * T[1] + end_vel * T[1]) / T[3];
+      }
+      continue;
+    }
+
+    const double start_acc = start_point.accelerations[i];
+    const double end_acc = end_point.accelerations[i];
+    c[2] = 0.5 * start_acc;
+    if (duration != 0.0) {
+      c[3] = (-20.0 * start_pos + 20.0 * end_pos - 3.0 * start_acc * T[2] + end_acc * T[2] -
+              12.0 * start_vel * T[1] - 8.0 * end_vel * T[1]) /
+             (2.0 * T[3]);
+      c[4] = (30.0 * start_pos - 30.0 * end_pos + 3.0 * start_acc * T[2] - 2.0 * end_acc * T[2] +
+              16.0 * start_vel * T[1] + 14.0 * end_vel * T[1]) /
+             (2.0 * T[4]);
+      c[5] = (-12.0 * start_pos + 12.0 * end_pos - start_acc * T[2] + end_acc * T[2] - 6.0 * start_vel * T[1] -
+              6.0 * end_vel * T[1]) /
+             (2.0 * T[5]);
+    }
+  }
+}
+
+void TrajectorySampler::evaluate(double t, trajectory_msgs::msg::JointTrajectoryPoint& output_state) const
+{
+  const size_t dim = coefficients_.size();
+  output_state.positions.resize(dim, 0.0);
+  output_state.velocities.resize(dim, 0.0);
+  output_state.accelerations.resize(dim, 0.0);
+
+  for (size_t i = 0; i < dim; ++i) {
+    const auto& c = coefficients_[i];
+    switch (segment_type_) {
+      case SegmentType::LINEAR:
+        output_state.positions[i] = c[0] + t * c[1];
+        output_state.velocities[i] = c[1];
+        output_state.accelerations[i] = 0.0;
+        break;
+      case SegmentType::CUBIC:
+        output_state.positions[i] = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+        output_state.velocities[i] = c[1] + t * (2.0 * c[2] + t * 3.0 * c[3]);
+        output_state.accelerations[i] = 2.0 * c[2] + t * 6.0 * c[3];
+        break;
+      case SegmentType::QUINTIC:
+        output_state.positions[i] = c[0] + t * (c[1] + t * (c[2] + t * (c[3] + t * (c[4] + t * c[5]))));
+        output_state.velocities[i] = c[1] + t * (2.0 * c[2] + t * (3.0 * c[3] + t * (4.0 * c[4] + t * 5.0 * c[5])));
+        output_state.accelerations[i] = 2.0 * c[2] + t * (6.0 * c[3] + t * (12.0 * c[4] + t * 20.0 * c[5]));
+        break;
+      case SegmentType::UNDEFINED:
+        break;
+    }
+  }
+}
+
+}  // namespace ur_controllers
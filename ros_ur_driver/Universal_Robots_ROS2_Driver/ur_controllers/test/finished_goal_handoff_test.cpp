@@ -0,0 +1,258 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ur_controllers/finished_goal_handoff.hpp"
+
+namespace
+{
+struct GoalRecord
+{
+  std::atomic<int> finishes{ 0 };
+  std::atomic<bool> has_result{ false };
+};
+
+struct Goal
+{
+  std::shared_ptr<GoalRecord> record;
+};
+
+using GoalPtr = std::shared_ptr<Goal>;
+using Handoff = ur_controllers::FinishedGoalHandoff<GoalPtr, 8>;
+
+// Same semantics as realtime_tools::RealtimeBuffer: the real-time side keeps its previous goal if it can't lock
+class GoalBuffer
+{
+public:
+  GoalPtr readFromRT()
+  {
+    if (mutex_.try_lock()) {
+      if (new_data_available_) {
+        std::swap(realtime_data_, non_realtime_data_);
+        new_data_available_ = false;
+      }
+      mutex_.unlock();
+    }
+    return realtime_data_;
+  }
+
+  GoalPtr readFromNonRT()
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return new_data_available_ ? non_realtime_data_ : realtime_data_;
+  }
+
+  void writeFromNonRT(const GoalPtr& goal)
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    non_realtime_data_ = goal;
+    new_data_available_ = true;
+  }
+
+private:
+  std::mutex mutex_;
+  GoalPtr realtime_data_;
+  GoalPtr non_realtime_data_;
+  bool new_data_available_{ false };
+};
+
+void releaseInto(Handoff& handoff, GoalBuffer& buffer)
+{
+  handoff.release([&buffer](const GoalPtr& goal, const GoalPtr& next_goal) {
+    if (buffer.readFromNonRT() == goal) {
+      buffer.writeFromNonRT(next_goal);
+    }
+  });
+}
+
+GoalPtr makeGoal()
+{
+  return std::make_shared<Goal>(Goal{ std::make_shared<GoalRecord>() });
+}
+}  // namespace
+
+TEST(FinishedGoalHandoffTest, skips_finished_goal_until_another_goal_is_read)
+{
+  Handoff handoff;
+  GoalBuffer buffer;
+  const GoalPtr goal = makeGoal();
+  buffer.writeFromNonRT(goal);
+  ASSERT_EQ(goal, buffer.readFromRT());
+  EXPECT_FALSE(handoff.is_finished(goal));
+
+  ASSERT_TRUE(handoff.finish(goal, GoalPtr()));
+  EXPECT_TRUE(handoff.is_finished(goal));
+  releaseInto(handoff, buffer);
+  EXPECT_EQ(GoalPtr(), buffer.readFromNonRT());
+
+  // A buffer that can't be locked still returns the released goal
+  EXPECT_TRUE(handoff.is_finished(goal));
+  EXPECT_FALSE(handoff.is_finished(buffer.readFromRT()));
+  EXPECT_FALSE(handoff.is_finished(goal));
+}
+
+TEST(FinishedGoalHandoffTest, skips_all_goals_finished_while_buffer_holds_the_first)
+{
+  Handoff handoff;
+  GoalBuffer buffer;
+  const GoalPtr first = makeGoal();
+  const GoalPtr next = makeGoal();
+  buffer.writeFromNonRT(first);
+  ASSERT_EQ(first, buffer.readFromRT());
+
+  // The next goal is started right away and finished, before the first one is released
+  ASSERT_TRUE(handoff.finish(first, next));
+  EXPECT_TRUE(handoff.is_finished(first));
+  ASSERT_TRUE(handoff.finish(next, GoalPtr()));
+  EXPECT_TRUE(handoff.is_finished(first));
+  EXPECT_TRUE(handoff.is_finished(next));
+
+  releaseInto(handoff, buffer);
+  EXPECT_EQ(GoalPtr(), buffer.readFromNonRT());
+  EXPECT_TRUE(handoff.is_finished(first));
+  EXPECT_FALSE(handoff.is_finished(buffer.readFromRT()));
+}
+
+TEST(FinishedGoalHandoffTest, keeps_new_goal_accepted_before_release)
+{
+  Handoff handoff;
+  GoalBuffer buffer;
+  const GoalPtr finished = makeGoal();
+  const GoalPtr accepted = makeGoal();
+  buffer.writeFromNonRT(finished);
+  ASSERT_EQ(finished, buffer.readFromRT());
+  ASSERT_TRUE(handoff.finish(finished, GoalPtr()));
+
+  buffer.writeFromNonRT(accepted);
+  releaseInto(handoff, buffer);
+  const GoalPtr read = buffer.readFromRT();
+  EXPECT_EQ(accepted, read);
+  EXPECT_FALSE(handoff.is_finished(read));
+}
+
+TEST(FinishedGoalHandoffTest, rejects_goals_when_full)
+{
+  Handoff handoff;
+  GoalBuffer buffer;
+  std::vector<GoalPtr> goals;
+  for (size_t i = 0; i < 8; ++i) {
+    goals.push_back(makeGoal());
+    EXPECT_TRUE(handoff.finish(goals.back(), GoalPtr()));
+  }
+  const GoalPtr rejected = makeGoal();
+  EXPECT_FALSE(handoff.finish(rejected, GoalPtr()));
+  EXPECT_FALSE(handoff.is_finished(rejected));
+
+  releaseInto(handoff, buffer);
+  EXPECT_FALSE(handoff.is_finished(buffer.readFromRT()));
+  EXPECT_TRUE(handoff.finish(rejected, GoalPtr()));
+}
+
+TEST(FinishedGoalHandoffTest, finishes_each_goal_once_under_rapid_replacement)
+{
+  constexpr size_t GOAL_COUNT = 100000;
+  Handoff handoff;
+  GoalBuffer buffer;
+  std::vector<std::shared_ptr<GoalRecord>> records;
+  records.reserve(GOAL_COUNT);
+  std::atomic<bool> stop{ false };
+  std::atomic<size_t> wrongly_skipped{ 0 };
+  std::atomic<size_t> rejected{ 0 };
+
+  // Stands in for update(), finishes every goal it reads right away
+  std::thread realtime([&]() {
+    while (!stop.load()) {
+      const GoalPtr goal = buffer.readFromRT();
+      if (handoff.is_finished(goal)) {
+        wrongly_skipped += goal->record->finishes.load() == 0;
+        std::this_thread::yield();
+        continue;
+      }
+      if (!goal) {
+        std::this_thread::yield();
+        continue;
+      }
+      ++goal->record->finishes;
+      goal->record->has_result.exchange(true);
+      if (!handoff.finish(goal, GoalPtr())) {
+        ++rejected;
+        buffer.writeFromNonRT(GoalPtr());
+      }
+    }
+  });
+
+  // Stands in for the goal callbacks and the release timer. Goals are replaced one to three at a time, a replaced goal
+  // gets its result from the preemption unless it was finished before. Goals are freed once released, so new goals
+  // reuse their addresses.
+  for (size_t i = 0; i < GOAL_COUNT;) {
+    for (size_t batch = i % 3 + 1; batch > 0 && i < GOAL_COUNT; --batch, ++i) {
+      const GoalPtr previous = buffer.readFromNonRT();
+      if (previous) {
+        previous->record->has_result.exchange(true);
+      }
+      const GoalPtr goal = makeGoal();
+      records.push_back(goal->record);
+      buffer.writeFromNonRT(goal);
+      if (i % 2 == 0) {
+        std::this_thread::yield();
+      }
+    }
+    releaseInto(handoff, buffer);
+    std::this_thread::yield();
+  }
+  while (!records.back()->has_result.load()) {
+    releaseInto(handoff, buffer);
+    std::this_thread::yield();
+  }
+  stop = true;
+  realtime.join();
+  releaseInto(handoff, buffer);
+
+  EXPECT_EQ(0u, rejected.load());
+  EXPECT_EQ(0u, wrongly_skipped.load());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_LE(records[i]->finishes.load(), 1) << "goal " << i;
+    EXPECT_TRUE(records[i]->has_result.load()) << "goal " << i;
+  }
+}
@@ -0,0 +1,110 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "ur_controllers/spsc_queue.hpp"
+
+using ur_controllers::SPSCQueue;
+
+TEST(SPSCQueueTest, keeps_order_up_to_capacity)
+{
+  SPSCQueue<int, 4> queue;
+  int value = 0;
+  EXPECT_FALSE(queue.pop(value));
+
+  // Wrap around the buffer a few times
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_TRUE(queue.push(round * 4 + i));
+    }
+    EXPECT_FALSE(queue.push(-1));
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(queue.pop(value));
+      EXPECT_EQ(round * 4 + i, value);
+    }
+    EXPECT_FALSE(queue.pop(value));
+  }
+}
+
+TEST(SPSCQueueTest, releases_popped_elements)
+{
+  SPSCQueue<std::shared_ptr<int>, 2> queue;
+  auto element = std::make_shared<int>(1);
+  ASSERT_TRUE(queue.push(element));
+  EXPECT_EQ(2, element.use_count());
+
+  std::shared_ptr<int> popped;
+  ASSERT_TRUE(queue.pop(popped));
+  popped.reset();
+  EXPECT_EQ(1, element.use_count());
+}
+
+TEST(SPSCQueueTest, hands_over_all_elements_between_threads)
+{
+  constexpr uint64_t COUNT = 1000000;
+  SPSCQueue<uint64_t, 8> queue;
+
+  std::thread producer([&queue]() {
+    for (uint64_t i = 1; i <= COUNT;) {
+      if (queue.push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // Every element has to arrive exactly once and in order, the producer has to be drained even on a mismatch
+  uint64_t expected = 1;
+  uint64_t mismatches = 0;
+  uint64_t value = 0;
+  while (expected <= COUNT) {
+    if (queue.pop(value)) {
+      mismatches += value != expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_EQ(0u, mismatches);
+  EXPECT_FALSE(queue.pop(value));
+}
@@ -0,0 +1,140 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "angles/angles.h"
+#include "joint_trajectory_controller/tolerances.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+#include "ur_controllers/tolerance_evaluator.hpp"
+
+using joint_trajectory_controller::SegmentTolerances;
+using joint_trajectory_controller::StateTolerances;
+using trajectory_msgs::msg::JointTrajectoryPoint;
+using ur_controllers::ToleranceEvaluator;
+
+namespace
+{
+constexpr size_t DOF = 6;
+constexpr size_t CYCLES = 1000000;
+
+JointTrajectoryPoint randomState(std::mt19937& gen)
+{
+  std::uniform_real_distribution<double> value(-0.01, 0.01);
+  JointTrajectoryPoint point;
+  for (size_t i = 0; i < DOF; ++i) {
+    point.positions.push_back(value(gen));
+    point.velocities.push_back(value(gen));
+    point.accelerations.push_back(value(gen));
+  }
+  return point;
+}
+
+// Checks a set of states once per control cycle, returns the time per cycle in nanoseconds
+template <typename Evaluate>
+double nanosecondsPerCycle(Evaluate&& evaluate)
+{
+  std::mt19937 gen(42);
+  std::vector<JointTrajectoryPoint> current;
+  std::vector<JointTrajectoryPoint> desired;
+  for (size_t i = 0; i < 64; ++i) {
+    current.push_back(randomState(gen));
+    desired.push_back(randomState(gen));
+  }
+  JointTrajectoryPoint error = current.front();
+
+  size_t violations = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < CYCLES; ++i) {
+    violations += evaluate(current[i % current.size()], desired[i % desired.size()], error);
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+  // Keeps the loop from being optimized away
+  if (violations == CYCLES + 1) {
+    std::cout << violations << std::endl;
+  }
+  return std::chrono::duration<double, std::nano>(duration).count() / CYCLES;
+}
+}  // namespace
+
+// The state and goal tolerance checks done in every cycle of the controller's update(), once for joints with limits
+// and once for joints wrapping around
+TEST(ToleranceEvaluatorBenchmark, cost_per_cycle)
+{
+  SegmentTolerances tolerances;
+  tolerances.state_tolerance.assign(DOF, StateTolerances{ 0.05, 0.05, 0.0 });
+  tolerances.goal_state_tolerance.assign(DOF, StateTolerances{ 0.01, 0.0, 0.0 });
+
+  for (const bool wraps : { false, true }) {
+    const std::vector<bool> wraparound(DOF, wraps);
+    const double per_joint_ns = nanosecondsPerCycle(
+        [&](const JointTrajectoryPoint& current, const JointTrajectoryPoint& desired, JointTrajectoryPoint& error) {
+          // Same as the joint_trajectory_controller's update(), the number of joints is only known at runtime there
+          bool violated = false;
+          for (size_t index = 0; index < wraparound.size(); ++index) {
+            if (wraparound[index]) {
+              error.positions[index] =
+                  angles::shortest_angular_distance(current.positions[index], desired.positions[index]);
+            } else {
+              error.positions[index] = desired.positions[index] - current.positions[index];
+            }
+            error.velocities[index] = desired.velocities[index] - current.velocities[index];
+            error.accelerations[index] = desired.accelerations[index] - current.accelerations[index];
+            violated |= !joint_trajectory_controller::check_state_tolerance_per_joint(
+                error, index, tolerances.state_tolerance[index]);
+            violated |= !joint_trajectory_controller::check_state_tolerance_per_joint(
+                error, index, tolerances.goal_state_tolerance[index]);
+          }
+          return violated;
+        });
+
+    ToleranceEvaluator evaluator;
+    evaluator.configure(wraparound, true, true);
+    const double evaluator_ns = nanosecondsPerCycle(
+        [&](const JointTrajectoryPoint& current, const JointTrajectoryPoint& desired, JointTrajectoryPoint& error) {
+          const auto check = evaluator.evaluate(current, desired, tolerances, true, true, error);
+          return check.state_violated || check.goal_violated;
+        });
+
+    std::cout << (wraps ? "Wrapping" : "Limited") << " joints: check_state_tolerance_per_joint() " << per_joint_ns
+              << " ns, ToleranceEvaluator " << evaluator_ns << " ns per cycle" << std::endl;
+  }
+}
@@ -0,0 +1,248 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "angles/angles.h"
+#include "joint_trajectory_controller/tolerances.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+#include "ur_controllers/tolerance_evaluator.hpp"
+
+using joint_trajectory_controller::SegmentTolerances;
+using joint_trajectory_controller::StateTolerances;
+using trajectory_msgs::msg::JointTrajectoryPoint;
+using ur_controllers::ToleranceCheck;
+using ur_controllers::ToleranceEvaluator;
+
+namespace
+{
+constexpr size_t DOF = 6;
+constexpr double UNSET = 1234.5;
+
+struct Comparison
+{
+  bool velocities;
+  bool accelerations;
+};
+
+class RandomStates
+{
+public:
+  JointTrajectoryPoint state()
+  {
+    JointTrajectoryPoint point;
+    for (size_t i = 0; i < DOF; ++i) {
+      point.positions.push_back(angle_(gen_));
+      point.velocities.push_back(value_(gen_));
+      point.accelerations.push_back(value_(gen_));
+    }
+    return point;
+  }
+
+  // Some tolerances are 0, which disables their check
+  std::vector<StateTolerances> tolerances()
+  {
+    std::vector<StateTolerances> tolerances(DOF);
+    for (auto& tolerance : tolerances) {
+      tolerance.position = toleranceValue();
+      tolerance.velocity = toleranceValue();
+      tolerance.acceleration = toleranceValue();
+    }
+    return tolerances;
+  }
+
+  std::vector<bool> wraparound()
+  {
+    std::vector<bool> wraparound;
+    for (size_t i = 0; i < DOF; ++i) {
+      wraparound.push_back(value_(gen_) > 0.0);
+    }
+    return wraparound;
+  }
+
+private:
+  double toleranceValue()
+  {
+    return tolerance_enabled_(gen_) ? tolerance_(gen_) : 0.0;
+  }
+
+  std::mt19937 gen_{ 42 };
+  std::uniform_real_distribution<double> angle_{ -2.0 * M_PI, 2.0 * M_PI };
+  std::uniform_real_distribution<double> value_{ -1.0, 1.0 };
+  std::uniform_real_distribution<double> tolerance_{ 0.0, 2.0 };
+  std::bernoulli_distribution tolerance_enabled_{ 0.75 };
+};
+
+// The joint_trajectory_controller's per joint error computation followed by check_state_tolerance_per_joint()
+bool referenceViolates(const JointTrajectoryPoint& current, const JointTrajectoryPoint& desired,
+                       const std::vector<bool>& wraparound, const Comparison& comparison,
+                       const std::vector<StateTolerances>& tolerances, JointTrajectoryPoint& error)
+{
+  bool violated = false;
+  for (size_t index = 0; index < DOF; ++index) {
+    if (wraparound[index]) {
+      error.positions[index] = angles::shortest_angular_distance(current.positions[index], desired.positions[index]);
+    } else {
+      error.positions[index] = desired.positions[index] - current.positions[index];
+    }
+    if (comparison.velocities) {
+      error.velocities[index] = desired.velocities[index] - current.velocities[index];
+    }
+    if (comparison.accelerations) {
+      error.accelerations[index] = desired.accelerations[index] - current.accelerations[index];
+    }
+    violated |= !joint_trajectory_controller::check_state_tolerance_per_joint(error, index, tolerances[index]);
+  }
+  return violated;
+}
+
+JointTrajectoryPoint errorSizedFor(const Comparison& comparison)
+{
+  JointTrajectoryPoint error;
+  error.positions.assign(DOF, UNSET);
+  if (comparison.velocities) {
+    error.velocities.assign(DOF, UNSET);
+  }
+  if (comparison.accelerations) {
+    error.accelerations.assign(DOF, UNSET);
+  }
+  return error;
+}
+
+void expectSameError(const JointTrajectoryPoint& expected, const JointTrajectoryPoint& actual)
+{
+  ASSERT_EQ(expected.positions.size(), actual.positions.size());
+  ASSERT_EQ(expected.velocities.size(), actual.velocities.size());
+  ASSERT_EQ(expected.accelerations.size(), actual.accelerations.size());
+  for (size_t i = 0; i < expected.positions.size(); ++i) {
+    EXPECT_DOUBLE_EQ(expected.positions[i], actual.positions[i]);
+  }
+  for (size_t i = 0; i < expected.velocities.size(); ++i) {
+    EXPECT_DOUBLE_EQ(expected.velocities[i], actual.velocities[i]);
+  }
+  for (size_t i = 0; i < expected.accelerations.size(); ++i) {
+    EXPECT_DOUBLE_EQ(expected.accelerations[i], actual.accelerations[i]);
+  }
+}
+}  // namespace
+
+TEST(ToleranceEvaluatorTest, matches_check_state_tolerance_per_joint)
+{
+  RandomStates random;
+  size_t state_violations = 0;
+  size_t goal_violations = 0;
+  for (const Comparison comparison : { Comparison{ false, false }, Comparison{ true, false },
+                                       Comparison{ false, true }, Comparison{ true, true } }) {
+    for (size_t i = 0; i < 2000; ++i) {
+      const std::vector<bool> wraparound = random.wraparound();
+      ToleranceEvaluator evaluator;
+      evaluator.configure(wraparound, comparison.velocities, comparison.accelerations);
+
+      SegmentTolerances tolerances;
+      tolerances.state_tolerance = random.tolerances();
+      tolerances.goal_state_tolerance = random.tolerances();
+      const JointTrajectoryPoint current = random.state();
+      const JointTrajectoryPoint desired = random.state();
+
+      JointTrajectoryPoint expected_error = errorSizedFor(comparison);
+      const bool state_violated =
+          referenceViolates(current, desired, wraparound, comparison, tolerances.state_tolerance, expected_error);
+      const bool goal_violated =
+          referenceViolates(current, desired, wraparound, comparison, tolerances.goal_state_tolerance, expected_error);
+      state_violations += state_violated;
+      goal_violations += goal_violated;
+
+      JointTrajectoryPoint error = errorSizedFor(comparison);
+      const ToleranceCheck check = evaluator.evaluate(current, desired, tolerances, true, true, error);
+      EXPECT_EQ(state_violated, check.state_violated);
+      EXPECT_EQ(goal_violated, check.goal_violated);
+      expectSameError(expected_error, error);
+    }
+  }
+  // Both outcomes have to be covered for the comparison to mean anything
+  EXPECT_GT(state_violations, 0u);
+  EXPECT_LT(state_violations, 8000u);
+  EXPECT_GT(goal_violations, 0u);
+  EXPECT_LT(goal_violations, 8000u);
+}
+
+TEST(ToleranceEvaluatorTest, only_checks_requested_tolerances)
+{
+  ToleranceEvaluator evaluator;
+  evaluator.configure(std::vector<bool>(DOF, false), true, true);
+  SegmentTolerances tolerances;
+  tolerances.state_tolerance.assign(DOF, StateTolerances{ 0.1, 0.1, 0.1 });
+  tolerances.goal_state_tolerance.assign(DOF, StateTolerances{ 0.1, 0.1, 0.1 });
+
+  JointTrajectoryPoint current = errorSizedFor({ true, true });
+  JointTrajectoryPoint desired = current;
+  desired.positions[3] += 1.0;
+  JointTrajectoryPoint error = errorSizedFor({ true, true });
+
+  ToleranceCheck check = evaluator.evaluate(current, desired, tolerances, false, false, error);
+  EXPECT_FALSE(check.state_violated);
+  EXPECT_FALSE(check.goal_violated);
+  // The error is computed regardless
+  EXPECT_DOUBLE_EQ(1.0, error.positions[3]);
+
+  check = evaluator.evaluate(current, desired, tolerances, true, false, error);
+  EXPECT_TRUE(check.state_violated);
+  EXPECT_FALSE(check.goal_violated);
+
+  check = evaluator.evaluate(current, desired, tolerances, false, true, error);
+  EXPECT_FALSE(check.state_violated);
+  EXPECT_TRUE(check.goal_violated);
+}
+
+TEST(ToleranceEvaluatorTest, keeps_errors_that_are_not_compared)
+{
+  RandomStates random;
+  ToleranceEvaluator evaluator;
+  evaluator.configure(std::vector<bool>(DOF, false), false, false);
+  SegmentTolerances tolerances;
+  tolerances.state_tolerance.assign(DOF, StateTolerances{ 0.0, 0.1, 0.1 });
+  tolerances.goal_state_tolerance = tolerances.state_tolerance;
+
+  JointTrajectoryPoint error = errorSizedFor({ true, true });
+  evaluator.evaluate(random.state(), random.state(), tolerances, true, true, error);
+  for (size_t i = 0; i < DOF; ++i) {
+    EXPECT_EQ(UNSET, error.velocities[i]);
+    EXPECT_EQ(UNSET, error.accelerations[i]);
+  }
+}
@@ -0,0 +1,309 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "joint_trajectory_controller/tolerances.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+#include "ur_controllers/trajectory_queue.hpp"
+
+using trajectory_msgs::msg::JointTrajectory;
+using trajectory_msgs::msg::JointTrajectoryPoint;
+
+namespace
+{
+constexpr double APPEND_TOLERANCE = 0.01;
+constexpr size_t DEPTH = 3;
+
+// Stands in for rclcpp_action::ServerGoalHandle
+struct FakeServerGoalHandle
+{
+  bool is_active() const
+  {
+    return active;
+  }
+
+  bool active{ true };
+};
+
+// Stands in for realtime_tools::RealtimeServerGoalHandle
+struct FakeGoal
+{
+  void execute()
+  {
+    executing = true;
+  }
+
+  void runNonRealtime()
+  {
+    ++non_realtime_runs;
+  }
+
+  std::shared_ptr<FakeServerGoalHandle> gh_ = std::make_shared<FakeServerGoalHandle>();
+  bool executing{ false };
+  int non_realtime_runs{ 0 };
+};
+
+using GoalPtr = std::shared_ptr<FakeGoal>;
+using Queue = ur_controllers::TrajectoryQueue<GoalPtr, 8>;
+
+// Trajectory of two joints moving from one position to another
+Queue::QueuedGoal goalMoving(double from, double to, const std::vector<std::string>& joints = { "a", "b" })
+{
+  auto trajectory = std::make_shared<JointTrajectory>();
+  trajectory->joint_names = joints;
+  for (const double position : { from, to }) {
+    JointTrajectoryPoint point;
+    point.positions.assign(joints.size(), position);
+    trajectory->points.push_back(point);
+  }
+  return Queue::QueuedGoal{ std::make_shared<FakeGoal>(), trajectory,
+                            std::make_shared<joint_trajectory_controller::SegmentTolerances>(),
+                            std::make_shared<std::atomic<bool>>(false) };
+}
+
+// Records the goals passed to the queue's cancel and abort functions
+struct Results
+{
+  std::vector<GoalPtr> canceled;
+  std::vector<GoalPtr> aborted;
+
+  auto cancel()
+  {
+    return [this](const GoalPtr& goal) { canceled.push_back(goal); };
+  }
+
+  auto abort()
+  {
+    return [this](const GoalPtr& goal) { aborted.push_back(goal); };
+  }
+};
+}  // namespace
+
+TEST(TrajectoryQueueTest, appends_goals_continuing_the_last_accepted_one)
+{
+  Queue queue;
+  Results results;
+  const auto first = goalMoving(0.0, 1.0);
+  const auto second = goalMoving(1.0, 2.0);
+  const auto third = goalMoving(2.005, 3.0);
+
+  // The first goal has nothing to continue, so it is started like any other goal
+  EXPECT_FALSE(queue.accept(first, false, APPEND_TOLERANCE, DEPTH));
+  EXPECT_TRUE(queue.accept(second, true, APPEND_TOLERANCE, DEPTH));
+  EXPECT_TRUE(queue.accept(third, true, APPEND_TOLERANCE, DEPTH));
+  EXPECT_EQ(2u, queue.size());
+  EXPECT_FALSE(first.goal->executing);
+  EXPECT_TRUE(second.goal->executing);
+  EXPECT_TRUE(third.goal->executing);
+
+  Queue::QueuedGoal next;
+  ASSERT_TRUE(queue.start_next(results.cancel(), next));
+  EXPECT_EQ(second.goal, next.goal);
+  EXPECT_EQ(second.tolerances, next.tolerances);
+  EXPECT_EQ(second.goal, queue.handed_over().goal);
+  queue.clear_handed_over();
+
+  ASSERT_TRUE(queue.start_next(results.cancel(), next));
+  EXPECT_EQ(third.goal, next.goal);
+  EXPECT_FALSE(queue.start_next(results.cancel(), next));
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_TRUE(results.canceled.empty());
+}
+
+TEST(TrajectoryQueueTest, doesnt_append_goals_that_dont_continue)
+{
+  Queue queue;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+
+  // Starts too far from the last point, for different joints, or after the last goal finished
+  EXPECT_FALSE(queue.accept(goalMoving(1.1, 2.0), true, APPEND_TOLERANCE, DEPTH));
+  EXPECT_FALSE(queue.accept(goalMoving(2.0, 3.0, { "a", "c" }), true, APPEND_TOLERANCE, DEPTH));
+  EXPECT_FALSE(queue.accept(goalMoving(3.0, 4.0, { "a", "b" }), false, APPEND_TOLERANCE, DEPTH));
+  // Disabled queue
+  EXPECT_FALSE(queue.accept(goalMoving(4.0, 5.0), true, APPEND_TOLERANCE, 0));
+  EXPECT_EQ(0u, queue.size());
+}
+
+TEST(TrajectoryQueueTest, is_full_only_for_goals_that_would_be_appended)
+{
+  Queue queue;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, 1));
+  EXPECT_FALSE(queue.is_full_for(*goalMoving(1.0, 2.0).trajectory, true, APPEND_TOLERANCE, 1));
+  ASSERT_TRUE(queue.accept(goalMoving(1.0, 2.0), true, APPEND_TOLERANCE, 1));
+
+  EXPECT_TRUE(queue.is_full_for(*goalMoving(2.0, 3.0).trajectory, true, APPEND_TOLERANCE, 1));
+  EXPECT_FALSE(queue.is_full_for(*goalMoving(5.0, 6.0).trajectory, true, APPEND_TOLERANCE, 1));
+  EXPECT_FALSE(queue.is_full_for(*goalMoving(2.0, 3.0).trajectory, true, APPEND_TOLERANCE, 0));
+}
+
+TEST(TrajectoryQueueTest, replacing_goal_flushes_the_queue)
+{
+  Queue queue;
+  Results results;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+  const auto second = goalMoving(1.0, 2.0);
+  const auto third = goalMoving(2.0, 3.0);
+  ASSERT_TRUE(queue.accept(second, true, APPEND_TOLERANCE, DEPTH));
+  ASSERT_TRUE(queue.accept(third, true, APPEND_TOLERANCE, DEPTH));
+
+  const auto replacing = goalMoving(5.0, 6.0);
+  EXPECT_FALSE(queue.accept(replacing, true, APPEND_TOLERANCE, DEPTH));
+  // Nothing may be appended to the replacing goal until the old queue was flushed by the real-time loop
+  EXPECT_FALSE(queue.accept(goalMoving(6.0, 7.0), true, APPEND_TOLERANCE, DEPTH));
+
+  ASSERT_TRUE(queue.take_flush_request());
+  EXPECT_FALSE(queue.take_flush_request());
+  queue.abort_all(results.abort());
+  EXPECT_EQ((std::vector<GoalPtr>{ second.goal, third.goal }), results.aborted);
+  EXPECT_EQ(0u, queue.size());
+
+  EXPECT_TRUE(queue.accept(goalMoving(7.0, 8.0), true, APPEND_TOLERANCE, DEPTH));
+}
+
+TEST(TrajectoryQueueTest, skips_canceled_goals)
+{
+  Queue queue;
+  Results results;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+  const auto second = goalMoving(1.0, 2.0);
+  const auto third = goalMoving(2.0, 3.0);
+  ASSERT_TRUE(queue.accept(second, true, APPEND_TOLERANCE, DEPTH));
+  ASSERT_TRUE(queue.accept(third, true, APPEND_TOLERANCE, DEPTH));
+
+  queue.cancel(second.goal->gh_);
+  EXPECT_TRUE(second.canceled->load());
+  EXPECT_FALSE(third.canceled->load());
+
+  Queue::QueuedGoal next;
+  ASSERT_TRUE(queue.start_next(results.cancel(), next));
+  EXPECT_EQ(third.goal, next.goal);
+  EXPECT_EQ(std::vector<GoalPtr>{ second.goal }, results.canceled);
+}
+
+TEST(TrajectoryQueueTest, aborts_queued_goals_when_the_active_goal_is_canceled)
+{
+  Queue queue;
+  Results results;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+  std::vector<GoalPtr> goals;
+  for (int i = 1; i <= 3; ++i) {
+    const auto queued = goalMoving(i, i + 1);
+    ASSERT_TRUE(queue.accept(queued, true, APPEND_TOLERANCE, DEPTH));
+    goals.push_back(queued.goal);
+  }
+
+  // Canceled in the middle of the queue, while the first queued goal is executed
+  Queue::QueuedGoal next;
+  ASSERT_TRUE(queue.start_next(results.cancel(), next));
+  queue.clear_handed_over();
+  queue.cancel(next.goal->gh_);
+  queue.cancel_queued_behind_active();
+  // Nothing may be appended to the canceled trajectory meanwhile
+  EXPECT_FALSE(queue.accept(goalMoving(4.0, 5.0), true, APPEND_TOLERANCE, DEPTH));
+
+  ASSERT_TRUE(queue.take_cancel_flush_request());
+  EXPECT_FALSE(queue.take_cancel_flush_request());
+  queue.abort_queued(results.abort());
+  EXPECT_EQ((std::vector<GoalPtr>{ goals[1], goals[2] }), results.aborted);
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_FALSE(queue.start_next(results.cancel(), next));
+  EXPECT_TRUE(results.canceled.empty());
+}
+
+TEST(TrajectoryQueueTest, keeps_the_handed_over_goal_when_aborting_only_queued_goals)
+{
+  Queue queue;
+  Results results;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+  const auto second = goalMoving(1.0, 2.0);
+  const auto third = goalMoving(2.0, 3.0);
+  ASSERT_TRUE(queue.accept(second, true, APPEND_TOLERANCE, DEPTH));
+  ASSERT_TRUE(queue.accept(third, true, APPEND_TOLERANCE, DEPTH));
+
+  Queue::QueuedGoal next;
+  ASSERT_TRUE(queue.start_next(results.cancel(), next));
+  queue.abort_queued(results.abort());
+  EXPECT_EQ(std::vector<GoalPtr>{ third.goal }, results.aborted);
+  EXPECT_EQ(second.goal, queue.handed_over().goal);
+}
+
+TEST(TrajectoryQueueTest, aborts_handed_over_and_queued_goals_in_order)
+{
+  Queue queue;
+  Results results;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+  std::vector<GoalPtr> goals;
+  for (int i = 1; i <= 3; ++i) {
+    const auto queued = goalMoving(i, i + 1);
+    ASSERT_TRUE(queue.accept(queued, true, APPEND_TOLERANCE, DEPTH));
+    goals.push_back(queued.goal);
+  }
+
+  // The first queued goal was started, but didn't arrive in the goal buffer yet
+  Queue::QueuedGoal next;
+  ASSERT_TRUE(queue.start_next(results.cancel(), next));
+  queue.abort_all(results.abort());
+
+  EXPECT_EQ(goals, results.aborted);
+  EXPECT_FALSE(queue.handed_over().goal);
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_FALSE(queue.start_next(results.cancel(), next));
+}
+
+TEST(TrajectoryQueueTest, forgets_finished_goals)
+{
+  Queue queue;
+  ASSERT_FALSE(queue.accept(goalMoving(0.0, 1.0), false, APPEND_TOLERANCE, DEPTH));
+  const auto second = goalMoving(1.0, 2.0);
+  ASSERT_TRUE(queue.accept(second, true, APPEND_TOLERANCE, DEPTH));
+
+  queue.run_non_realtime();
+  EXPECT_EQ(1, second.goal->non_realtime_runs);
+
+  // Once the queued goal finished, nothing is executed that a new goal could be appended to
+  second.goal->gh_->active = false;
+  queue.run_non_realtime();
+  queue.run_non_realtime();
+  EXPECT_EQ(2, second.goal->non_realtime_runs);
+  EXPECT_FALSE(queue.accept(goalMoving(2.0, 3.0), false, APPEND_TOLERANCE, DEPTH));
+}
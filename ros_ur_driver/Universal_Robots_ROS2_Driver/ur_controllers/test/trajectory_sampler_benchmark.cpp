@@ -0,0 +1,139 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "joint_trajectory_controller/trajectory.hpp"
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+#include "ur_controllers/trajectory_sampler.hpp"
+
+using joint_trajectory_controller::Trajectory;
+using joint_trajectory_controller::TrajectoryPointConstIter;
+using joint_trajectory_controller::interpolation_methods::InterpolationMethod;
+using trajectory_msgs::msg::JointTrajectory;
+using trajectory_msgs::msg::JointTrajectoryPoint;
+using ur_controllers::TrajectorySampler;
+
+namespace
+{
+constexpr size_t DOF = 6;
+constexpr size_t CYCLES = 20000;
+const rclcpp::Time START_TIME(10, 0);
+const std::vector<bool> NO_WRAPAROUND(DOF, false);
+
+// Points every 50 ms with positions, velocities and accelerations, like trajectories from MoveIt
+std::shared_ptr<JointTrajectory> trajectoryOfLength(size_t point_count)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  auto trajectory = std::make_shared<JointTrajectory>();
+  for (size_t i = 0; i < point_count; ++i) {
+    JointTrajectoryPoint point;
+    point.time_from_start = rclcpp::Duration::from_seconds(0.05 * (i + 1));
+    for (size_t j = 0; j < DOF; ++j) {
+      point.positions.push_back(value(gen));
+      point.velocities.push_back(value(gen));
+      point.accelerations.push_back(value(gen));
+    }
+    trajectory->points.push_back(point);
+  }
+  return trajectory;
+}
+
+// Samples the whole trajectory once per control cycle, returns the time per cycle in microseconds
+template <typename Sample>
+double microsecondsPerCycle(size_t point_count, Sample&& sample)
+{
+  const auto trajectory_msg = trajectoryOfLength(point_count);
+  Trajectory trajectory(trajectory_msg);
+  JointTrajectoryPoint current_state;
+  current_state.positions.assign(DOF, 0.0);
+  trajectory.set_point_before_trajectory_msg(START_TIME, current_state, NO_WRAPAROUND);
+
+  const rclcpp::Duration step = rclcpp::Duration(trajectory_msg->points.back().time_from_start) * (1.0 / CYCLES);
+  JointTrajectoryPoint state;
+  TrajectoryPointConstIter start_segment_itr, end_segment_itr;
+  double checksum = 0.0;
+  rclcpp::Time time = START_TIME;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < CYCLES; ++i) {
+    sample(trajectory, time, state, start_segment_itr, end_segment_itr);
+    checksum += state.positions[0];
+    time += step;
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+  // Keeps the loop from being optimized away
+  if (checksum == 0.0) {
+    std::cout << checksum << std::endl;
+  }
+  return std::chrono::duration<double, std::micro>(duration).count() / CYCLES;
+}
+}  // namespace
+
+// The sampling is the part of the controller's update() whose cost depends on the trajectory's length
+TEST(TrajectorySamplerBenchmark, cost_per_cycle_over_trajectory_length)
+{
+  for (size_t point_count : { 10, 100, 1000, 10000 }) {
+    const double trajectory_us =
+        microsecondsPerCycle(point_count, [](Trajectory& trajectory, const rclcpp::Time& time,
+                                             JointTrajectoryPoint& state, TrajectoryPointConstIter& start_segment_itr,
+                                             TrajectoryPointConstIter& end_segment_itr) {
+          trajectory.sample(time, InterpolationMethod::VARIABLE_DEGREE_SPLINE, state, start_segment_itr,
+                            end_segment_itr);
+        });
+    TrajectorySampler sampler;
+    sampler.reserve(DOF);
+    const double sampler_us =
+        microsecondsPerCycle(point_count, [&sampler](Trajectory& trajectory, const rclcpp::Time& time,
+                                                     JointTrajectoryPoint& state,
+                                                     TrajectoryPointConstIter& start_segment_itr,
+                                                     TrajectoryPointConstIter& end_segment_itr) {
+          sampler.sample(trajectory, time, InterpolationMethod::VARIABLE_DEGREE_SPLINE, state, start_segment_itr,
+                         end_segment_itr);
+        });
+    std::cout << point_count << " points: Trajectory::sample() " << trajectory_us << " us, TrajectorySampler "
+              << sampler_us << " us per cycle" << std::endl;
+  }
+}
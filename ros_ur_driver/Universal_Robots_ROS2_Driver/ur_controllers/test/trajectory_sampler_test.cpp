@@ -0,0 +1,264 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "joint_trajectory_controller/trajectory.hpp"
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
+#include "trajectory_msgs/msg/joint_trajectory.hpp"
+#include "trajectory_msgs/msg/joint_trajectory_point.hpp"
+#include "ur_controllers/trajectory_sampler.hpp"
+
+using joint_trajectory_controller::Trajectory;
+using joint_trajectory_controller::TrajectoryPointConstIter;
+using joint_trajectory_controller::interpolation_methods::InterpolationMethod;
+using trajectory_msgs::msg::JointTrajectory;
+using trajectory_msgs::msg::JointTrajectoryPoint;
+using ur_controllers::TrajectorySampler;
+
+namespace
+{
+constexpr size_t DOF = 6;
+const rclcpp::Time START_TIME(10, 0);
+const std::vector<bool> NO_WRAPAROUND(DOF, false);
+
+struct Derivatives
+{
+  bool velocities;
+  bool accelerations;
+};
+
+// Random points at random intervals, each point i has the derivatives given by derivatives[i % derivatives.size()]
+JointTrajectory randomTrajectory(size_t point_count, const std::vector<Derivatives>& derivatives,
+                                 unsigned int seed = 42)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> value(-1.0, 1.0);
+  std::uniform_real_distribution<double> interval(0.01, 0.5);
+
+  JointTrajectory trajectory;
+  double time_from_start = 0.0;
+  for (size_t i = 0; i < point_count; ++i) {
+    time_from_start += interval(gen);
+    JointTrajectoryPoint point;
+    point.time_from_start = rclcpp::Duration::from_seconds(time_from_start);
+    for (size_t j = 0; j < DOF; ++j) {
+      point.positions.push_back(value(gen));
+      if (derivatives[i % derivatives.size()].velocities) {
+        point.velocities.push_back(value(gen));
+      }
+      if (derivatives[i % derivatives.size()].accelerations) {
+        point.accelerations.push_back(value(gen));
+      }
+    }
+    trajectory.points.push_back(point);
+  }
+  return trajectory;
+}
+
+JointTrajectoryPoint currentState()
+{
+  JointTrajectoryPoint state;
+  state.positions.assign(DOF, 0.1);
+  state.velocities.assign(DOF, 0.0);
+  state.accelerations.assign(DOF, 0.0);
+  return state;
+}
+
+// Control cycles at 500 Hz from the start until one second after the trajectory's last point
+std::vector<rclcpp::Time> controlCycles(const JointTrajectory& trajectory)
+{
+  const rclcpp::Time end = START_TIME + rclcpp::Duration(trajectory.points.back().time_from_start) +
+                           rclcpp::Duration::from_seconds(1.0);
+  std::vector<rclcpp::Time> times;
+  for (rclcpp::Time time = START_TIME; time < end; time += rclcpp::Duration::from_seconds(0.002)) {
+    times.push_back(time);
+  }
+  return times;
+}
+
+void expectNear(const std::vector<double>& expected, const std::vector<double>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-9);
+  }
+}
+
+/*!
+ * \brief Samples a trajectory both with Trajectory::sample() and with the sampler and compares the results.
+ *
+ * Each gets a copy of the trajectory message, as sampling may deduce missing positions of the points.
+ */
+class SampleComparison
+{
+public:
+  explicit SampleComparison(const JointTrajectory& trajectory)
+    : expected_trajectory_(std::make_shared<JointTrajectory>(trajectory))
+    , actual_trajectory_(std::make_shared<JointTrajectory>(trajectory))
+  {
+    expected_trajectory_.set_point_before_trajectory_msg(START_TIME, currentState(), NO_WRAPAROUND);
+    actual_trajectory_.set_point_before_trajectory_msg(START_TIME, currentState(), NO_WRAPAROUND);
+    sampler_.reserve(DOF);
+  }
+
+  void update(const JointTrajectory& trajectory, const rclcpp::Time& time)
+  {
+    expected_trajectory_.update(std::make_shared<JointTrajectory>(trajectory));
+    actual_trajectory_.update(std::make_shared<JointTrajectory>(trajectory));
+    expected_trajectory_.set_point_before_trajectory_msg(time, currentState(), NO_WRAPAROUND);
+    actual_trajectory_.set_point_before_trajectory_msg(time, currentState(), NO_WRAPAROUND);
+  }
+
+  void expectSameSample(const rclcpp::Time& time, InterpolationMethod interpolation_method)
+  {
+    // The output states are reused like in the controller, so no values of a previous sample may be left over
+    TrajectoryPointConstIter expected_start, expected_end, actual_start, actual_end;
+    const bool expected_valid =
+        expected_trajectory_.sample(time, interpolation_method, expected_, expected_start, expected_end);
+    const bool actual_valid =
+        sampler_.sample(actual_trajectory_, time, interpolation_method, actual_, actual_start, actual_end);
+
+    ASSERT_EQ(expected_valid, actual_valid) << "at " << time.seconds();
+    if (!expected_valid) {
+      return;
+    }
+    EXPECT_EQ(expected_start - expected_trajectory_.begin(), actual_start - actual_trajectory_.begin());
+    EXPECT_EQ(expected_end - expected_trajectory_.begin(), actual_end - actual_trajectory_.begin());
+    expectNear(expected_.positions, actual_.positions);
+    expectNear(expected_.velocities, actual_.velocities);
+    expectNear(expected_.accelerations, actual_.accelerations);
+  }
+
+private:
+  Trajectory expected_trajectory_;
+  Trajectory actual_trajectory_;
+  TrajectorySampler sampler_;
+  JointTrajectoryPoint expected_;
+  JointTrajectoryPoint actual_;
+};
+}  // namespace
+
+TEST(TrajectorySamplerTest, matches_trajectory_for_all_segment_types)
+{
+  // The mixed cases change between segment types, which must not leave values of the previous segment behind
+  const std::vector<std::vector<Derivatives>> cases = {
+    { { false, false } },                                  // linear
+    { { true, false } },                                   // cubic
+    { { true, true } },                                    // quintic
+    { { true, true }, { true, true }, { false, false } },  // quintic and linear
+    { { true, false }, { true, true }, { true, true } },   // cubic and quintic
+  };
+  for (const auto& derivatives : cases) {
+    const JointTrajectory trajectory = randomTrajectory(50, derivatives);
+    SampleComparison comparison(trajectory);
+    for (const auto& time : controlCycles(trajectory)) {
+      comparison.expectSameSample(time, InterpolationMethod::VARIABLE_DEGREE_SPLINE);
+    }
+  }
+}
+
+TEST(TrajectorySamplerTest, matches_trajectory_without_interpolation)
+{
+  const JointTrajectory trajectory = randomTrajectory(50, { { true, false } });
+  SampleComparison comparison(trajectory);
+  for (const auto& time : controlCycles(trajectory)) {
+    comparison.expectSameSample(time, InterpolationMethod::NONE);
+  }
+}
+
+TEST(TrajectorySamplerTest, matches_trajectory_when_time_goes_back)
+{
+  const JointTrajectory trajectory = randomTrajectory(50, { { true, true } });
+  const std::vector<rclcpp::Time> cycles = controlCycles(trajectory);
+  SampleComparison comparison(trajectory);
+
+  // Forwards through the first half, then back to the first quarter and forwards to the end
+  for (size_t i = 0; i < cycles.size() / 2; ++i) {
+    comparison.expectSameSample(cycles[i], InterpolationMethod::VARIABLE_DEGREE_SPLINE);
+  }
+  for (size_t i = cycles.size() / 4; i < cycles.size(); ++i) {
+    comparison.expectSameSample(cycles[i], InterpolationMethod::VARIABLE_DEGREE_SPLINE);
+  }
+}
+
+TEST(TrajectorySamplerTest, matches_trajectory_after_new_message)
+{
+  const JointTrajectory first = randomTrajectory(50, { { true, false } }, 1);
+  const JointTrajectory second = randomTrajectory(20, { { true, true } }, 2);
+  const std::vector<rclcpp::Time> cycles = controlCycles(first);
+  SampleComparison comparison(first);
+
+  for (size_t i = 0; i < cycles.size() / 2; ++i) {
+    comparison.expectSameSample(cycles[i], InterpolationMethod::VARIABLE_DEGREE_SPLINE);
+  }
+  // The sampler has to notice the new message on its own and start again from its first segment
+  const rclcpp::Time switch_time = cycles[cycles.size() / 2];
+  comparison.update(second, switch_time);
+  const rclcpp::Time end = switch_time + rclcpp::Duration(second.points.back().time_from_start) +
+                           rclcpp::Duration::from_seconds(1.0);
+  for (rclcpp::Time time = switch_time; time < end; time += rclcpp::Duration::from_seconds(0.002)) {
+    comparison.expectSameSample(time, InterpolationMethod::VARIABLE_DEGREE_SPLINE);
+  }
+}
+
+TEST(TrajectorySamplerTest, rejects_accelerations_without_velocities)
+{
+  const JointTrajectory trajectory = randomTrajectory(3, { { false, true } });
+  Trajectory sampled(std::make_shared<JointTrajectory>(trajectory));
+  sampled.set_point_before_trajectory_msg(START_TIME, currentState(), NO_WRAPAROUND);
+  TrajectorySampler sampler;
+  sampler.reserve(DOF);
+
+  // The first sample is handed to the trajectory, which sets its start time
+  JointTrajectoryPoint state;
+  TrajectoryPointConstIter start, end;
+  sampler.sample(sampled, START_TIME, InterpolationMethod::VARIABLE_DEGREE_SPLINE, state, start, end);
+
+  // Between the first and the second point
+  const rclcpp::Time between =
+      START_TIME + (rclcpp::Duration(trajectory.points[0].time_from_start) +
+                    rclcpp::Duration(trajectory.points[1].time_from_start)) *
+                       0.5;
+  EXPECT_FALSE(sampler.sample(sampled, between, InterpolationMethod::VARIABLE_DEGREE_SPLINE, state, start, end));
+  // Sampling the segment again must not use the coefficients left over from the failed attempt
+  EXPECT_FALSE(sampler.sample(sampled, between, InterpolationMethod::VARIABLE_DEGREE_SPLINE, state, start, end));
+}
@@ -0,0 +1,145 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_KINEMATICS__UR_KINEMATICS_PLUGIN_HPP_
+#define UR_KINEMATICS__UR_KINEMATICS_PLUGIN_HPP_
+
+#include <Eigen/Geometry>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "moveit/kinematics_base/kinematics_base.h"
+#include "moveit/robot_model/robot_model.h"
+#include "rclcpp/rclcpp.hpp"
+#include "ur_calibration/calibrated_ik.hpp"
+
+namespace ur_kinematics
+{
+/*!
+ * \brief MoveIt kinematics plugin solving the inverse kinematics of UR arms in closed form.
+ *
+ * The calibrated chain is taken from the joint origins of the robot description, which contain the
+ * calibration when the description was generated with a kinematics file created by ur_calibration. The
+ * nominal DH parameters needed for the closed-form solution are read from the same joint origins. See
+ * ur_calibration::CalibratedIK for the solver itself.
+ */
+class URKinematicsPlugin : public kinematics::KinematicsBase
+{
+public:
+  bool initialize(const rclcpp::Node::SharedPtr& node, const moveit::core::RobotModel& robot_model,
+                  const std::string& group_name, const std::string& base_frame,
+                  const std::vector<std::string>& tip_frames, double search_discretization) override;
+
+  bool getPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                     std::vector<double>& solution, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                     const kinematics::KinematicsQueryOptions& options =
+                         kinematics::KinematicsQueryOptions()) const override;
+
+  /*!
+   * \brief Returns all solutions for the pose, ordered by their distance to the seed.
+   */
+  bool getPositionIK(const std::vector<geometry_msgs::msg::Pose>& ik_poses, const std::vector<double>& ik_seed_state,
+                     std::vector<std::vector<double>>& solutions, kinematics::KinematicsResult& result,
+                     const kinematics::KinematicsQueryOptions& options) const override;
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double timeout, std::vector<double>& solution, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& options =
+                            kinematics::KinematicsQueryOptions()) const override;
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double timeout, const std::vector<double>& consistency_limits, std::vector<double>& solution,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& options =
+                            kinematics::KinematicsQueryOptions()) const override;
+
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double timeout, std::vector<double>& solution, const IKCallbackFn& solution_callback,
+                        moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& options =
+                            kinematics::KinematicsQueryOptions()) const override;
+
+  /*!
+   * \brief Returns the first solution that is within the consistency limits and accepted by the callback.
+   *
+   * As all solutions are known at once, candidates are checked nearest to the seed first and the timeout is not
+   * needed.
+   */
+  bool searchPositionIK(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state,
+                        double timeout, const std::vector<double>& consistency_limits, std::vector<double>& solution,
+                        const IKCallbackFn& solution_callback, moveit_msgs::msg::MoveItErrorCodes& error_code,
+                        const kinematics::KinematicsQueryOptions& options =
+                            kinematics::KinematicsQueryOptions()) const override;
+
+  /*!
+   * \brief Calculates the pose of the tip frame, the only link supported.
+   */
+  bool getPositionFK(const std::vector<std::string>& link_names, const std::vector<double>& joint_angles,
+                     std::vector<geometry_msgs::msg::Pose>& poses) const override;
+
+  const std::vector<std::string>& getJointNames() const override;
+
+  const std::vector<std::string>& getLinkNames() const override;
+
+private:
+  using JointVector = ur_calibration::CalibratedIK::JointVector;
+
+  /*
+   * Solves for all solutions of the pose that are within the joint limits, ordered by their distance to the seed.
+   */
+  std::vector<JointVector> solve(const geometry_msgs::msg::Pose& ik_pose,
+                                 const std::vector<double>& ik_seed_state) const;
+
+  // Shifts the joints by multiples of 2 pi into their limits, if possible
+  bool enforceLimits(JointVector& joint_values) const;
+
+  std::vector<std::string> joint_names_;
+  std::vector<std::string> link_names_;
+  std::vector<std::pair<double, double>> joint_limits_;
+
+  // Transform from the base frame to the chain and from the chain's end to the tip frame
+  Eigen::Isometry3d base_offset_;
+  Eigen::Isometry3d tip_offset_;
+
+  std::unique_ptr<ur_calibration::CalibratedFK> fk_;
+  std::unique_ptr<ur_calibration::CalibratedIK> ik_;
+};
+}  // namespace ur_kinematics
+
+#endif  // UR_KINEMATICS__UR_KINEMATICS_PLUGIN_HPP_
@@ -0,0 +1,322 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_kinematics/ur_kinematics_plugin.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "moveit/robot_model/revolute_joint_model.h"
+#include "moveit/robot_state/robot_state.h"
+#include "tf2_eigen/tf2_eigen.hpp"
+
+namespace ur_kinematics
+{
+bool URKinematicsPlugin::initialize(const rclcpp::Node::SharedPtr& node, const moveit::core::RobotModel& robot_model,
+                                    const std::string& group_name, const std::string& base_frame,
+                                    const std::vector<std::string>& tip_frames, double search_discretization)
+{
+  storeValues(robot_model, group_name, base_frame, tip_frames, search_discretization);
+
+  const moveit::core::JointModelGroup* group = robot_model.getJointModelGroup(group_name);
+  if (!group) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Unknown planning group '%s'", group_name.c_str());
+    return false;
+  }
+  if (tip_frames_.size() != 1) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Only a single tip frame is supported, got %zu",
+                 tip_frames_.size());
+    return false;
+  }
+
+  const std::vector<const moveit::core::JointModel*>& joints = group->getActiveJointModels();
+  if (joints.size() != 6) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Group '%s' has to consist of 6 joints, got %zu",
+                 group_name.c_str(), joints.size());
+    return false;
+  }
+
+  // Each joint rotates its child link about z, after the link's origin transform
+  std::vector<Eigen::Matrix4d> chain;
+  joint_names_.clear();
+  joint_limits_.clear();
+  for (size_t i = 0; i < joints.size(); ++i) {
+    const moveit::core::JointModel* joint = joints[i];
+    if (joint->getType() != moveit::core::JointModel::REVOLUTE ||
+        !static_cast<const moveit::core::RevoluteJointModel*>(joint)->getAxis().isApprox(Eigen::Vector3d::UnitZ())) {
+      RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Joint '%s' is not a revolute joint about the z axis",
+                   joint->getName().c_str());
+      return false;
+    }
+    if (i > 0 && joint->getParentLinkModel() != joints[i - 1]->getChildLinkModel()) {
+      RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Joint '%s' doesn't directly follow joint '%s'",
+                   joint->getName().c_str(), joints[i - 1]->getName().c_str());
+      return false;
+    }
+    chain.push_back(joint->getChildLinkModel()->getJointOriginTransform().matrix());
+
+    joint_names_.push_back(joint->getName());
+    const moveit::core::VariableBounds& bounds = joint->getVariableBounds()[0];
+    if (bounds.position_bounded_) {
+      joint_limits_.emplace_back(bounds.min_position_, bounds.max_position_);
+    } else {
+      joint_limits_.emplace_back(-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    }
+  }
+
+  const moveit::core::LinkModel* base_link = robot_model.getLinkModel(base_frame_);
+  const moveit::core::LinkModel* tip_link = robot_model.getLinkModel(tip_frames_[0]);
+  if (!base_link || !tip_link) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Unknown base frame '%s' or tip frame '%s'",
+                 base_frame_.c_str(), tip_frames_[0].c_str());
+    return false;
+  }
+  if (moveit::core::RobotModel::getRigidlyConnectedParentLinkModel(base_link) !=
+          moveit::core::RobotModel::getRigidlyConnectedParentLinkModel(joints.front()->getParentLinkModel()) ||
+      moveit::core::RobotModel::getRigidlyConnectedParentLinkModel(tip_link) != joints.back()->getChildLinkModel()) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"),
+                 "The base frame and the tip frame have to be rigidly attached to the ends of the chain");
+    return false;
+  }
+  // Rigidly attached links keep their relative transform in any state
+  moveit::core::RobotState state(robot_model_);
+  state.setToDefaultValues();
+  state.update();
+  base_offset_ = state.getGlobalLinkTransform(base_link).inverse() *
+                 state.getGlobalLinkTransform(joints.front()->getParentLinkModel());
+  tip_offset_ = state.getGlobalLinkTransform(joints.back()->getChildLinkModel()).inverse() *
+                state.getGlobalLinkTransform(tip_link);
+
+  // The link origins of a UR description are derived from the DH parameters, see ur_calibration
+  ur_calibration::DHRobot nominal;
+  nominal.segments_ = {
+    ur_calibration::DHSegment(chain[0](2, 3), 0.0, 0.0, M_PI_2),
+    ur_calibration::DHSegment(0.0, chain[2](0, 3), 0.0, 0.0),
+    ur_calibration::DHSegment(0.0, chain[3](0, 3), 0.0, 0.0),
+    ur_calibration::DHSegment(chain[3](2, 3), 0.0, 0.0, M_PI_2),
+    ur_calibration::DHSegment(-chain[4](1, 3), 0.0, 0.0, -M_PI_2),
+    ur_calibration::DHSegment(chain[5](1, 3), 0.0, 0.0, 0.0),
+  };
+  fk_ = std::make_unique<ur_calibration::CalibratedFK>(chain);
+  ik_ = std::make_unique<ur_calibration::CalibratedIK>(nominal, *fk_);
+
+  link_names_ = tip_frames_;
+  RCLCPP_INFO(rclcpp::get_logger("ur_kinematics"), "Initialized closed-form kinematics of group '%s' from '%s' to '%s'",
+              group_name.c_str(), base_frame_.c_str(), tip_frames_[0].c_str());
+  return true;
+}
+
+bool URKinematicsPlugin::getPositionIK(const geometry_msgs::msg::Pose& ik_pose,
+                                       const std::vector<double>& ik_seed_state, std::vector<double>& solution,
+                                       moveit_msgs::msg::MoveItErrorCodes& error_code,
+                                       const kinematics::KinematicsQueryOptions& options) const
+{
+  return searchPositionIK(ik_pose, ik_seed_state, 0.0, std::vector<double>(), solution, IKCallbackFn(), error_code,
+                          options);
+}
+
+bool URKinematicsPlugin::getPositionIK(const std::vector<geometry_msgs::msg::Pose>& ik_poses,
+                                       const std::vector<double>& ik_seed_state,
+                                       std::vector<std::vector<double>>& solutions,
+                                       kinematics::KinematicsResult& result,
+                                       const kinematics::KinematicsQueryOptions& options) const
+{
+  solutions.clear();
+  if (ik_poses.size() != 1) {
+    result.kinematic_error = kinematics::KinematicErrors::MULTIPLE_TIPS_NOT_SUPPORTED;
+    return false;
+  }
+  if (ik_seed_state.size() != joint_names_.size()) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Seed state has %zu joints, expected %zu", ik_seed_state.size(),
+                 joint_names_.size());
+    result.kinematic_error = kinematics::KinematicErrors::NO_SOLUTION;
+    return false;
+  }
+
+  for (const JointVector& candidate : solve(ik_poses[0], ik_seed_state)) {
+    solutions.emplace_back(candidate.data(), candidate.data() + candidate.size());
+  }
+  result.kinematic_error =
+      solutions.empty() ? kinematics::KinematicErrors::NO_SOLUTION : kinematics::KinematicErrors::OK;
+  result.solution_percentage = solutions.empty() ? 0.0 : 1.0;
+  return !solutions.empty();
+}
+
+bool URKinematicsPlugin::searchPositionIK(const geometry_msgs::msg::Pose& ik_pose,
+                                          const std::vector<double>& ik_seed_state, double timeout,
+                                          std::vector<double>& solution,
+                                          moveit_msgs::msg::MoveItErrorCodes& error_code,
+                                          const kinematics::KinematicsQueryOptions& options) const
+{
+  return searchPositionIK(ik_pose, ik_seed_state, timeout, std::vector<double>(), solution, IKCallbackFn(),
+                          error_code, options);
+}
+
+bool URKinematicsPlugin::searchPositionIK(const geometry_msgs::msg::Pose& ik_pose,
+                                          const std::vector<double>& ik_seed_state, double timeout,
+                                          const std::vector<double>& consistency_limits, std::vector<double>& solution,
+                                          moveit_msgs::msg::MoveItErrorCodes& error_code,
+                                          const kinematics::KinematicsQueryOptions& options) const
+{
+  return searchPositionIK(ik_pose, ik_seed_state, timeout, consistency_limits, solution, IKCallbackFn(), error_code,
+                          options);
+}
+
+bool URKinematicsPlugin::searchPositionIK(const geometry_msgs::msg::Pose& ik_pose,
+                                          const std::vector<double>& ik_seed_state, double timeout,
+                                          std::vector<double>& solution, const IKCallbackFn& solution_callback,
+                                          moveit_msgs::msg::MoveItErrorCodes& error_code,
+                                          const kinematics::KinematicsQueryOptions& options) const
+{
+  return searchPositionIK(ik_pose, ik_seed_state, timeout, std::vector<double>(), solution, solution_callback,
+                          error_code, options);
+}
+
+bool URKinematicsPlugin::searchPositionIK(const geometry_msgs::msg::Pose& ik_pose,
+                                          const std::vector<double>& ik_seed_state, double timeout,
+                                          const std::vector<double>& consistency_limits, std::vector<double>& solution,
+                                          const IKCallbackFn& solution_callback,
+                                          moveit_msgs::msg::MoveItErrorCodes& error_code,
+                                          const kinematics::KinematicsQueryOptions& options) const
+{
+  if (ik_seed_state.size() != joint_names_.size() ||
+      (!consistency_limits.empty() && consistency_limits.size() != joint_names_.size())) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"),
+                 "Seed state has %zu joints and consistency limits %zu, expected %zu", ik_seed_state.size(),
+                 consistency_limits.size(), joint_names_.size());
+    error_code.val = moveit_msgs::msg::MoveItErrorCodes::INVALID_ROBOT_STATE;
+    return false;
+  }
+
+  for (const JointVector& candidate : solve(ik_pose, ik_seed_state)) {
+    bool consistent = true;
+    for (size_t i = 0; i < consistency_limits.size(); ++i) {
+      consistent = consistent && std::abs(candidate(i) - ik_seed_state[i]) <= consistency_limits[i];
+    }
+    if (!consistent) {
+      continue;
+    }
+
+    solution.assign(candidate.data(), candidate.data() + candidate.size());
+    error_code.val = moveit_msgs::msg::MoveItErrorCodes::SUCCESS;
+    if (solution_callback) {
+      solution_callback(ik_pose, solution, error_code);
+    }
+    if (error_code.val == moveit_msgs::msg::MoveItErrorCodes::SUCCESS) {
+      return true;
+    }
+  }
+  error_code.val = moveit_msgs::msg::MoveItErrorCodes::NO_IK_SOLUTION;
+  return false;
+}
+
+bool URKinematicsPlugin::getPositionFK(const std::vector<std::string>& link_names,
+                                       const std::vector<double>& joint_angles,
+                                       std::vector<geometry_msgs::msg::Pose>& poses) const
+{
+  if (joint_angles.size() != joint_names_.size()) {
+    RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Got %zu joint angles, expected %zu", joint_angles.size(),
+                 joint_names_.size());
+    return false;
+  }
+
+  poses.clear();
+  const Eigen::Isometry3d pose =
+      base_offset_ * Eigen::Isometry3d(fk_->forward(Eigen::Map<const JointVector>(joint_angles.data()))) * tip_offset_;
+  for (const std::string& link_name : link_names) {
+    if (link_name != tip_frames_[0]) {
+      RCLCPP_ERROR(rclcpp::get_logger("ur_kinematics"), "Forward kinematics are only available for the tip frame '%s'",
+                   tip_frames_[0].c_str());
+      return false;
+    }
+    poses.push_back(tf2::toMsg(pose));
+  }
+  return true;
+}
+
+const std::vector<std::string>& URKinematicsPlugin::getJointNames() const
+{
+  return joint_names_;
+}
+
+const std::vector<std::string>& URKinematicsPlugin::getLinkNames() const
+{
+  return link_names_;
+}
+
+std::vector<URKinematicsPlugin::JointVector>
+URKinematicsPlugin::solve(const geometry_msgs::msg::Pose& ik_pose, const std::vector<double>& ik_seed_state) const
+{
+  Eigen::Isometry3d pose;
+  tf2::fromMsg(ik_pose, pose);
+  const JointVector seed = Eigen::Map<const JointVector>(ik_seed_state.data());
+
+  std::vector<JointVector> solutions;
+  for (JointVector solution : ik_->solve((base_offset_.inverse() * pose * tip_offset_.inverse()).matrix(), seed)) {
+    if (enforceLimits(solution)) {
+      solutions.push_back(solution);
+    }
+  }
+  // Shifting into the limits may have changed the order
+  std::sort(solutions.begin(), solutions.end(), [&seed](const JointVector& a, const JointVector& b) {
+    return (a - seed).squaredNorm() < (b - seed).squaredNorm();
+  });
+  return solutions;
+}
+
+bool URKinematicsPlugin::enforceLimits(JointVector& joint_values) const
+{
+  for (size_t i = 0; i < joint_limits_.size(); ++i) {
+    const double lower = joint_limits_[i].first;
+    const double upper = joint_limits_[i].second;
+    if (joint_values(i) < lower) {
+      joint_values(i) += 2 * M_PI * std::ceil((lower - joint_values(i)) / (2 * M_PI));
+    } else if (joint_values(i) > upper) {
+      joint_values(i) -= 2 * M_PI * std::ceil((joint_values(i) - upper) / (2 * M_PI));
+    }
+    if (joint_values(i) < lower || joint_values(i) > upper) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace ur_kinematics
+
+#include "pluginlib/class_list_macros.hpp"
+
+PLUGINLIB_EXPORT_CLASS(ur_kinematics::URKinematicsPlugin, kinematics::KinematicsBase)
@@ -0,0 +1,269 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ament_index_cpp/get_package_share_directory.hpp"
+#include "moveit/robot_model/robot_model.h"
+#include "moveit/robot_state/robot_state.h"
+#include "rclcpp/rclcpp.hpp"
+#include "srdfdom/model.h"
+#include "tf2_eigen/tf2_eigen.hpp"
+#include "ur_kinematics/ur_kinematics_plugin.hpp"
+#include "urdf/model.h"
+
+namespace
+{
+const std::string GROUP = "ur_manipulator";
+const std::string BASE_FRAME = "base_link";
+const std::string TIP_FRAME = "tool0";
+
+// The group MoveIt configurations of UR arms use, from base_link to tool0
+const std::string SRDF = R"(<?xml version="1.0"?>
+<robot name="ur5">
+  <group name="ur_manipulator">
+    <chain base_link="base_link" tip_link="tool0"/>
+  </group>
+</robot>)";
+
+// Expands the robot description shipped with ur_description, like the driver's launch files do
+std::string loadDescription(const std::string& ur_type)
+{
+  const std::string command = "xacro " + ament_index_cpp::get_package_share_directory("ur_description") +
+                              "/urdf/ur.urdf.xacro ur_type:=" + ur_type + " name:=" + ur_type;
+  std::string description;
+  FILE* output = popen(command.c_str(), "r");
+  if (!output) {
+    return description;
+  }
+  char buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), output)) > 0) {
+    description.append(buffer, read);
+  }
+  return pclose(output) == 0 ? description : std::string();
+}
+
+// Joint values wrapped into (-pi, pi], so solutions shifted by multiples of 2 pi compare equal
+double angleDifference(double a, double b)
+{
+  return std::remainder(a - b, 2 * M_PI);
+}
+}  // namespace
+
+class URKinematicsPluginTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestSuite()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    auto urdf_model = std::make_shared<urdf::Model>();
+    ASSERT_TRUE(urdf_model->initString(loadDescription("ur5")));
+    auto srdf_model = std::make_shared<srdf::Model>();
+    ASSERT_TRUE(srdf_model->initString(*urdf_model, SRDF));
+    robot_model_ = std::make_shared<moveit::core::RobotModel>(urdf_model, srdf_model);
+    group_ = robot_model_->getJointModelGroup(GROUP);
+    ASSERT_NE(group_, nullptr);
+
+    ASSERT_TRUE(plugin_.initialize(rclcpp::Node::make_shared("ur_kinematics_plugin_test"), *robot_model_, GROUP,
+                                   BASE_FRAME, { TIP_FRAME }, 0.1));
+    ASSERT_EQ(plugin_.getJointNames(), group_->getActiveJointModelNames());
+  }
+
+  // Uniformly distributed within the joint limits, but away from the singularities of the elbow and the wrist
+  std::vector<double> randomJointValues()
+  {
+    std::vector<double> joint_values;
+    do {
+      joint_values.clear();
+      for (const moveit::core::JointModel* joint : group_->getActiveJointModels()) {
+        const moveit::core::VariableBounds& bounds = joint->getVariableBounds()[0];
+        std::uniform_real_distribution<double> distribution(bounds.min_position_, bounds.max_position_);
+        joint_values.push_back(distribution(gen_));
+      }
+    } while (std::abs(std::sin(joint_values[2])) < 0.05 || std::abs(std::sin(joint_values[4])) < 0.05);
+    return joint_values;
+  }
+
+  // Pose of the tip frame in the base frame as calculated by MoveIt from the robot description
+  Eigen::Isometry3d tipPose(const std::vector<double>& joint_values) const
+  {
+    moveit::core::RobotState state(robot_model_);
+    state.setToDefaultValues();
+    state.setJointGroupPositions(group_, joint_values);
+    state.update();
+    return state.getGlobalLinkTransform(BASE_FRAME).inverse() * state.getGlobalLinkTransform(TIP_FRAME);
+  }
+
+  bool withinLimits(const std::vector<double>& joint_values) const
+  {
+    moveit::core::RobotState state(robot_model_);
+    state.setToDefaultValues();
+    state.setJointGroupPositions(group_, joint_values);
+    return state.satisfiesBounds(group_);
+  }
+
+  static void expectPoseNear(const Eigen::Isometry3d& expected, const Eigen::Isometry3d& actual)
+  {
+    EXPECT_LT((expected.matrix() - actual.matrix()).norm(), 1e-6) << "expected\n"
+                                                                   << expected.matrix() << "\nactual\n"
+                                                                   << actual.matrix();
+  }
+
+  moveit::core::RobotModelPtr robot_model_;
+  const moveit::core::JointModelGroup* group_ = nullptr;
+  ur_kinematics::URKinematicsPlugin plugin_;
+  std::mt19937 gen_{ 42 };
+};
+
+TEST_F(URKinematicsPluginTest, forward_kinematics_match_the_robot_description)
+{
+  // Covers the chain taken from the joint origins as well as the offsets of base_link and tool0
+  for (size_t i = 0; i < 200; ++i) {
+    const std::vector<double> joint_values = randomJointValues();
+    std::vector<geometry_msgs::msg::Pose> poses;
+    ASSERT_TRUE(plugin_.getPositionFK({ TIP_FRAME }, joint_values, poses));
+    ASSERT_EQ(poses.size(), 1u);
+    Eigen::Isometry3d pose;
+    tf2::fromMsg(poses[0], pose);
+    expectPoseNear(tipPose(joint_values), pose);
+  }
+}
+
+TEST_F(URKinematicsPluginTest, inverse_kinematics_reproduce_random_poses)
+{
+  for (size_t i = 0; i < 500; ++i) {
+    const std::vector<double> joint_values = randomJointValues();
+    const Eigen::Isometry3d pose = tipPose(joint_values);
+    const geometry_msgs::msg::Pose pose_msg = tf2::toMsg(pose);
+
+    // Seeded far away, so the solutions have to come from the closed-form branches instead of refining the seed
+    const std::vector<double> seed = randomJointValues();
+    std::vector<double> solution;
+    moveit_msgs::msg::MoveItErrorCodes error_code;
+    ASSERT_TRUE(plugin_.getPositionIK(pose_msg, seed, solution, error_code)) << "pose " << i;
+    EXPECT_EQ(error_code.val, moveit_msgs::msg::MoveItErrorCodes::SUCCESS);
+    EXPECT_TRUE(withinLimits(solution));
+    expectPoseNear(pose, tipPose(solution));
+
+    std::vector<geometry_msgs::msg::Pose> poses;
+    ASSERT_TRUE(plugin_.getPositionFK({ TIP_FRAME }, solution, poses));
+    Eigen::Isometry3d plugin_pose;
+    tf2::fromMsg(poses[0], plugin_pose);
+    expectPoseNear(pose, plugin_pose);
+
+    // The configuration the pose was created from is among all solutions
+    std::vector<std::vector<double>> solutions;
+    kinematics::KinematicsResult result;
+    ASSERT_TRUE(plugin_.getPositionIK({ pose_msg }, seed, solutions, result, kinematics::KinematicsQueryOptions()));
+    EXPECT_LE(solutions.size(), 8u);
+    bool found = false;
+    for (const std::vector<double>& candidate : solutions) {
+      EXPECT_TRUE(withinLimits(candidate));
+      expectPoseNear(pose, tipPose(candidate));
+      bool same = true;
+      for (size_t j = 0; j < candidate.size(); ++j) {
+        same = same && std::abs(angleDifference(candidate[j], joint_values[j])) < 1e-6;
+      }
+      found = found || same;
+    }
+    EXPECT_TRUE(found) << "pose " << i << " has " << solutions.size() << " solutions";
+  }
+}
+
+TEST_F(URKinematicsPluginTest, shifts_solutions_into_the_joint_limits)
+{
+  // The elbow is limited to [-pi, pi]. Next to the seed, the elbow would be solved at 2 pi - 3.0.
+  const std::vector<double> elbow_values = { 0.3, -1.2, -3.0, -0.5, 1.2, 0.4 };
+  std::vector<double> elbow_seed = elbow_values;
+  elbow_seed[2] = 3.0;
+
+  // The wrist joints may turn twice, so a solution a turn away from zero is kept where it is
+  const std::vector<double> wrist_values = { 0.3, -1.2, 1.1, -0.5, 1.2, 0.4 - 2 * M_PI };
+  std::vector<double> wrist_seed = wrist_values;
+  wrist_seed[5] = -M_PI;
+
+  for (const auto& [joint_values, seed] : { std::make_pair(elbow_values, elbow_seed),
+                                             std::make_pair(wrist_values, wrist_seed) }) {
+    std::vector<std::vector<double>> solutions;
+    kinematics::KinematicsResult result;
+    ASSERT_TRUE(plugin_.getPositionIK({ tf2::toMsg(tipPose(joint_values)) }, seed, solutions, result,
+                                      kinematics::KinematicsQueryOptions()));
+    bool found = false;
+    double last_distance = 0.0;
+    for (const std::vector<double>& solution : solutions) {
+      EXPECT_TRUE(withinLimits(solution));
+      bool same = true;
+      double distance = 0.0;
+      for (size_t j = 0; j < solution.size(); ++j) {
+        same = same && std::abs(solution[j] - joint_values[j]) < 1e-6;
+        distance += (solution[j] - seed[j]) * (solution[j] - seed[j]);
+      }
+      found = found || same;
+      // Shifting into the limits keeps the solutions ordered by their distance to the seed
+      EXPECT_GE(distance, last_distance);
+      last_distance = distance;
+    }
+    EXPECT_TRUE(found);
+  }
+}
+
+TEST_F(URKinematicsPluginTest, rejects_unreachable_poses)
+{
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(5.0, 0.0, 0.0);
+  std::vector<double> solution;
+  moveit_msgs::msg::MoveItErrorCodes error_code;
+  EXPECT_FALSE(plugin_.getPositionIK(tf2::toMsg(pose), std::vector<double>(6, 0.0), solution, error_code));
+  EXPECT_EQ(error_code.val, moveit_msgs::msg::MoveItErrorCodes::NO_IK_SOLUTION);
+}
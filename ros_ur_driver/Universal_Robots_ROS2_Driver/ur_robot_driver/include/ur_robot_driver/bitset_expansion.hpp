@@ -0,0 +1,100 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__BITSET_EXPANSION_HPP_
+#define UR_ROBOT_DRIVER__BITSET_EXPANSION_HPP_
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace ur_robot_driver
+{
+namespace detail
+{
+// Doubles for all combinations of four bits, so bitsets can be expanded a nibble at a time
+inline constexpr std::array<std::array<double, 4>, 16> NIBBLE_TO_DOUBLES = { {
+    { { 0, 0, 0, 0 } },
+    { { 1, 0, 0, 0 } },
+    { { 0, 1, 0, 0 } },
+    { { 1, 1, 0, 0 } },
+    { { 0, 0, 1, 0 } },
+    { { 1, 0, 1, 0 } },
+    { { 0, 1, 1, 0 } },
+    { { 1, 1, 1, 0 } },
+    { { 0, 0, 0, 1 } },
+    { { 1, 0, 0, 1 } },
+    { { 0, 1, 0, 1 } },
+    { { 1, 1, 0, 1 } },
+    { { 0, 0, 1, 1 } },
+    { { 1, 0, 1, 1 } },
+    { { 0, 1, 1, 1 } },
+    { { 1, 1, 1, 1 } },
+} };
+}  // namespace detail
+
+/*!
+ * \brief Expands a bitset into one double per bit, but only if any bit changed since the last call.
+ *
+ * \param bits Bitset as read from the robot
+ * \param last_word Raw value of the bitset at the last expansion, updated on change
+ * \param copy Doubles exported through the state interfaces
+ */
+template <size_t N>
+void expandBitset(const std::bitset<N>& bits, uint64_t& last_word, std::array<double, N>& copy)
+{
+  static_assert(N <= 64, "Bitset does not fit into a single word");
+
+  // IO and status bits rarely change, so most cycles end here
+  const uint64_t word = bits.to_ullong();
+  if (word == last_word) {
+    return;
+  }
+  last_word = word;
+
+  size_t i = 0;
+  for (; i + 4 <= N; i += 4) {
+    const auto& nibble = detail::NIBBLE_TO_DOUBLES[(word >> i) & 0xF];
+    std::copy(nibble.begin(), nibble.end(), copy.begin() + i);
+  }
+  for (; i < N; ++i) {
+    copy[i] = static_cast<double>((word >> i) & 1);
+  }
+}
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__BITSET_EXPANSION_HPP_
@@ -0,0 +1,102 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__CONNECTION_RECOVERY_HPP_
+#define UR_ROBOT_DRIVER__CONNECTION_RECOVERY_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Delays between attempts to re-establish a lost connection, doubling after every failed attempt.
+ */
+class ReconnectBackoff
+{
+public:
+  /*!
+   * \param initial_delay Delay after the first failed attempt
+   * \param max_delay Upper bound for the delay
+   */
+  ReconnectBackoff(std::chrono::milliseconds initial_delay, std::chrono::milliseconds max_delay)
+    : initial_delay_(initial_delay), max_delay_(std::max(initial_delay, max_delay)), delay_(initial_delay)
+  {
+  }
+
+  /*!
+   * \brief Returns the delay before the next attempt and doubles the one after it, up to the maximum.
+   */
+  std::chrono::milliseconds next()
+  {
+    const std::chrono::milliseconds delay = delay_;
+    delay_ = std::min(delay_ * 2, max_delay_);
+    return delay;
+  }
+
+  /*!
+   * \brief Starts over with the initial delay, to be called once the connection is re-established.
+   */
+  void reset()
+  {
+    delay_ = initial_delay_;
+  }
+
+private:
+  std::chrono::milliseconds initial_delay_;
+  std::chrono::milliseconds max_delay_;
+  std::chrono::milliseconds delay_;
+};
+
+/*!
+ * \brief Counts re-established connections and the time from losing each of them until it was back.
+ */
+struct RecoveryStatistics
+{
+  size_t reconnects = 0;
+  std::chrono::duration<double> last_recovery_time{ 0.0 };
+  std::chrono::duration<double> max_recovery_time{ 0.0 };
+
+  void recordRecovery(std::chrono::duration<double> recovery_time)
+  {
+    ++reconnects;
+    last_recovery_time = recovery_time;
+    max_recovery_time = std::max(max_recovery_time, recovery_time);
+  }
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__CONNECTION_RECOVERY_HPP_
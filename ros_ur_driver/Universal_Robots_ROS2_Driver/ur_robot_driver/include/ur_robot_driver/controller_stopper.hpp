@@ -40,6 +40,8 @@
 #ifndef UR_ROBOT_DRIVER__CONTROLLER_STOPPER_HPP_
 #define UR_ROBOT_DRIVER__CONTROLLER_STOPPER_HPP_
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -49,6 +51,12 @@
 #include "controller_manager_msgs/srv/switch_controller.hpp"
 #include "std_msgs/msg/bool.hpp"
 
+/*!
+ * \brief Deactivates controllers while the robot program isn't running and reactivates them afterwards.
+ *
+ * The controller states are cached and refreshed in the background, so the switch request deactivating the
+ * controllers is ready to be sent as soon as the robot program stops.
+ */
 class ControllerStopper
 {
 public:
@@ -60,13 +68,23 @@ private:
   void robotRunningCallback(const std_msgs::msg::Bool::ConstSharedPtr msg);
 
   /*!
-   * \brief Queries running stoppable controllers and the controllers are stopped.
+   * \brief Requests the controller states from the controller manager, unless a request is on its way already.
+   */
+  void refreshControllers();
+
+  /*!
+   * \brief Updates the cached controller states and the prepared switch request.
+   *
+   * Stops the controllers if that has been requested before their states were known.
+   */
+  void controllersListed(const controller_manager_msgs::srv::ListControllers::Response& response);
+
+  /*!
+   * \brief Stops the running controllers except the consistent_controllers_, based on the cached states.
    *
-   * Queries the controller manager for running controllers and compares the result with the
-   * consistent_controllers_. The remaining running controllers are stored in stopped_controllers_
-   * and stopped afterwards.
+   * The stopped controllers are stored in stopped_controllers_ for starting them again.
    */
-  void findAndStopControllers();
+  void stopControllers();
 
   /*!
    * \brief Starts the controllers stored in stopped_controllers_.
@@ -74,15 +92,37 @@ private:
    */
   void startControllers();
 
+  /*!
+   * \brief Prepares the switch request deactivating the stoppable_controllers_.
+   */
+  void prepareStopRequest();
+
   std::shared_ptr<rclcpp::Node> node_;
   rclcpp::Client<controller_manager_msgs::srv::SwitchController>::SharedPtr controller_manager_srv_;
   rclcpp::Client<controller_manager_msgs::srv::ListControllers>::SharedPtr controller_list_srv_;
 
   rclcpp::Subscription<std_msgs::msg::Bool>::SharedPtr robot_running_sub_;
+  rclcpp::TimerBase::SharedPtr refresh_timer_;
 
   std::vector<std::string> consistent_controllers_;
   std::vector<std::string> stopped_controllers_;
 
+  // Active controllers that aren't consistent controllers, as last reported by the controller manager
+  std::vector<std::string> stoppable_controllers_;
+  std::shared_ptr<controller_manager_msgs::srv::SwitchController::Request> stop_request_;
+  bool controllers_known_;
+  bool list_pending_;
+  std::chrono::steady_clock::time_point list_requested_;
+  // Incremented with every switch request, so controller states listed before it are discarded
+  uint64_t switch_count_;
+
+  // Stopping has been requested before the controller states were known or the cached states were outdated
+  bool stop_pending_;
+  // Stopping on startup waits for stoppable controllers being loaded and activated
+  bool wait_for_stoppable_;
+  bool stop_retried_;
+  std::chrono::steady_clock::time_point stop_requested_;
+
   bool stop_controllers_on_startup_;
   bool robot_running_;
 };
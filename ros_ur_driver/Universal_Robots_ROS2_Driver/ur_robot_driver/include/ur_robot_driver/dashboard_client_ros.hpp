@@ -41,17 +41,25 @@
 #define UR_ROBOT_DRIVER__DASHBOARD_CLIENT_ROS_HPP_
 
 // System
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <regex>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
 
 // ROS
 #include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/bool.hpp"
 #include "std_srvs/srv/trigger.hpp"
 // UR client library
-#include "ur_client_library/ur/dashboard_client.h"
 #include "ur_client_library/exceptions.h"
 #include "ur_dashboard_msgs/msg/program_state.hpp"
+#include "ur_dashboard_msgs/msg/robot_mode.hpp"
+#include "ur_dashboard_msgs/msg/safety_mode.hpp"
 #include "ur_dashboard_msgs/srv/add_to_log.hpp"
 #include "ur_dashboard_msgs/srv/get_loaded_program.hpp"
 #include "ur_dashboard_msgs/srv/get_program_state.hpp"
@@ -62,6 +70,7 @@
 #include "ur_dashboard_msgs/srv/load.hpp"
 #include "ur_dashboard_msgs/srv/popup.hpp"
 #include "ur_dashboard_msgs/srv/raw_request.hpp"
+#include "ur_robot_driver/dashboard_command_executor.hpp"
 
 namespace ur_robot_driver
 {
@@ -84,16 +93,66 @@ public:
   virtual ~DashboardClientROS() = default;
 
 private:
+  /*!
+   * \brief Last answer to a status query together with the time it was received.
+   */
+  template <typename ServiceT>
+  struct CachedResponse
+  {
+    typename ServiceT::Response response;
+    std::chrono::steady_clock::time_point stamp;
+    bool valid = false;
+  };
+
+  /*!
+   * \brief Invalidates the status cache when a command is sent and again when it has been answered.
+   *
+   * Status queries answered in between can't be told apart from ones answered before the command, so their answers
+   * aren't cached.
+   */
+  class StatusInvalidation
+  {
+  public:
+    explicit StatusInvalidation(DashboardClientROS& dashboard_client) : dashboard_client_(dashboard_client)
+    {
+      dashboard_client_.invalidateStatus();
+    }
+    ~StatusInvalidation()
+    {
+      dashboard_client_.invalidateStatus();
+    }
+
+  private:
+    DashboardClientROS& dashboard_client_;
+  };
+
+  template <typename ServiceT>
+  using QueryHandler = bool (DashboardClientROS::*)(typename ServiceT::Request::SharedPtr,
+                                                    typename ServiceT::Response::SharedPtr);
+
+  /*!
+   * \brief Creates a service in callback_group_, so that service calls can be handled concurrently.
+   */
+  template <typename ServiceT, typename CallbackT>
+  typename rclcpp::Service<ServiceT>::SharedPtr createService(const std::string& name, CallbackT&& callback)
+  {
+    return node_->create_service<ServiceT>(name, std::forward<CallbackT>(callback), rmw_qos_profile_services_default,
+                                           callback_group_);
+  }
+
   inline rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr createDashboardTriggerSrv(const std::string& topic,
                                                                                       const std::string& command,
                                                                                       const std::string& expected)
   {
-    rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr service = node_->create_service<std_srvs::srv::Trigger>(
-        topic, [&, command, expected](const std::shared_ptr<std_srvs::srv::Trigger::Request> req,
-                                      const std::shared_ptr<std_srvs::srv::Trigger::Response> resp) {
+    // Compiled once here instead of on every call
+    const std::regex expected_regex(expected);
+    rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr service = createService<std_srvs::srv::Trigger>(
+        topic, [&, command, expected_regex](const std::shared_ptr<std_srvs::srv::Trigger::Request> req,
+                                            const std::shared_ptr<std_srvs::srv::Trigger::Response> resp) {
+          const StatusInvalidation invalidation(*this);
           try {
             resp->message = this->client_.sendAndReceive(command);
-            resp->success = std::regex_match(resp->message, std::regex(expected));
+            resp->success = std::regex_match(resp->message, expected_regex);
           } catch (const urcl::UrException& e) {
             RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
             resp->message = e.what();
@@ -115,10 +174,53 @@ private:
   bool handleRobotModeQuery(ur_dashboard_msgs::srv::GetRobotMode::Request::SharedPtr req,
                             ur_dashboard_msgs::srv::GetRobotMode::Response::SharedPtr resp);
 
+  bool handleProgramStateQuery(ur_dashboard_msgs::srv::GetProgramState::Request::SharedPtr req,
+                               ur_dashboard_msgs::srv::GetProgramState::Response::SharedPtr resp);
+
+  /*!
+   * \brief Answers a status query from the cache if the cached answer is recent enough, otherwise queries the
+   * dashboard server and updates the cache.
+   */
+  template <typename ServiceT>
+  void answerFromCache(CachedResponse<ServiceT>& cache, QueryHandler<ServiceT> query,
+                       typename ServiceT::Request::SharedPtr req, typename ServiceT::Response::SharedPtr resp);
+
+  /*!
+   * \brief Queries the dashboard server and stores the answer in \p cache, unless the status has been invalidated
+   * while the query was running.
+   */
+  template <typename ServiceT>
+  void refreshCache(CachedResponse<ServiceT>& cache, QueryHandler<ServiceT> query,
+                    typename ServiceT::Request::SharedPtr req, typename ServiceT::Response::SharedPtr resp);
+
+  /*!
+   * \brief Refreshes all cached status queries, called periodically with the configured status_poll_rate.
+   */
+  void pollStatus();
+
+  /*!
+   * \brief Publishes every cached status that changed since it has been published last.
+   */
+  void publishStatus();
+
+  /*!
+   * \brief Makes the next status queries go to the dashboard server, e.g. after a command that changes the status.
+   * Answers to queries that are already running aren't cached anymore.
+   */
+  void invalidateStatus();
+
+  /*!
+   * \brief Loads the program loaded last through this client again, if the robot doesn't have it loaded anymore after
+   * the connection has been re-established.
+   */
+  void resyncProgram();
+
   bool connect();
 
   std::shared_ptr<rclcpp::Node> node_;
-  urcl::DashboardClient client_;
+  // Reentrant, commands from concurrent service calls are pipelined by client_
+  rclcpp::CallbackGroup::SharedPtr callback_group_;
+  DashboardCommandExecutor client_;
 
   // Commanding services
   rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr brake_release_service_;
@@ -148,6 +250,32 @@ private:
   rclcpp::Service<ur_dashboard_msgs::srv::GetProgramState>::SharedPtr program_state_service_;
   rclcpp::Service<ur_dashboard_msgs::srv::GetSafetyMode>::SharedPtr safety_mode_service_;
   rclcpp::Service<ur_dashboard_msgs::srv::GetRobotMode>::SharedPtr robot_mode_service_;
+
+  // Status cache, refreshed by status_timer_ and by queries finding it outdated. The caches and the published status
+  // are guarded by status_mutex_.
+  std::mutex status_mutex_;
+  std::chrono::nanoseconds status_max_age_;
+  // Incremented by invalidateStatus(), answers are only cached if it didn't change while they were queried
+  uint64_t status_generation_ = 0;
+  rclcpp::TimerBase::SharedPtr status_timer_;
+  CachedResponse<ur_dashboard_msgs::srv::GetRobotMode> robot_mode_cache_;
+  CachedResponse<ur_dashboard_msgs::srv::GetSafetyMode> safety_mode_cache_;
+  CachedResponse<ur_dashboard_msgs::srv::IsProgramRunning> program_running_cache_;
+  CachedResponse<ur_dashboard_msgs::srv::GetProgramState> program_state_cache_;
+
+  // Latched status topics, only published on changes
+  rclcpp::Publisher<ur_dashboard_msgs::msg::RobotMode>::SharedPtr robot_mode_pub_;
+  rclcpp::Publisher<ur_dashboard_msgs::msg::SafetyMode>::SharedPtr safety_mode_pub_;
+  rclcpp::Publisher<std_msgs::msg::Bool>::SharedPtr program_running_pub_;
+  rclcpp::Publisher<ur_dashboard_msgs::msg::ProgramState>::SharedPtr program_state_pub_;
+  std::optional<ur_dashboard_msgs::msg::RobotMode> published_robot_mode_;
+  std::optional<ur_dashboard_msgs::msg::SafetyMode> published_safety_mode_;
+  std::optional<std_msgs::msg::Bool> published_program_running_;
+  std::optional<ur_dashboard_msgs::msg::ProgramState> published_program_state_;
+
+  // Re-synced by the status polling after client_ re-established a lost connection
+  std::atomic_bool resync_pending_ = false;
+  std::string loaded_program_;
 };
 }  // namespace ur_robot_driver
 
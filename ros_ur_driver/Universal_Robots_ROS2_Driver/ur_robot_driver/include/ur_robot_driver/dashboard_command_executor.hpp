@@ -0,0 +1,182 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__DASHBOARD_COMMAND_EXECUTOR_HPP_
+#define UR_ROBOT_DRIVER__DASHBOARD_COMMAND_EXECUTOR_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "ur_robot_driver/connection_recovery.hpp"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Sends commands to the robot's dashboard server on behalf of any number of threads.
+ *
+ * Commands are queued and written to the socket as soon as they are submitted, without waiting for the answers of
+ * the commands sent before. The dashboard server answers every command with a single line in the order the commands
+ * arrived, so answers are matched to commands in order.
+ *
+ * Every command has a deadline. If it passes before the answer arrived, the command fails. As the answer might still
+ * arrive later and would be matched to the wrong command, all commands sent on that connection fail as well and the
+ * connection is re-established. The same happens if the connection is lost. Commands that haven't been sent yet stay
+ * queued and are sent once the connection is back. Re-establishing the connection starts right away, failed attempts
+ * are retried with exponentially growing delays.
+ *
+ * All I/O happens in a single background thread.
+ */
+class DashboardCommandExecutor
+{
+public:
+  /*!
+   * \param host IP address or host name of the robot
+   * \param port Port of the dashboard server
+   * \param reconnect_interval Delay after the first failed attempt to re-establish a lost connection
+   * \param max_reconnect_interval Upper bound for the delay between two attempts
+   */
+  explicit DashboardCommandExecutor(const std::string& host, int port = 29999,
+                                    std::chrono::milliseconds reconnect_interval = std::chrono::milliseconds(500),
+                                    std::chrono::milliseconds max_reconnect_interval = std::chrono::seconds(8));
+  ~DashboardCommandExecutor();
+
+  DashboardCommandExecutor(const DashboardCommandExecutor&) = delete;
+  DashboardCommandExecutor& operator=(const DashboardCommandExecutor&) = delete;
+
+  /*!
+   * \brief Establishes the connection and keeps re-establishing it whenever it is lost, until disconnect() is called.
+   *
+   * \returns Whether the connection could be established right away
+   */
+  bool connect();
+
+  /*!
+   * \brief Closes the connection and fails all commands that haven't been answered yet.
+   */
+  void disconnect();
+
+  /*!
+   * \brief Sets the timeout used by sendAndReceive().
+   */
+  void setTimeout(std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Queues a command for sending.
+   *
+   * \param command Command to send, a trailing newline is added if missing
+   * \param timeout Time after which the command fails if it hasn't been answered
+   *
+   * \returns The answer without the trailing newline. Holds a urcl::UrException if the command failed.
+   */
+  std::future<std::string> submit(const std::string& command, std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Sends a command and waits for its answer, using the timeout given to setTimeout().
+   *
+   * \throws urcl::UrException if the command failed
+   */
+  std::string sendAndReceive(const std::string& command);
+
+  /*!
+   * \brief Sets a callback for re-syncing state after a lost connection has been re-established.
+   *
+   * The callback is called from the I/O thread, so it may submit commands but must not wait for their answers.
+   */
+  void setReconnectCallback(std::function<void()> callback);
+
+  /*!
+   * \brief Returns how often and how fast lost connections have been re-established.
+   */
+  RecoveryStatistics recoveryStatistics();
+
+private:
+  struct Request
+  {
+    std::string command;
+    std::chrono::steady_clock::time_point deadline;
+    std::promise<std::string> answer;
+  };
+
+  void run();
+  bool openConnection(std::chrono::milliseconds timeout);
+  bool sendAll(const std::string& data);
+
+  // Fails all commands sent on the current connection, needs mutex_ to be locked
+  void closeConnection(const std::string& reason);
+  // Closes the connection and starts re-establishing it, needs mutex_ to be locked
+  void connectionLost(const std::string& reason);
+  // Updates the backoff and statistics after an attempt to connect, needs mutex_ to be locked
+  void connectionAttempted(bool connected);
+  // Needs mutex_ to be locked
+  void failExpiredRequests(std::chrono::steady_clock::time_point now);
+  void wakeUp();
+
+  const std::string host_;
+  const int port_;
+
+  std::mutex mutex_;
+  std::deque<Request> queued_;
+  std::deque<Request> in_flight_;
+  bool keep_connected_ = false;
+  bool stop_ = false;
+  std::chrono::milliseconds timeout_{ 1000 };
+  std::chrono::steady_clock::time_point next_connect_attempt_;
+  ReconnectBackoff backoff_;
+  std::optional<std::chrono::steady_clock::time_point> connection_lost_since_;
+  RecoveryStatistics recovery_statistics_;
+  std::function<void()> reconnect_callback_;
+
+  // Result of an explicit connect() call, handed over from the I/O thread
+  bool connect_requested_ = false;
+  bool connect_result_ = false;
+  std::condition_variable connect_cv_;
+
+  // Only used by the I/O thread
+  int socket_fd_ = -1;
+  std::string receive_buffer_;
+
+  int wake_pipe_[2] = { -1, -1 };
+  std::thread thread_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__DASHBOARD_COMMAND_EXECUTOR_HPP_
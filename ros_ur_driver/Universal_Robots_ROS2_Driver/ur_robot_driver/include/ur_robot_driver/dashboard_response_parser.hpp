@@ -0,0 +1,266 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__DASHBOARD_RESPONSE_PARSER_HPP_
+#define UR_ROBOT_DRIVER__DASHBOARD_RESPONSE_PARSER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "ur_dashboard_msgs/msg/robot_mode.hpp"
+#include "ur_dashboard_msgs/msg/safety_mode.hpp"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Parsers for the dashboard server's answers, each matching exactly what the regular expression given in its
+ * description matches, without compiling or running a regex.
+ */
+namespace dashboard_parser
+{
+struct ModeName
+{
+  std::string_view name;
+  int value;
+};
+
+// Tables are sorted by name for the binary search in lookupMode()
+constexpr std::array<ModeName, 10> ROBOT_MODES = { {
+    { "BACKDRIVE", ur_dashboard_msgs::msg::RobotMode::BACKDRIVE },
+    { "BOOTING", ur_dashboard_msgs::msg::RobotMode::BOOTING },
+    { "CONFIRM_SAFETY", ur_dashboard_msgs::msg::RobotMode::CONFIRM_SAFETY },
+    { "DISCONNECTED", ur_dashboard_msgs::msg::RobotMode::DISCONNECTED },
+    { "IDLE", ur_dashboard_msgs::msg::RobotMode::IDLE },
+    { "NO_CONTROLLER", ur_dashboard_msgs::msg::RobotMode::NO_CONTROLLER },
+    { "POWER_OFF", ur_dashboard_msgs::msg::RobotMode::POWER_OFF },
+    { "POWER_ON", ur_dashboard_msgs::msg::RobotMode::POWER_ON },
+    { "RUNNING", ur_dashboard_msgs::msg::RobotMode::RUNNING },
+    { "UPDATING_FIRMWARE", ur_dashboard_msgs::msg::RobotMode::UPDATING_FIRMWARE },
+} };
+
+// AUTOMATIC_MODE_SAFEGUARD_STOP and SYSTEM_THREE_POSITION_ENABLING_STOP are only available in SafetyStatus from 5.5
+// on and therefore not part of this table.
+constexpr std::array<ModeName, 9> SAFETY_MODES = { {
+    { "FAULT", ur_dashboard_msgs::msg::SafetyMode::FAULT },
+    { "NORMAL", ur_dashboard_msgs::msg::SafetyMode::NORMAL },
+    { "PROTECTIVE_STOP", ur_dashboard_msgs::msg::SafetyMode::PROTECTIVE_STOP },
+    { "RECOVERY", ur_dashboard_msgs::msg::SafetyMode::RECOVERY },
+    { "REDUCED", ur_dashboard_msgs::msg::SafetyMode::REDUCED },
+    { "ROBOT_EMERGENCY_STOP", ur_dashboard_msgs::msg::SafetyMode::ROBOT_EMERGENCY_STOP },
+    { "SAFEGUARD_STOP", ur_dashboard_msgs::msg::SafetyMode::SAFEGUARD_STOP },
+    { "SYSTEM_EMERGENCY_STOP", ur_dashboard_msgs::msg::SafetyMode::SYSTEM_EMERGENCY_STOP },
+    { "VIOLATION", ur_dashboard_msgs::msg::SafetyMode::VIOLATION },
+} };
+
+// Sorted as well, matching the constants of ur_dashboard_msgs::msg::ProgramState
+constexpr std::array<std::string_view, 3> PROGRAM_STATES = { "PAUSED", "PLAYING", "STOPPED" };
+
+template <size_t N>
+constexpr bool isSortedByName(const std::array<ModeName, N>& table)
+{
+  for (size_t i = 1; i < N; ++i) {
+    if (!(table[i - 1].name < table[i].name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(isSortedByName(ROBOT_MODES), "ROBOT_MODES has to be sorted by name");
+static_assert(isSortedByName(SAFETY_MODES), "SAFETY_MODES has to be sorted by name");
+static_assert(PROGRAM_STATES[0] < PROGRAM_STATES[1] && PROGRAM_STATES[1] < PROGRAM_STATES[2],
+              "PROGRAM_STATES has to be sorted");
+
+/*!
+ * \brief Looks up the value of a mode by its name.
+ *
+ * \returns The mode's value or std::nullopt if \p name isn't part of \p table
+ */
+template <size_t N>
+constexpr std::optional<int> lookupMode(const std::array<ModeName, N>& table, std::string_view name)
+{
+  size_t first = 0;
+  size_t last = N;
+  while (first < last) {
+    const size_t mid = first + (last - first) / 2;
+    if (table[mid].name < name) {
+      first = mid + 1;
+    } else {
+      last = mid;
+    }
+  }
+  if (first < N && table[first].name == name) {
+    return table[first].value;
+  }
+  return std::nullopt;
+}
+
+static_assert(lookupMode(ROBOT_MODES, "RUNNING") == ur_dashboard_msgs::msg::RobotMode::RUNNING);
+static_assert(!lookupMode(ROBOT_MODES, "RUNNIN"));
+
+constexpr bool isProgramState(std::string_view name)
+{
+  for (const auto& state : PROGRAM_STATES) {
+    if (state == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief Matches ".+", i.e. at least one character and no line terminators.
+ */
+constexpr bool isRestOfLine(std::string_view text)
+{
+  return !text.empty() && text.find_first_of("\r\n") == std::string_view::npos;
+}
+
+/*!
+ * \brief Matches "[^\s]+", i.e. at least one character and no whitespace.
+ */
+constexpr bool isWord(std::string_view text)
+{
+  return !text.empty() && text.find_first_of(" \t\n\v\f\r") == std::string_view::npos;
+}
+
+/*!
+ * \brief Matches "<prefix>(.+)".
+ *
+ * \param value Set to the part following \p prefix on success
+ */
+constexpr bool parsePrefixed(std::string_view answer, std::string_view prefix, std::string_view& value)
+{
+  if (answer.substr(0, prefix.size()) != prefix || !isRestOfLine(answer.substr(prefix.size()))) {
+    return false;
+  }
+  value = answer.substr(prefix.size());
+  return true;
+}
+
+constexpr bool parsePrefixed(std::string_view answer, std::string_view prefix)
+{
+  std::string_view value;
+  return parsePrefixed(answer, prefix, value);
+}
+
+/*!
+ * \brief Matches "Program running: (true|false)".
+ */
+constexpr bool parseProgramRunning(std::string_view answer, bool& running)
+{
+  if (answer == "Program running: true") {
+    running = true;
+    return true;
+  }
+  if (answer == "Program running: false") {
+    running = false;
+    return true;
+  }
+  return false;
+}
+
+/*!
+ * \brief Matches "(true|false) ([^\s]+)".
+ */
+constexpr bool parseProgramSaved(std::string_view answer, bool& saved, std::string_view& program_name)
+{
+  std::string_view name;
+  if (parsePrefixed(answer, "true ", name) && isWord(name)) {
+    saved = true;
+  } else if (parsePrefixed(answer, "false ", name) && isWord(name)) {
+    saved = false;
+  } else {
+    return false;
+  }
+  program_name = name;
+  return true;
+}
+
+/*!
+ * \brief Matches "(STOPPED|PLAYING|PAUSED) (.+)".
+ */
+constexpr bool parseProgramState(std::string_view answer, std::string_view& state, std::string_view& program_name)
+{
+  // None of the states contains a space, so the state has to end at the first one
+  const size_t space = answer.find(' ');
+  if (space == std::string_view::npos || !isProgramState(answer.substr(0, space)) ||
+      !isRestOfLine(answer.substr(space + 1))) {
+    return false;
+  }
+  state = answer.substr(0, space);
+  program_name = answer.substr(space + 1);
+  return true;
+}
+
+/*!
+ * \brief Matches "Robotmode: (.+)".
+ *
+ * \param mode Set to the robot mode if it is a known one, left unchanged otherwise
+ */
+inline bool parseRobotMode(std::string_view answer, ur_dashboard_msgs::msg::RobotMode& mode)
+{
+  std::string_view name;
+  if (!parsePrefixed(answer, "Robotmode: ", name)) {
+    return false;
+  }
+  if (const auto value = lookupMode(ROBOT_MODES, name)) {
+    mode.mode = static_cast<int8_t>(*value);
+  }
+  return true;
+}
+
+/*!
+ * \brief Matches "Safetymode: (.+)".
+ *
+ * \param mode Set to the safety mode if it is a known one, left unchanged otherwise
+ */
+inline bool parseSafetyMode(std::string_view answer, ur_dashboard_msgs::msg::SafetyMode& mode)
+{
+  std::string_view name;
+  if (!parsePrefixed(answer, "Safetymode: ", name)) {
+    return false;
+  }
+  if (const auto value = lookupMode(SAFETY_MODES, name)) {
+    mode.mode = static_cast<uint8_t>(*value);
+  }
+  return true;
+}
+}  // namespace dashboard_parser
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__DASHBOARD_RESPONSE_PARSER_HPP_
@@ -40,7 +40,12 @@
 #define UR_ROBOT_DRIVER__HARDWARE_INTERFACE_HPP_
 
 // System
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <limits>
@@ -54,6 +59,8 @@
 // UR stuff
 #include "ur_client_library/ur/ur_driver.h"
 #include "ur_client_library/ur/robot_receive_timeout.h"
+#include "ur_client_library/rtde/rtde_client.h"
+#include "ur_robot_driver/connection_recovery.hpp"
 #include "ur_robot_driver/dashboard_client_ros.hpp"
 #include "ur_dashboard_msgs/msg/robot_mode.hpp"
 
@@ -61,8 +68,6 @@
 #include "rclcpp/macros.hpp"
 #include "rclcpp_lifecycle/node_interfaces/lifecycle_node_interface.hpp"
 #include "rclcpp_lifecycle/state.hpp"
-#include "geometry_msgs/msg/transform_stamped.hpp"
-#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
 namespace ur_robot_driver
 {
@@ -80,6 +85,32 @@ enum StoppingInterface
   STOP_VELOCITY
 };
 
+/*!
+ * \brief Selects which data is requested from the robot in the control loop's RTDE recipe.
+ */
+enum class RTDERecipeProfile
+{
+  FULL,   ///< Motion, IO, tool and safety data are read in every cycle
+  MOTION  ///< Only motion data is read in every cycle, IO, tool and safety data come from a separate low-rate recipe
+};
+
+/*!
+ * \brief Handshake states of the trajectory forwarding interface.
+ *
+ * The values are exchanged as doubles through the "transfer_state" command interface and have to match the ones used
+ * by the ScaledJointTrajectoryController.
+ */
+enum TrajectoryTransferState
+{
+  TRANSFER_IDLE = 0,
+  TRANSFER_START = 1,
+  TRANSFER_READY = 2,
+  TRANSFER_POINT = 3,
+  TRANSFER_DONE = 4,
+  TRANSFER_FAILED = 5,
+  TRANSFER_CANCEL = 6
+};
+
 /*!
  * \brief The HardwareInterface class handles the interface between the ROS system and the main
  * driver. It contains the read and write methods of the main control loop and registers various ROS
@@ -130,12 +161,70 @@ protected:
   void readBitsetData(const std::unique_ptr<urcl::rtde_interface::DataPackage>& data_pkg, const std::string& var_name,
                       std::bitset<N>& data);
 
+  /*!
+   * \brief Reads the IO, tool and safety data from a data package of either the control loop's or the low-rate
+   * RTDE recipe.
+   *
+   * \param data_pkg Data package containing the fields of the IO recipe
+   */
+  void readIOData(const std::unique_ptr<urcl::rtde_interface::DataPackage>& data_pkg);
+
+  /*!
+   * \brief Whether the IO, tool and safety state interfaces are backed by data from the robot.
+   */
+  bool hasIOData() const;
+
   void initAsyncIO();
+  /*!
+   * \brief Whether any of the async command interfaces holds a command the async thread didn't handle yet.
+   */
+  bool hasAsyncCommand() const;
+  /*!
+   * \brief Publishes the result of the IO commands the async thread sent and hands the next ones over to it.
+   *
+   * All IO command interfaces are copied at once within write(), so everything a controller wrote in one update()
+   * is sent together, e.g. an IO batch along with its sequence number.
+   */
+  void handOverIOCommand();
   void checkAsyncIO();
   void updateNonDoubleValues();
-  void extractToolPose();
+
+  /*!
+   * \brief Rotates the force-torque measurements from the robot's base frame into the TCP frame.
+   */
   void transformForceTorque();
 
+  /*!
+   * \brief Forwards the trajectory points handed over through the trajectory forwarding command interfaces to the
+   * robot, which interpolates them itself.
+   *
+   * Called from write() instead of sending a servoj setpoint as long as a trajectory is being forwarded.
+   */
+  void forwardTrajectory();
+
+  /*!
+   * \brief Callback for the robot reporting that a forwarded trajectory has been finished.
+   *
+   * \param result Result of the trajectory execution as reported by the robot.
+   */
+  void handleTrajectoryDone(urcl::control::TrajectoryResult result);
+
+  /*!
+   * \brief Updates the statistics describing how well the control loop is locked to the robot's RTDE packages.
+   *
+   * Uses the robot's timestamp of the current package to detect packages that have been skipped since the last
+   * read() and compares the time passed on the robot with the time passed on this machine.
+   */
+  void updateRTDESyncStatistics();
+
+  /*!
+   * \brief Re-creates the connection to the robot after read() didn't receive any RTDE data for reconnect_timeout.
+   *
+   * Called from the async thread, which owns the driver as long as reconnecting_ is set. Failed attempts are retried
+   * with exponentially growing delays. In headless mode the new driver sends the robot program again.
+   */
+  void reconnect();
+
   urcl::vector6d_t urcl_position_commands_;
   urcl::vector6d_t urcl_position_commands_old_;
   urcl::vector6d_t urcl_velocity_commands_;
@@ -147,6 +236,41 @@ protected:
 
   bool packet_read_;
 
+  // RTDE recipe profiles
+  RTDERecipeProfile rtde_recipe_profile_;
+  std::string io_output_recipe_filename_;
+  urcl::comm::INotifier io_rtde_notifier_;
+  std::unique_ptr<urcl::rtde_interface::RTDEClient> io_rtde_client_;
+  std::unique_ptr<urcl::rtde_interface::DataPackage> io_data_pkg_;
+  std::mutex io_data_mutex_;
+
+  // RTDE synchronization statistics
+  double rtde_timestamp_;
+  double rtde_period_;
+  double last_rtde_timestamp_;
+  std::chrono::steady_clock::time_point last_rtde_read_time_;
+  double rtde_packets_received_;
+  double rtde_missed_packets_;
+  double rtde_phase_error_;
+  double rtde_max_phase_error_;
+  bool rtde_sync_interrupted_;
+
+  // Connection recovery. While reconnecting_ is set, the control loop doesn't touch ur_driver_ and io_rtde_client_.
+  std::function<void()> create_driver_;
+  std::chrono::duration<double> reconnect_timeout_;
+  ReconnectBackoff reconnect_backoff_{ std::chrono::milliseconds(500), std::chrono::seconds(10) };
+  std::atomic_bool reconnecting_ = false;
+  // Held by reconnect() while replacing ur_driver_, for callers outside of read() and write(), which set reconnecting_
+  std::mutex driver_mutex_;
+  std::chrono::steady_clock::time_point last_rtde_package_time_;
+  std::chrono::steady_clock::time_point connection_lost_time_;
+  std::chrono::steady_clock::time_point next_reconnect_attempt_;
+  RecoveryStatistics recovery_statistics_;
+  double connection_connected_;
+  double connection_reconnects_;
+  double connection_last_recovery_time_;
+  double connection_max_recovery_time_;
+
   uint32_t runtime_state_;
   bool controllers_initialized_;
 
@@ -169,16 +293,13 @@ protected:
   std::bitset<4> robot_status_bits_;
   std::bitset<11> safety_status_bits_;
 
-  // transform stuff
-  tf2::Vector3 tcp_force_;
-  tf2::Vector3 tcp_torque_;
-  geometry_msgs::msg::TransformStamped tcp_transform_;
-
   // asynchronous commands
   std::array<double, 18> standard_dig_out_bits_cmd_;
   std::array<double, 2> standard_analog_output_cmd_;
   double tool_voltage_cmd_;
   double io_async_success_;
+  double io_batch_sequence_cmd_;
+  double io_batch_acknowledged_;
   double target_speed_fraction_cmd_;
   double scaling_async_success_;
   double resend_robot_program_cmd_;
@@ -191,6 +312,30 @@ protected:
   bool initialized_;
   double system_interface_initialized_;
   bool async_thread_shutdown_;
+  // The async thread sends the async commands. It polls every 20 ms, but write() wakes it up as soon as a command
+  // is pending. A command is therefore sent right after the control cycle that wrote it and acknowledged once the
+  // robot accepted it.
+  std::mutex async_thread_mutex_;
+  std::condition_variable async_thread_cv_;
+  std::atomic_bool async_command_pending_ = false;
+
+  // IO commands handed over from write() to the async thread. Whoever io_command_state_ points to owns io_command_.
+  enum class IOCommandState
+  {
+    IDLE,     // write() may hand over the next commands
+    SENDING,  // the async thread sends io_command_
+    SENT,     // write() publishes the result
+  };
+  struct IOCommand
+  {
+    std::array<double, 18> digital_outputs;
+    std::array<double, 2> analog_outputs;
+    double tool_voltage;
+    double batch_sequence;
+    bool success;
+  };
+  IOCommand io_command_;
+  std::atomic<IOCommandState> io_command_state_ = IOCommandState::IDLE;
 
   // payload stuff
   urcl::vector3d_t payload_center_of_gravity_;
@@ -209,6 +354,14 @@ protected:
   std::array<double, 4> robot_status_bits_copy_;
   std::array<double, 11> safety_status_bits_copy_;
 
+  // raw values of the bitsets at their last expansion into the copies above
+  uint64_t actual_dig_out_bits_word_;
+  uint64_t actual_dig_in_bits_word_;
+  uint64_t analog_io_types_word_;
+  uint64_t tool_analog_input_types_word_;
+  uint64_t robot_status_bits_word_;
+  uint64_t safety_status_bits_word_;
+
   bool robot_program_running_;
   bool non_blocking_read_;
   double robot_program_running_copy_;
@@ -221,6 +374,20 @@ protected:
   std::vector<std::string> start_modes_;
   bool position_controller_running_;
   bool velocity_controller_running_;
+  bool trajectory_forwarding_running_;
+  bool start_trajectory_forwarding_;
+  bool stop_trajectory_forwarding_;
+
+  // trajectory forwarding
+  urcl::vector6d_t trajectory_positions_;
+  urcl::vector6d_t trajectory_velocities_;
+  urcl::vector6d_t trajectory_accelerations_;
+  double trajectory_time_from_start_;
+  double trajectory_point_count_;
+  double trajectory_transfer_state_;
+  double last_forwarded_time_from_start_;
+  std::atomic_bool trajectory_done_ = false;
+  std::atomic<urcl::control::TrajectoryResult> trajectory_result_;
 
   std::unique_ptr<urcl::UrDriver> ur_driver_;
   std::shared_ptr<std::thread> async_thread_;
@@ -228,6 +395,8 @@ protected:
   std::atomic_bool rtde_comm_has_been_started_ = false;
 
   urcl::RobotReceiveTimeout receive_timeout_ = urcl::RobotReceiveTimeout::millisec(20);
+  // While forwarding a trajectory the robot interpolates on its own, so a stalled control loop must not stop it
+  urcl::RobotReceiveTimeout trajectory_receive_timeout_ = urcl::RobotReceiveTimeout::off();
 };
 }  // namespace ur_robot_driver
 
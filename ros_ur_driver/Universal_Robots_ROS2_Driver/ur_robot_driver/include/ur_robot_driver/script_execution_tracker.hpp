@@ -0,0 +1,154 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__SCRIPT_EXECUTION_TRACKER_HPP_
+#define UR_ROBOT_DRIVER__SCRIPT_EXECUTION_TRACKER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Robot message from the primary interface that is relevant for following script execution.
+ */
+struct PrimaryRobotMessage
+{
+  enum class Type
+  {
+    TEXT,              ///< Message of textmsg()
+    RUNTIME_EXCEPTION  ///< Error compiling or running a program
+  };
+
+  Type type;
+  std::string text;
+  int32_t line = 0;
+  int32_t column = 0;
+};
+
+/*!
+ * \brief Follows URScript snippets from being submitted until the robot reports that they have been executed.
+ *
+ * The snippets are wrapped by textmsg() calls containing the execution's id, which appear as text messages on the
+ * robot's primary interface once the robot gets to them. A runtime exception reported meanwhile is attributed to the
+ * oldest execution that has been sent but not finished, as the primary interface doesn't tell which program raised it.
+ * Each execution should therefore be sent as a program of its own, or the others in an aborted program never finish.
+ */
+class ScriptExecutionTracker
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class State
+  {
+    QUEUED,    ///< Waiting for being sent to the robot
+    SENT,      ///< Sent to the robot
+    STARTED,   ///< The robot started executing the snippets
+    FINISHED,  ///< The robot executed all snippets
+    FAILED     ///< Sending or executing the snippets failed
+  };
+
+  struct Execution
+  {
+    State state = State::QUEUED;
+    std::string message;
+    Clock::time_point submitted;
+    Clock::time_point sent;
+    Clock::time_point started;
+    Clock::time_point finished;
+  };
+
+  /*!
+   * \brief Registers a new execution and returns its id.
+   */
+  uint64_t add();
+
+  /*!
+   * \brief Returns the snippets to be run for an execution, wrapped by the calls reporting its progress.
+   */
+  static std::vector<std::string> wrapSnippets(uint64_t id, const std::vector<std::string>& snippets);
+
+  /*!
+   * \brief Records that sending an execution's snippets to the robot succeeded or failed with the given message.
+   */
+  void markSent(uint64_t id, bool success, const std::string& message);
+
+  /*!
+   * \brief Updates the executions with a message received from the primary interface.
+   */
+  void handleMessage(const PrimaryRobotMessage& message);
+
+  /*!
+   * \brief Waits until an execution's state differs from the given one or the deadline passed.
+   *
+   * \returns The execution as it is after waiting
+   */
+  Execution waitForChange(uint64_t id, State known_state, Clock::time_point deadline);
+
+  /*!
+   * \brief Forgets about an execution, messages arriving for it afterwards are ignored.
+   */
+  void remove(uint64_t id);
+
+  /*!
+   * \brief Fails all unfinished executions and the ones added afterwards, waking up everyone waiting for them.
+   */
+  void shutdown();
+
+  /*!
+   * \brief Parses a package read from the primary interface, header included.
+   *
+   * \returns The robot message, or nothing if the package is no text message or runtime exception
+   */
+  static std::optional<PrimaryRobotMessage> parseRobotMessage(const uint8_t* data, size_t size);
+
+private:
+  std::mutex mutex_;
+  std::condition_variable changed_cv_;
+  uint64_t next_id_ = 0;
+  bool shut_down_ = false;
+  // Ordered by id and thereby by submission, so the first unfinished one is the oldest
+  std::map<uint64_t, Execution> executions_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__SCRIPT_EXECUTION_TRACKER_HPP_
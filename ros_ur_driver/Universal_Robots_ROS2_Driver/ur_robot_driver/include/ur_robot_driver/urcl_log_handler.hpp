@@ -43,7 +43,14 @@
 #ifndef UR_ROBOT_DRIVER__URCL_LOG_HANDLER_HPP_
 #define UR_ROBOT_DRIVER__URCL_LOG_HANDLER_HPP_
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <thread>
+
+#include "rcutils/logging.h"
 #include "ur_client_library/log.h"
 namespace ur_robot_driver
 {
@@ -51,8 +58,15 @@ namespace ur_robot_driver
 /*!
  * \brief Register the UrclLoghHandler, this will start logging messages from the client library with ROS2 logging.
  * This function has to be called inside your node, to enable the log handler.
+ *
+ * Messages are forwarded according to the current level of the "UR_Client_Library:<tf_prefix>" ROS logger, which
+ * can be changed at runtime, e.g. with "--ros-args --log-level UR_Client_Library:=debug".
+ *
+ * \param tf_prefix Appended to the logger name "UR_Client_Library:"
+ * \param log_level Lowest severity the client library formats messages for, as a ROS severity name like "info".
+ * Raising it saves formatting messages that are never shown, but they can't be enabled at runtime anymore then.
  */
-void registerUrclLogHandler(const std::string& tf_prefix = "");
+void registerUrclLogHandler(const std::string& tf_prefix = "", const std::string& log_level = "debug");
 
 /*!
  * \brief Unregister the UrclLoghHandler, stop logging messages from the client library with ROS2 logging.
@@ -62,15 +76,26 @@ void unregisterUrclLogHandler();
 /*!
  * \brief Loghandler for handling messages logged with the C++ client library. This loghandler will log the messages
  * from the client library with ROS2s logging.
+ *
+ * Messages are copied into a fixed-size lock-free queue and handed to ROS2 logging by a background thread, so the
+ * client library's communication threads neither allocate nor block on the logging backend. If the queue is full,
+ * messages get dropped and counted.
  * Use registerLogHandler to register this LogHandler. This class shouldn't be instantiated directly.
  */
 class UrclLogHandler : public urcl::LogHandler
 {
 public:
   /*!
-   * \brief Default constructor
+   * \brief Constructor, starts the thread forwarding the messages to ROS2 logging
+   *
+   * \param tf_prefix Appended to the logger name "UR_Client_Library:"
+   */
+  explicit UrclLogHandler(const std::string& tf_prefix = "");
+
+  /*!
+   * \brief Forwards all queued messages and stops the background thread
    */
-  UrclLogHandler();
+  ~UrclLogHandler() override;
 
   /*!
    * \brief Function to log a message
@@ -91,20 +116,57 @@ public:
     return tf_prefix_;
   }
 
-private:
-  std::string tf_prefix_{};
-
   /**
-   * @brief setTFPrefix - set the tf_prefix the logger will append to the node name
-   * @param tf_prefix
+   * @brief getDroppedMessages - obtain the number of messages dropped because the queue was full
+   * @return
    */
-  void setTFPrefix(const std::string& tf_prefix)
+  uint64_t getDroppedMessages() const
   {
-    tf_prefix_ = tf_prefix;
+    return dropped_messages_;
   }
 
-  // Declare the register method as a friend so that we can access setTFPrefix from it
-  friend void registerUrclLogHandler(const std::string& tf_prefix);
+  static constexpr size_t QUEUE_SIZE = 256;
+  static constexpr size_t MAX_MESSAGE_LENGTH = 512;
+
+private:
+  struct Entry
+  {
+    const char* file;
+    int line;
+    int severity;
+    char message[MAX_MESSAGE_LENGTH];
+  };
+
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    Entry entry;
+  };
+
+  /**
+   * @brief logQueued - hands all queued messages to ROS2 logging
+   * @return Whether any message was queued
+   */
+  bool logQueued();
+
+  void run();
+
+  const std::string tf_prefix_;
+  const std::string logger_name_;
+
+  // Bounded multi-producer queue, only the background thread consumes
+  std::array<Slot, QUEUE_SIZE> slots_;
+  std::atomic<size_t> enqueue_pos_{ 0 };
+  size_t dequeue_pos_{ 0 };
+
+  std::atomic<uint64_t> dropped_messages_{ 0 };
+  uint64_t reported_dropped_messages_{ 0 };
+
+  std::atomic<bool> running_{ true };
+  std::thread thread_;
+
+  // Declare the register method as a friend so that we can access the logger name from it
+  friend void registerUrclLogHandler(const std::string& tf_prefix, const std::string& log_level);
 };
 
 }  // namespace ur_robot_driver
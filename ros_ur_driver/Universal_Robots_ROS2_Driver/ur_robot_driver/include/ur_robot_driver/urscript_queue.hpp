@@ -0,0 +1,169 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__URSCRIPT_QUEUE_HPP_
+#define UR_ROBOT_DRIVER__URSCRIPT_QUEUE_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief URScript with numbered placeholders like {0}, {1}, split into its parts once for filling in values fast.
+ *
+ * URScript doesn't use curly braces, so they can't clash with the script itself.
+ */
+class URScriptTemplate
+{
+public:
+  /*!
+   * \throws std::invalid_argument if a placeholder isn't closed or doesn't contain a number
+   */
+  explicit URScriptTemplate(const std::string& text);
+
+  /*!
+   * \brief Returns the script with every placeholder replaced by the value with its number.
+   *
+   * \throws std::invalid_argument if there are fewer values than the template needs
+   */
+  std::string fill(const std::vector<std::string>& values) const;
+
+  /*!
+   * \brief Number of values needed for filling in the template.
+   */
+  size_t parameterCount() const
+  {
+    return parameter_count_;
+  }
+
+private:
+  // literals_[i] is followed by the value of placeholders_[i], the last literal is followed by nothing
+  std::vector<std::string> literals_;
+  std::vector<size_t> placeholders_;
+  size_t parameter_count_ = 0;
+  size_t literal_size_ = 0;
+};
+
+/*!
+ * \brief Bounded queue of URScript to be sent to the robot's secondary interface by a background thread.
+ *
+ * Programs are sent as they are, one after the other. Snippets are wrapped into secondary programs, and consecutive
+ * snippet submissions are merged into the same secondary program unless they asked for their own one. That saves the
+ * robot from compiling a program for every single snippet. Once the queue is full, submissions are rejected instead
+ * of piling up, so callers notice that the robot can't keep up.
+ */
+class URScriptQueue
+{
+public:
+  enum class DeliveryStatus
+  {
+    SENT,         ///< Written to the robot
+    QUEUE_FULL,   ///< Rejected as the queue was full
+    SEND_FAILED,  ///< Writing to the robot failed
+    SHUT_DOWN     ///< The queue has been destroyed before sending
+  };
+
+  /*!
+   * \brief Writes a complete program to the robot and returns whether that succeeded.
+   */
+  using WriteFunction = std::function<bool(const std::string& program)>;
+
+  /*!
+   * \param write Function writing to the robot, only called from the queue's thread
+   * \param capacity Number of submissions that can wait for being sent
+   * \param max_batch_snippets Number of snippets after which no further submissions are merged into a secondary
+   * program
+   */
+  URScriptQueue(WriteFunction write, size_t capacity, size_t max_batch_snippets);
+  ~URScriptQueue();
+
+  URScriptQueue(const URScriptQueue&) = delete;
+  URScriptQueue& operator=(const URScriptQueue&) = delete;
+
+  /*!
+   * \brief Queues a program, which is sent as it is.
+   */
+  std::future<DeliveryStatus> submitProgram(std::string program);
+
+  /*!
+   * \brief Queues snippets to be run in a secondary program, in the given order.
+   *
+   * \param own_program Don't merge the snippets with other submissions, e.g. so that an error in the program can be
+   * attributed to them
+   */
+  std::future<DeliveryStatus> submitSnippets(const std::vector<std::string>& snippets, bool own_program = false);
+
+  /*!
+   * \brief Number of submissions waiting for being sent.
+   */
+  size_t size();
+
+  static std::string toString(DeliveryStatus status);
+
+private:
+  struct Submission
+  {
+    bool is_program;
+    // The program or the snippets indented for the secondary program's body
+    std::string text;
+    size_t snippet_count;
+    bool own_program;
+    std::promise<DeliveryStatus> delivered;
+  };
+
+  std::future<DeliveryStatus> submit(Submission submission);
+  void run();
+
+  WriteFunction write_;
+  const size_t capacity_;
+  const size_t max_batch_snippets_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<Submission> queue_;
+  bool stop_ = false;
+  std::thread thread_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__URSCRIPT_QUEUE_HPP_
@@ -0,0 +1,70 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef UR_ROBOT_DRIVER__WRENCH_TRANSFORM_HPP_
+#define UR_ROBOT_DRIVER__WRENCH_TRANSFORM_HPP_
+
+#include <Eigen/Geometry>
+
+#include "ur_client_library/types.h"
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Rotates a wrench given in the robot's base frame into the frame of the TCP.
+ *
+ * The rotation is built directly from the axis-angle representation the robot reports for the TCP pose and applied
+ * to force and torque at once.
+ *
+ * \param tcp_pose TCP pose as reported by the robot (x, y, z, rx, ry, rz)
+ * \param wrench Force and torque (fx, fy, fz, tx, ty, tz), rotated in place
+ */
+inline void rotateWrenchIntoTool(const urcl::vector6d_t& tcp_pose, urcl::vector6d_t& wrench)
+{
+  const Eigen::Vector3d rotation_vec(tcp_pose[3], tcp_pose[4], tcp_pose[5]);
+  const double angle = rotation_vec.norm();
+  if (angle <= 1e-16) {
+    return;
+  }
+
+  const Eigen::Matrix3d rotation = Eigen::AngleAxisd(angle, rotation_vec / angle).toRotationMatrix();
+
+  // Force and torque are the two columns of a 3x2 matrix, so both get rotated by a single product
+  Eigen::Map<Eigen::Matrix<double, 3, 2>> wrench_mat(wrench.data());
+  wrench_mat = rotation.transpose() * wrench_mat;
+}
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__WRENCH_TRANSFORM_HPP_
@@ -82,6 +82,13 @@ def launch_setup(context, *args, **kwargs):
     reverse_port = LaunchConfiguration("reverse_port")
     script_sender_port = LaunchConfiguration("script_sender_port")
     trajectory_port = LaunchConfiguration("trajectory_port")
+    rtde_recipe_profile = LaunchConfiguration("rtde_recipe_profile")
+    io_rtde_frequency = LaunchConfiguration("io_rtde_frequency")
+    reconnect_timeout = LaunchConfiguration("reconnect_timeout")
+    reconnect_max_interval = LaunchConfiguration("reconnect_max_interval")
+    urcl_log_level = LaunchConfiguration("urcl_log_level")
+    non_blocking_read = LaunchConfiguration("non_blocking_read")
+    rtde_synchronized = LaunchConfiguration("rtde_synchronized")
 
     joint_limit_params = PathJoinSubstitution(
         [FindPackageShare(description_package), "config", ur_type, "joint_limits.yaml"]
@@ -98,8 +105,19 @@ def launch_setup(context, *args, **kwargs):
     input_recipe_filename = PathJoinSubstitution(
         [FindPackageShare("ur_robot_driver"), "resources", "rtde_input_recipe.txt"]
     )
+    # The motion profile only requests joint data in the control loop, IO data is requested at a low rate
+    if rtde_recipe_profile.perform(context) == "motion":
+        output_recipe = "rtde_motion_output_recipe.txt"
+    else:
+        output_recipe = "rtde_output_recipe.txt"
     output_recipe_filename = PathJoinSubstitution(
-        [FindPackageShare("ur_robot_driver"), "resources", "rtde_output_recipe.txt"]
+        [FindPackageShare("ur_robot_driver"), "resources", output_recipe]
+    )
+    io_input_recipe_filename = PathJoinSubstitution(
+        [FindPackageShare("ur_robot_driver"), "resources", "rtde_io_input_recipe.txt"]
+    )
+    io_output_recipe_filename = PathJoinSubstitution(
+        [FindPackageShare("ur_robot_driver"), "resources", "rtde_io_output_recipe.txt"]
     )
 
     robot_description_content = Command(
@@ -198,6 +216,30 @@ def launch_setup(context, *args, **kwargs):
             "trajectory_port:=",
             trajectory_port,
             " ",
+            "non_blocking_read:=",
+            non_blocking_read,
+            " ",
+            "rtde_recipe_profile:=",
+            rtde_recipe_profile,
+            " ",
+            "io_input_recipe_filename:=",
+            io_input_recipe_filename,
+            " ",
+            "io_output_recipe_filename:=",
+            io_output_recipe_filename,
+            " ",
+            "io_rtde_frequency:=",
+            io_rtde_frequency,
+            " ",
+            "reconnect_timeout:=",
+            reconnect_timeout,
+            " ",
+            "reconnect_max_interval:=",
+            reconnect_max_interval,
+            " ",
+            "urcl_log_level:=",
+            urcl_log_level,
+            " ",
         ]
     )
     robot_description = {
@@ -240,6 +282,7 @@ def launch_setup(context, *args, **kwargs):
             robot_description,
             update_rate_config_file,
             ParameterFile(initial_joint_controllers, allow_substs=True),
+            {"rtde_synchronized": ParameterValue(rtde_synchronized, value_type=bool)},
         ],
         output="screen",
         condition=UnlessCondition(use_fake_hardware),
@@ -338,7 +381,7 @@ def launch_setup(context, *args, **kwargs):
         "speed_scaling_state_broadcaster",
         "force_torque_sensor_broadcaster",
     ]
-    controllers_inactive = ["forward_position_controller"]
+    controllers_inactive = ["forward_position_controller", "forwarding_joint_trajectory_controller"]
 
     controller_spawners = [controller_spawner(controllers_active)] + [
         controller_spawner(controllers_inactive, active=False)
@@ -634,4 +677,56 @@ def generate_launch_description():
             description="Port that will be opened for trajectory control.",
         )
     )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "rtde_recipe_profile",
+            default_value="full",
+            description="RTDE data read in every control cycle. 'motion' reads IO, tool and safety data at a low rate.",
+            choices=["full", "motion"],
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "io_rtde_frequency",
+            default_value="10",
+            description="Frequency in Hz at which IO, tool and safety data is read with the 'motion' profile.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "reconnect_timeout",
+            default_value="0.0",
+            description="Seconds without data from the robot after which the connection is re-established, "
+            "0 disables reconnecting.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "reconnect_max_interval",
+            default_value="10.0",
+            description="Upper bound in seconds for the delay between two reconnection attempts.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "urcl_log_level",
+            default_value="debug",
+            description="Lowest severity for which the client library formats log messages.",
+            choices=["debug", "info", "warn", "error", "fatal"],
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "non_blocking_read",
+            default_value="true",
+            description="Return from the hardware's read() without waiting for the next RTDE package.",
+        )
+    )
+    declared_arguments.append(
+        DeclareLaunchArgument(
+            "rtde_synchronized",
+            default_value="false",
+            description="Pace the control loop by the robot's RTDE packages. Requires non_blocking_read:=false.",
+        )
+    )
     return LaunchDescription(declared_arguments + [OpaqueFunction(function=launch_setup)])
@@ -38,6 +38,8 @@
  */
 //----------------------------------------------------------------------
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,8 +48,25 @@
 
 #include "ur_robot_driver/controller_stopper.hpp"
 
+namespace
+{
+// Period of refreshing the cached controller states, as the controller manager doesn't announce changes
+constexpr std::chrono::seconds REFRESH_PERIOD(1);
+// Time after which an unanswered list request is given up, e.g. because the controller manager restarted
+constexpr std::chrono::seconds LIST_TIMEOUT(5);
+}  // namespace
+
 ControllerStopper::ControllerStopper(const rclcpp::Node::SharedPtr& node, bool stop_controllers_on_startup)
-  : node_(node), stop_controllers_on_startup_(stop_controllers_on_startup), robot_running_(true)
+  : node_(node)
+  , controllers_known_(false)
+  , list_pending_(false)
+  , switch_count_(0)
+  , stop_pending_(stop_controllers_on_startup)
+  , wait_for_stoppable_(stop_controllers_on_startup)
+  , stop_retried_(false)
+  , stop_requested_(std::chrono::steady_clock::now())
+  , stop_controllers_on_startup_(stop_controllers_on_startup)
+  , robot_running_(!stop_controllers_on_startup)
 {
   // Subscribes to a robot's running state topic. Ideally this topic is latched and only publishes
   // on changes. However, this node only reacts on state changes, so a state published each cycle
@@ -63,118 +82,155 @@ ControllerStopper::ControllerStopper(const rclcpp::Node::SharedPtr& node, bool s
   controller_list_srv_ = node_->create_client<controller_manager_msgs::srv::ListControllers>("controller_manager/"
                                                                                              "list_controllers");
 
-  RCLCPP_INFO(rclcpp::get_logger("Controller stopper"), "Waiting for switch controller service to come up on "
-                                                        "controller_manager/switch_controller");
-  controller_manager_srv_->wait_for_service();
-  RCLCPP_INFO(rclcpp::get_logger("Controller stopper"), "Service available");
-  RCLCPP_INFO(rclcpp::get_logger("Controller stopper"), "Waiting for list controllers service to come up on "
-                                                        "controller_manager/list_controllers");
-  controller_list_srv_->wait_for_service();
-  RCLCPP_INFO(rclcpp::get_logger("Controller stopper"), "Service available");
-
   consistent_controllers_ = node_->declare_parameter<std::vector<std::string>>("consistent_controllers");
 
-  if (stop_controllers_on_startup_ == true) {
-    while (stopped_controllers_.empty()) {
-      auto request = std::make_shared<controller_manager_msgs::srv::ListControllers::Request>();
-      auto future = controller_list_srv_->async_send_request(request);
-      rclcpp::spin_until_future_complete(node_, future);
-      auto result = future.get();
-      for (auto& controller : result->controller) {
-        // Check if in consistent_controllers
-        // Else:
-        //   Add to stopped_controllers
-        if (controller.state == "active") {
-          auto it = std::find(consistent_controllers_.begin(), consistent_controllers_.end(), controller.name);
-          if (it == consistent_controllers_.end()) {
-            stopped_controllers_.push_back(controller.name);
-          }
-        }
-      }
-      rclcpp::sleep_for(std::chrono::milliseconds(100));
-    }
-    auto request_switch_controller = std::make_shared<controller_manager_msgs::srv::SwitchController::Request>();
-    request_switch_controller->strictness = request_switch_controller->STRICT;
-    request_switch_controller->deactivate_controllers = stopped_controllers_;
-    auto future = controller_manager_srv_->async_send_request(request_switch_controller);
-    rclcpp::spin_until_future_complete(node_, future);
-    if (future.get()->ok == false) {
-      RCLCPP_ERROR(rclcpp::get_logger("Controller stopper"), "Could not deactivate requested controllers");
-    }
-    robot_running_ = false;
-  }
+  prepareStopRequest();
+
+  // Controllers on startup are stopped as soon as the controller manager lists stoppable ones, without blocking
+  // until its services are available
+  refresh_timer_ = node_->create_wall_timer(REFRESH_PERIOD, [this]() { refreshControllers(); });
+  refreshControllers();
 }
 
-void ControllerStopper::findAndStopControllers()
+void ControllerStopper::refreshControllers()
 {
-  stopped_controllers_.clear();
-  auto request_switch_controller = std::make_shared<controller_manager_msgs::srv::SwitchController::Request>();
-  auto request_list_controllers = std::make_shared<controller_manager_msgs::srv::ListControllers::Request>();
+  const auto now = std::chrono::steady_clock::now();
+  if ((list_pending_ && now - list_requested_ < LIST_TIMEOUT) || !controller_list_srv_->service_is_ready()) {
+    return;
+  }
+  list_pending_ = true;
+  list_requested_ = now;
 
-  // Callback to switch controllers
-  auto callback_switch_controller =
-      [this](rclcpp::Client<controller_manager_msgs::srv::SwitchController>::SharedFuture future_response) {
-        auto result = future_response.get();
-        if (result->ok == false) {
-          RCLCPP_ERROR(rclcpp::get_logger("Controller stopper"), "Could not deactivate requested controllers");
-        }
-      };
+  auto request = std::make_shared<controller_manager_msgs::srv::ListControllers::Request>();
+  const uint64_t switch_count = switch_count_;
 
   // Callback to list controllers
   auto callback_list_controller =
-      [this, request_switch_controller, callback_switch_controller](
+      [this, switch_count](
           rclcpp::Client<controller_manager_msgs::srv::ListControllers>::SharedFuture future_response) {
-        auto result = future_response.get();
-        for (auto& controller : result->controller) {
-          // Check if in consistent_controllers
-          // Else:
-          //   Add to stopped_controllers
-          if (controller.state == "active") {
-            auto it = std::find(consistent_controllers_.begin(), consistent_controllers_.end(), controller.name);
-            if (it == consistent_controllers_.end()) {
-              stopped_controllers_.push_back(controller.name);
-            }
-          }
-        }
-        request_switch_controller->strictness = request_switch_controller->STRICT;
-        if (!stopped_controllers_.empty()) {
-          request_switch_controller->deactivate_controllers = stopped_controllers_;
-          auto future =
-              controller_manager_srv_->async_send_request(request_switch_controller, callback_switch_controller);
+        list_pending_ = false;
+        if (switch_count != switch_count_) {
+          // Listed before the last switch, so the states might be outdated already
+          refreshControllers();
+          return;
         }
+        controllersListed(*future_response.get());
       };
+  controller_list_srv_->async_send_request(request, callback_list_controller);
+}
+
+void ControllerStopper::controllersListed(const controller_manager_msgs::srv::ListControllers::Response& response)
+{
+  stoppable_controllers_.clear();
+  for (auto& controller : response.controller) {
+    // Check if in consistent_controllers
+    // Else:
+    //   Add to stoppable_controllers
+    if (controller.state == "active") {
+      auto it = std::find(consistent_controllers_.begin(), consistent_controllers_.end(), controller.name);
+      if (it == consistent_controllers_.end()) {
+        stoppable_controllers_.push_back(controller.name);
+      }
+    }
+  }
+  // Prepared here, so stopping only has to send it
+  prepareStopRequest();
+  controllers_known_ = true;
 
-  auto future = controller_list_srv_->async_send_request(request_list_controllers, callback_list_controller);
+  if (stop_pending_ && !(wait_for_stoppable_ && stoppable_controllers_.empty())) {
+    stopControllers();
+  }
+}
+
+void ControllerStopper::stopControllers()
+{
+  if (!controllers_known_ || !controller_manager_srv_->service_is_ready()) {
+    stop_pending_ = true;
+    refreshControllers();
+    return;
+  }
+  stop_pending_ = false;
+  wait_for_stoppable_ = false;
+  stopped_controllers_ = stoppable_controllers_;
+  if (stopped_controllers_.empty()) {
+    return;
+  }
+
+  // Callback to switch controllers
+  auto callback = [this](rclcpp::Client<controller_manager_msgs::srv::SwitchController>::SharedFuture future_response) {
+    auto result = future_response.get();
+    if (result->ok) {
+      stop_retried_ = false;
+      const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - stop_requested_;
+      RCLCPP_INFO(rclcpp::get_logger("Controller stopper"), "Deactivated controllers within %.1f ms", elapsed.count());
+    } else if (!stop_retried_ && !robot_running_) {
+      // The cached states might have been outdated, so try again with the current ones
+      RCLCPP_WARN(rclcpp::get_logger("Controller stopper"), "Could not deactivate requested controllers, retrying");
+      stop_retried_ = true;
+      stop_pending_ = true;
+      controllers_known_ = false;
+    } else {
+      stop_retried_ = false;
+      RCLCPP_ERROR(rclcpp::get_logger("Controller stopper"), "Could not deactivate requested controllers");
+    }
+    refreshControllers();
+  };
+
+  ++switch_count_;
+  controller_manager_srv_->async_send_request(stop_request_, callback);
+
+  // The stopped controllers aren't active anymore, which the next refresh will confirm
+  stoppable_controllers_.clear();
+  prepareStopRequest();
 }
 
 void ControllerStopper::startControllers()
 {
+  // A stop that hasn't happened yet isn't needed anymore
+  stop_pending_ = false;
+  wait_for_stoppable_ = false;
+
   // Callback to switch controllers
   auto callback = [this](rclcpp::Client<controller_manager_msgs::srv::SwitchController>::SharedFuture future_response) {
     auto result = future_response.get();
     if (result->ok == false) {
       RCLCPP_ERROR(rclcpp::get_logger("Controller stopper"), "Could not activate requested controllers");
     }
+    refreshControllers();
   };
   if (!stopped_controllers_.empty()) {
     auto request = std::make_shared<controller_manager_msgs::srv::SwitchController::Request>();
     request->strictness = request->STRICT;
     request->activate_controllers = stopped_controllers_;
+    ++switch_count_;
     auto future = controller_manager_srv_->async_send_request(request, callback);
+
+    // The started controllers are active again, so they're stopped even if the program stops before the next refresh
+    stoppable_controllers_ = stopped_controllers_;
+    prepareStopRequest();
   }
 }
 
+void ControllerStopper::prepareStopRequest()
+{
+  stop_request_ = std::make_shared<controller_manager_msgs::srv::SwitchController::Request>();
+  stop_request_->strictness = stop_request_->STRICT;
+  stop_request_->deactivate_controllers = stoppable_controllers_;
+}
+
 void ControllerStopper::robotRunningCallback(const std_msgs::msg::Bool::ConstSharedPtr msg)
 {
   RCLCPP_DEBUG(rclcpp::get_logger("Controller stopper"), "robotRunningCallback with data %d", msg->data);
 
   if (msg->data && !robot_running_) {
     RCLCPP_DEBUG(rclcpp::get_logger("Controller stopper"), "Starting controllers");
+    robot_running_ = true;
     startControllers();
   } else if (!msg->data && robot_running_) {
     RCLCPP_DEBUG(rclcpp::get_logger("Controller stopper"), "Stopping controllers");
+    robot_running_ = false;
+    stop_requested_ = std::chrono::steady_clock::now();
     // stop all controllers except the once in consistent_controllers_
-    findAndStopControllers();
+    stopControllers();
   }
-  robot_running_ = msg->data;
 }
@@ -55,7 +55,10 @@ int main(int argc, char** argv)
 
   ur_robot_driver::DashboardClientROS client(node, robot_ip);
 
-  rclcpp::spin(node);
+  // Service calls are handled concurrently, the dashboard client pipelines their commands
+  rclcpp::executors::MultiThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin();
 
   return 0;
 }
@@ -41,12 +41,26 @@
 
 #include <string>
 
+#include "ur_robot_driver/dashboard_response_parser.hpp"
+
 namespace ur_robot_driver
 {
 DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, const std::string& robot_ip)
-  : node_(node), client_(robot_ip)
+  : node_(node)
+  , callback_group_(node->create_callback_group(rclcpp::CallbackGroupType::Reentrant))
+  , client_(robot_ip)
 {
   node_->declare_parameter<double>("receive_timeout", 1);
+  // Rate in Hz at which robot mode, safety mode and program state are polled in the background. 0 disables polling.
+  const double status_poll_rate = node_->declare_parameter<double>("status_poll_rate", 2.0);
+  // Maximum age in seconds of a polled status for the query services to answer with it.
+  status_max_age_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(node_->declare_parameter<double>("status_max_age", 1.0)));
+  // Lost connections are re-established by client_ on its own, the robot's state might have changed in the meantime
+  client_.setReconnectCallback([this]() {
+    invalidateStatus();
+    resync_pending_ = true;
+  });
   connect();
 
   // Service to release the brakes. If the robot is currently powered off, it will get powered on on the fly.
@@ -96,21 +110,22 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       createDashboardTriggerSrv("~/unlock_protective_stop", "unlock protective stop\n", "Protective stop releasing");
 
   // Query whether there is currently a program running
-  running_service_ = node_->create_service<ur_dashboard_msgs::srv::IsProgramRunning>(
-      "~/program_running",
-      std::bind(&DashboardClientROS::handleRunningQuery, this, std::placeholders::_1, std::placeholders::_2));
+  running_service_ = createService<ur_dashboard_msgs::srv::IsProgramRunning>(
+      "~/program_running", [&](const ur_dashboard_msgs::srv::IsProgramRunning::Request::SharedPtr req,
+                               ur_dashboard_msgs::srv::IsProgramRunning::Response::SharedPtr resp) {
+        answerFromCache(program_running_cache_, &DashboardClientROS::handleRunningQuery, req, resp);
+      });
 
   // Load a robot installation from a file
-  get_loaded_program_service_ = node_->create_service<ur_dashboard_msgs::srv::GetLoadedProgram>(
+  get_loaded_program_service_ = createService<ur_dashboard_msgs::srv::GetLoadedProgram>(
       "~/get_loaded_program", [&](const ur_dashboard_msgs::srv::GetLoadedProgram::Request::SharedPtr req,
                                   ur_dashboard_msgs::srv::GetLoadedProgram::Response::SharedPtr resp) {
         try {
           resp->answer = this->client_.sendAndReceive("get loaded program\n");
-          std::smatch match;
-          std::regex expected("Loaded program: (.+)");
-          resp->success = std::regex_match(resp->answer, match, expected);
+          std::string_view program_name;
+          resp->success = dashboard_parser::parsePrefixed(resp->answer, "Loaded program: ", program_name);
           if (resp->success) {
-            resp->program_name = match[1];
+            resp->program_name = program_name;
           }
         } catch (const urcl::UrException& e) {
           RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
@@ -121,12 +136,13 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // Load a robot installation from a file
-  load_installation_service_ = node_->create_service<ur_dashboard_msgs::srv::Load>(
+  load_installation_service_ = createService<ur_dashboard_msgs::srv::Load>(
       "~/load_installation", [&](const ur_dashboard_msgs::srv::Load::Request::SharedPtr req,
                                  ur_dashboard_msgs::srv::Load::Response::SharedPtr resp) {
+        const StatusInvalidation invalidation(*this);
         try {
           resp->answer = this->client_.sendAndReceive("load installation " + req->filename + "\n");
-          resp->success = std::regex_match(resp->answer, std::regex("Loading installation: .+"));
+          resp->success = dashboard_parser::parsePrefixed(resp->answer, "Loading installation: ");
         } catch (const urcl::UrException& e) {
           RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
           resp->answer = e.what();
@@ -136,12 +152,17 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // Load a robot program from a file
-  load_program_service_ = node->create_service<ur_dashboard_msgs::srv::Load>(
+  load_program_service_ = createService<ur_dashboard_msgs::srv::Load>(
       "~/load_program", [&](const ur_dashboard_msgs::srv::Load::Request::SharedPtr req,
                             ur_dashboard_msgs::srv::Load::Response::SharedPtr resp) {
+        const StatusInvalidation invalidation(*this);
         try {
           resp->answer = this->client_.sendAndReceive("load " + req->filename + "\n");
-          resp->success = std::regex_match(resp->answer, std::regex("Loading program: .+"));
+          resp->success = dashboard_parser::parsePrefixed(resp->answer, "Loading program: ");
+          if (resp->success) {
+            std::lock_guard<std::mutex> lock(status_mutex_);
+            loaded_program_ = req->filename;
+          }
         } catch (const urcl::UrException& e) {
           RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
           resp->answer = e.what();
@@ -151,17 +172,17 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // // Query whether the current program is saved
-  is_program_saved_service_ = node_->create_service<ur_dashboard_msgs::srv::IsProgramSaved>(
+  is_program_saved_service_ = createService<ur_dashboard_msgs::srv::IsProgramSaved>(
       "~/program_saved",
       std::bind(&DashboardClientROS::handleSavedQuery, this, std::placeholders::_1, std::placeholders::_2));
 
   // Service to show a popup on the UR Teach pendant.
-  popup_service_ = node_->create_service<ur_dashboard_msgs::srv::Popup>(
+  popup_service_ = createService<ur_dashboard_msgs::srv::Popup>(
       "~/popup", [&](ur_dashboard_msgs::srv::Popup::Request::SharedPtr req,
                      ur_dashboard_msgs::srv::Popup::Response::SharedPtr resp) {
         try {
           resp->answer = this->client_.sendAndReceive("popup " + req->message + "\n");
-          resp->success = std::regex_match(resp->answer, std::regex("showing popup"));
+          resp->success = resp->answer == "showing popup";
         } catch (const urcl::UrException& e) {
           RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
           resp->answer = e.what();
@@ -171,43 +192,33 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // Service to query the current program state
-  program_state_service_ = node_->create_service<ur_dashboard_msgs::srv::GetProgramState>(
-      "~/program_state", [&](const ur_dashboard_msgs::srv::GetProgramState::Request::SharedPtr /*unused*/,
+  program_state_service_ = createService<ur_dashboard_msgs::srv::GetProgramState>(
+      "~/program_state", [&](const ur_dashboard_msgs::srv::GetProgramState::Request::SharedPtr req,
                              ur_dashboard_msgs::srv::GetProgramState::Response::SharedPtr resp) {
-        try {
-          resp->answer = this->client_.sendAndReceive("programState\n");
-          std::smatch match;
-          std::regex expected("(STOPPED|PLAYING|PAUSED) (.+)");
-          resp->success = std::regex_match(resp->answer, match, expected);
-          if (resp->success) {
-            resp->state.state = match[1];
-            resp->program_name = match[2];
-          }
-        } catch (const urcl::UrException& e) {
-          RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
-          resp->answer = e.what();
-          resp->success = false;
-        }
-        return true;
+        answerFromCache(program_state_cache_, &DashboardClientROS::handleProgramStateQuery, req, resp);
       });
 
   // Service to query the current safety mode
-  safety_mode_service_ = node_->create_service<ur_dashboard_msgs::srv::GetSafetyMode>(
-      "~/get_safety_mode",
-      std::bind(&DashboardClientROS::handleSafetyModeQuery, this, std::placeholders::_1, std::placeholders::_2));
+  safety_mode_service_ = createService<ur_dashboard_msgs::srv::GetSafetyMode>(
+      "~/get_safety_mode", [&](const ur_dashboard_msgs::srv::GetSafetyMode::Request::SharedPtr req,
+                               ur_dashboard_msgs::srv::GetSafetyMode::Response::SharedPtr resp) {
+        answerFromCache(safety_mode_cache_, &DashboardClientROS::handleSafetyModeQuery, req, resp);
+      });
 
   // Service to query the current robot mode
-  robot_mode_service_ = node_->create_service<ur_dashboard_msgs::srv::GetRobotMode>(
-      "~/get_robot_mode",
-      std::bind(&DashboardClientROS::handleRobotModeQuery, this, std::placeholders::_1, std::placeholders::_2));
+  robot_mode_service_ = createService<ur_dashboard_msgs::srv::GetRobotMode>(
+      "~/get_robot_mode", [&](const ur_dashboard_msgs::srv::GetRobotMode::Request::SharedPtr req,
+                              ur_dashboard_msgs::srv::GetRobotMode::Response::SharedPtr resp) {
+        answerFromCache(robot_mode_cache_, &DashboardClientROS::handleRobotModeQuery, req, resp);
+      });
 
   // Service to add a message to the robot's log
-  add_to_log_service_ = node->create_service<ur_dashboard_msgs::srv::AddToLog>(
+  add_to_log_service_ = createService<ur_dashboard_msgs::srv::AddToLog>(
       "~/add_to_log", [&](const ur_dashboard_msgs::srv::AddToLog::Request::SharedPtr req,
                           ur_dashboard_msgs::srv::AddToLog::Response::SharedPtr resp) {
         try {
           resp->answer = this->client_.sendAndReceive("addToLog " + req->message + "\n");
-          resp->success = std::regex_match(resp->answer, std::regex("(Added log message|No log message to add)"));
+          resp->success = resp->answer == "Added log message" || resp->answer == "No log message to add";
         } catch (const urcl::UrException& e) {
           RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
           resp->answer = e.what();
@@ -217,9 +228,10 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // General purpose service to send arbitrary messages to the dashboard server
-  raw_request_service_ = node_->create_service<ur_dashboard_msgs::srv::RawRequest>(
+  raw_request_service_ = createService<ur_dashboard_msgs::srv::RawRequest>(
       "~/raw_request", [&](const ur_dashboard_msgs::srv::RawRequest::Request::SharedPtr req,
                            ur_dashboard_msgs::srv::RawRequest::Response::SharedPtr resp) {
+        const StatusInvalidation invalidation(*this);
         try {
           resp->answer = this->client_.sendAndReceive(req->query + "\n");
         } catch (const urcl::UrException& e) {
@@ -230,9 +242,10 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // Service to reconnect to the dashboard server
-  reconnect_service_ = node_->create_service<std_srvs::srv::Trigger>(
+  reconnect_service_ = createService<std_srvs::srv::Trigger>(
       "~/connect",
       [&](const std_srvs::srv::Trigger::Request::SharedPtr req, std_srvs::srv::Trigger::Response::SharedPtr resp) {
+        const StatusInvalidation invalidation(*this);
         try {
           resp->success = connect();
         } catch (const urcl::UrException& e) {
@@ -244,12 +257,13 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
       });
 
   // Disconnect from the dashboard service.
-  quit_service_ =
-      node_->create_service<std_srvs::srv::Trigger>("~/quit", [&](const std_srvs::srv::Trigger::Request::SharedPtr req,
-                                                                  std_srvs::srv::Trigger::Response::SharedPtr resp) {
+  quit_service_ = createService<std_srvs::srv::Trigger>(
+      "~/quit",
+      [&](const std_srvs::srv::Trigger::Request::SharedPtr req, std_srvs::srv::Trigger::Response::SharedPtr resp) {
+        const StatusInvalidation invalidation(*this);
         try {
           resp->message = this->client_.sendAndReceive("quit\n");
-          resp->success = std::regex_match(resp->message, std::regex("Disconnected"));
+          resp->success = resp->message == "Disconnected";
           client_.disconnect();
         } catch (const urcl::UrException& e) {
           RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
@@ -258,17 +272,154 @@ DashboardClientROS::DashboardClientROS(const rclcpp::Node::SharedPtr& node, cons
         }
         return true;
       });
+
+  // Status topics, published whenever a polled or queried status changed
+  auto qos_latched = rclcpp::QoS(1).transient_local();
+  robot_mode_pub_ = node_->create_publisher<ur_dashboard_msgs::msg::RobotMode>("~/status/robot_mode", qos_latched);
+  safety_mode_pub_ = node_->create_publisher<ur_dashboard_msgs::msg::SafetyMode>("~/status/safety_mode", qos_latched);
+  program_running_pub_ = node_->create_publisher<std_msgs::msg::Bool>("~/status/program_running", qos_latched);
+  program_state_pub_ =
+      node_->create_publisher<ur_dashboard_msgs::msg::ProgramState>("~/status/program_state", qos_latched);
+
+  if (status_poll_rate > 0.0) {
+    pollStatus();
+    status_timer_ = node_->create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / status_poll_rate)),
+        [this]() { pollStatus(); }, callback_group_);
+  }
+}
+
+template <typename ServiceT>
+void DashboardClientROS::answerFromCache(CachedResponse<ServiceT>& cache, QueryHandler<ServiceT> query,
+                                         typename ServiceT::Request::SharedPtr req,
+                                         typename ServiceT::Response::SharedPtr resp)
+{
+  // Without polling every query goes to the dashboard server as before
+  if (status_timer_) {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    if (cache.valid && std::chrono::steady_clock::now() - cache.stamp <= status_max_age_) {
+      *resp = cache.response;
+      return;
+    }
+  }
+  refreshCache(cache, query, req, resp);
+  publishStatus();
+}
+
+template <typename ServiceT>
+void DashboardClientROS::refreshCache(CachedResponse<ServiceT>& cache, QueryHandler<ServiceT> query,
+                                      typename ServiceT::Request::SharedPtr req,
+                                      typename ServiceT::Response::SharedPtr resp)
+{
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    generation = status_generation_;
+  }
+  // Not holding the lock while waiting for the dashboard server, concurrent queries are pipelined
+  (this->*query)(req, resp);
+  std::lock_guard<std::mutex> lock(status_mutex_);
+  if (generation != status_generation_) {
+    // A command might have changed the status after the dashboard server answered, so the answer is only passed on
+    return;
+  }
+  cache.response = *resp;
+  cache.stamp = std::chrono::steady_clock::now();
+  cache.valid = resp->success;
+}
+
+void DashboardClientROS::pollStatus()
+{
+  if (resync_pending_.exchange(false)) {
+    resyncProgram();
+  }
+  refreshCache(robot_mode_cache_, &DashboardClientROS::handleRobotModeQuery,
+               std::make_shared<ur_dashboard_msgs::srv::GetRobotMode::Request>(),
+               std::make_shared<ur_dashboard_msgs::srv::GetRobotMode::Response>());
+  refreshCache(safety_mode_cache_, &DashboardClientROS::handleSafetyModeQuery,
+               std::make_shared<ur_dashboard_msgs::srv::GetSafetyMode::Request>(),
+               std::make_shared<ur_dashboard_msgs::srv::GetSafetyMode::Response>());
+  refreshCache(program_running_cache_, &DashboardClientROS::handleRunningQuery,
+               std::make_shared<ur_dashboard_msgs::srv::IsProgramRunning::Request>(),
+               std::make_shared<ur_dashboard_msgs::srv::IsProgramRunning::Response>());
+  refreshCache(program_state_cache_, &DashboardClientROS::handleProgramStateQuery,
+               std::make_shared<ur_dashboard_msgs::srv::GetProgramState::Request>(),
+               std::make_shared<ur_dashboard_msgs::srv::GetProgramState::Response>());
+  publishStatus();
+}
+
+void DashboardClientROS::publishStatus()
+{
+  std::lock_guard<std::mutex> lock(status_mutex_);
+  if (robot_mode_cache_.valid && published_robot_mode_ != robot_mode_cache_.response.robot_mode) {
+    published_robot_mode_ = robot_mode_cache_.response.robot_mode;
+    robot_mode_pub_->publish(*published_robot_mode_);
+  }
+  if (safety_mode_cache_.valid && published_safety_mode_ != safety_mode_cache_.response.safety_mode) {
+    published_safety_mode_ = safety_mode_cache_.response.safety_mode;
+    safety_mode_pub_->publish(*published_safety_mode_);
+  }
+  if (program_running_cache_.valid &&
+      (!published_program_running_ ||
+       published_program_running_->data != program_running_cache_.response.program_running)) {
+    published_program_running_ = std_msgs::msg::Bool();
+    published_program_running_->data = program_running_cache_.response.program_running;
+    program_running_pub_->publish(*published_program_running_);
+  }
+  if (program_state_cache_.valid && published_program_state_ != program_state_cache_.response.state) {
+    published_program_state_ = program_state_cache_.response.state;
+    program_state_pub_->publish(*published_program_state_);
+  }
+}
+
+void DashboardClientROS::invalidateStatus()
+{
+  std::lock_guard<std::mutex> lock(status_mutex_);
+  ++status_generation_;
+  robot_mode_cache_.valid = false;
+  safety_mode_cache_.valid = false;
+  program_running_cache_.valid = false;
+  program_state_cache_.valid = false;
+}
+
+void DashboardClientROS::resyncProgram()
+{
+  std::string program;
+  {
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    program = loaded_program_;
+  }
+  if (program.empty()) {
+    return;
+  }
+
+  try {
+    const std::string answer = client_.sendAndReceive("get loaded program\n");
+    std::string_view loaded;
+    // The robot reports the full path, while the program might have been loaded relative to the programs directory
+    if (dashboard_parser::parsePrefixed(answer, "Loaded program: ", loaded) && loaded.size() >= program.size() &&
+        loaded.substr(loaded.size() - program.size()) == program) {
+      return;
+    }
+    RCLCPP_WARN(rclcpp::get_logger("Dashboard_Client"), "Program '%s' isn't loaded anymore, loading it again",
+                program.c_str());
+    const std::string load_answer = client_.sendAndReceive("load " + program + "\n");
+    if (!dashboard_parser::parsePrefixed(load_answer, "Loading program: ")) {
+      RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Could not load program '%s' again: '%s'", program.c_str(),
+                   load_answer.c_str());
+    }
+  } catch (const urcl::UrException& e) {
+    RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Re-syncing the loaded program failed: '%s'", e.what());
+    resync_pending_ = true;
+  }
 }
 
 bool DashboardClientROS::connect()
 {
-  timeval tv;
   // Timeout after which a call to the dashboard server will be considered failure if no answer has been received.
   double time_buffer = 0;
   node_->get_parameter("receive_timeout", time_buffer);
-  tv.tv_sec = time_buffer;
-  tv.tv_usec = 0;
-  client_.setReceiveTimeout(tv);
+  client_.setTimeout(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<double>(time_buffer)));
   return client_.connect();
 }
 
@@ -277,12 +428,11 @@ bool DashboardClientROS::handleRunningQuery(const ur_dashboard_msgs::srv::IsProg
 {
   try {
     resp->answer = this->client_.sendAndReceive("running\n");
-    std::regex expected("Program running: (true|false)");
-    std::smatch match;
-    resp->success = std::regex_match(resp->answer, match, expected);
+    bool program_running = false;
+    resp->success = dashboard_parser::parseProgramRunning(resp->answer, program_running);
 
     if (resp->success) {
-      resp->program_running = (match[1] == "true");
+      resp->program_running = program_running;
     }
   } catch (const urcl::UrException& e) {
     RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
@@ -298,13 +448,13 @@ bool DashboardClientROS::handleSavedQuery(ur_dashboard_msgs::srv::IsProgramSaved
 {
   try {
     resp->answer = this->client_.sendAndReceive("isProgramSaved\n");
-    std::regex expected("(true|false) ([^\\s]+)");
-    std::smatch match;
-    resp->success = std::regex_match(resp->answer, match, expected);
+    bool program_saved = false;
+    std::string_view program_name;
+    resp->success = dashboard_parser::parseProgramSaved(resp->answer, program_saved, program_name);
 
     if (resp->success) {
-      resp->program_saved = (match[1] == "true");
-      resp->program_name = match[2];
+      resp->program_saved = program_saved;
+      resp->program_name = program_name;
     }
   } catch (const urcl::UrException& e) {
     RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
@@ -315,44 +465,33 @@ bool DashboardClientROS::handleSavedQuery(ur_dashboard_msgs::srv::IsProgramSaved
   return true;
 }
 
+bool DashboardClientROS::handleProgramStateQuery(
+    const ur_dashboard_msgs::srv::GetProgramState::Request::SharedPtr /*unused*/,
+    ur_dashboard_msgs::srv::GetProgramState::Response::SharedPtr resp)
+{
+  try {
+    resp->answer = this->client_.sendAndReceive("programState\n");
+    std::string_view state;
+    std::string_view program_name;
+    resp->success = dashboard_parser::parseProgramState(resp->answer, state, program_name);
+    if (resp->success) {
+      resp->state.state = state;
+      resp->program_name = program_name;
+    }
+  } catch (const urcl::UrException& e) {
+    RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
+    resp->answer = e.what();
+    resp->success = false;
+  }
+  return true;
+}
+
 bool DashboardClientROS::handleSafetyModeQuery(const ur_dashboard_msgs::srv::GetSafetyMode::Request::SharedPtr req,
                                                ur_dashboard_msgs::srv::GetSafetyMode::Response::SharedPtr resp)
 {
   try {
     resp->answer = this->client_.sendAndReceive("safetymode\n");
-    std::smatch match;
-    std::regex expected("Safetymode: (.+)");
-    resp->success = std::regex_match(resp->answer, match, expected);
-    if (resp->success) {
-      if (match[1] == "NORMAL") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::NORMAL;
-      } else if (match[1] == "REDUCED") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::REDUCED;
-      } else if (match[1] == "PROTECTIVE_STOP") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::PROTECTIVE_STOP;
-      } else if (match[1] == "RECOVERY") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::RECOVERY;
-      } else if (match[1] == "SAFEGUARD_STOP") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::SAFEGUARD_STOP;
-      } else if (match[1] == "SYSTEM_EMERGENCY_STOP") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::SYSTEM_EMERGENCY_STOP;
-      } else if (match[1] == "ROBOT_EMERGENCY_STOP") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::ROBOT_EMERGENCY_STOP;
-      } else if (match[1] == "VIOLATION") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::VIOLATION;
-      } else if (match[1] == "FAULT") {
-        resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::FAULT;
-      }
-      // The following are only available in SafetyStatus from 5.5 on
-      // else if (match[1] == "AUTOMATIC_MODE_SAFEGUARD_STOP")
-      //{
-      // resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::AUTOMATIC_MODE_SAFEGUARD_STOP;
-      //}
-      // else if (match[1] == "SYSTEM_THREE_POSITION_ENABLING_STOP")
-      //{
-      // resp->safety_mode.mode = ur_dashboard_msgs::msg::SafetyMode::SYSTEM_THREE_POSITION_ENABLING_STOP;
-      //}
-    }
+    resp->success = dashboard_parser::parseSafetyMode(resp->answer, resp->safety_mode);
   } catch (const urcl::UrException& e) {
     RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
     resp->answer = e.what();
@@ -366,32 +505,7 @@ bool DashboardClientROS::handleRobotModeQuery(const ur_dashboard_msgs::srv::GetR
 {
   try {
     resp->answer = this->client_.sendAndReceive("robotmode\n");
-    std::smatch match;
-    std::regex expected("Robotmode: (.+)");
-    resp->success = std::regex_match(resp->answer, match, expected);
-    if (resp->success) {
-      if (match[1] == "NO_CONTROLLER") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::NO_CONTROLLER;
-      } else if (match[1] == "DISCONNECTED") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::DISCONNECTED;
-      } else if (match[1] == "CONFIRM_SAFETY") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::CONFIRM_SAFETY;
-      } else if (match[1] == "BOOTING") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::BOOTING;
-      } else if (match[1] == "POWER_OFF") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::POWER_OFF;
-      } else if (match[1] == "POWER_ON") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::POWER_ON;
-      } else if (match[1] == "IDLE") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::IDLE;
-      } else if (match[1] == "BACKDRIVE") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::BACKDRIVE;
-      } else if (match[1] == "RUNNING") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::RUNNING;
-      } else if (match[1] == "UPDATING_FIRMWARE") {
-        resp->robot_mode.mode = ur_dashboard_msgs::msg::RobotMode::UPDATING_FIRMWARE;
-      }
-    }
+    resp->success = dashboard_parser::parseRobotMode(resp->answer, resp->robot_mode);
   } catch (const urcl::UrException& e) {
     RCLCPP_ERROR(rclcpp::get_logger("Dashboard_Client"), "Service Call failed: '%s'", e.what());
     resp->answer = e.what();
@@ -0,0 +1,441 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_robot_driver/dashboard_command_executor.hpp"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <utility>
+
+#include "rclcpp/rclcpp.hpp"
+#include "ur_client_library/exceptions.h"
+
+namespace ur_robot_driver
+{
+namespace
+{
+const char DASHBOARD_WELCOME[] = "Connected: Universal Robots Dashboard Server";
+
+int remainingMilliseconds(std::chrono::steady_clock::time_point deadline)
+{
+  const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+  return static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+}
+}  // namespace
+
+DashboardCommandExecutor::DashboardCommandExecutor(const std::string& host, int port,
+                                                   std::chrono::milliseconds reconnect_interval,
+                                                   std::chrono::milliseconds max_reconnect_interval)
+  : host_(host), port_(port), backoff_(reconnect_interval, max_reconnect_interval)
+{
+  if (pipe(wake_pipe_) != 0) {
+    throw urcl::UrException("Could not create the wake up pipe of the dashboard command executor");
+  }
+  fcntl(wake_pipe_[0], F_SETFL, O_NONBLOCK);
+  fcntl(wake_pipe_[1], F_SETFL, O_NONBLOCK);
+  thread_ = std::thread(&DashboardCommandExecutor::run, this);
+}
+
+DashboardCommandExecutor::~DashboardCommandExecutor()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wakeUp();
+  thread_.join();
+  close(wake_pipe_[0]);
+  close(wake_pipe_[1]);
+}
+
+bool DashboardCommandExecutor::connect()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  keep_connected_ = true;
+  connect_requested_ = true;
+  wakeUp();
+  connect_cv_.wait(lock, [this]() { return !connect_requested_ || stop_; });
+  return connect_result_;
+}
+
+void DashboardCommandExecutor::disconnect()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    keep_connected_ = false;
+  }
+  wakeUp();
+}
+
+void DashboardCommandExecutor::setTimeout(std::chrono::milliseconds timeout)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  timeout_ = timeout;
+}
+
+std::future<std::string> DashboardCommandExecutor::submit(const std::string& command,
+                                                          std::chrono::milliseconds timeout)
+{
+  Request request;
+  request.command = command;
+  if (request.command.empty() || request.command.back() != '\n') {
+    request.command += '\n';
+  }
+  request.deadline = std::chrono::steady_clock::now() + timeout;
+  std::future<std::string> answer = request.answer.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!keep_connected_) {
+      request.answer.set_exception(
+          std::make_exception_ptr(urcl::UrException("Not connected to the dashboard server")));
+      return answer;
+    }
+    queued_.push_back(std::move(request));
+  }
+  wakeUp();
+  return answer;
+}
+
+std::string DashboardCommandExecutor::sendAndReceive(const std::string& command)
+{
+  std::chrono::milliseconds timeout;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    timeout = timeout_;
+  }
+  return submit(command, timeout).get();
+}
+
+void DashboardCommandExecutor::setReconnectCallback(std::function<void()> callback)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  reconnect_callback_ = std::move(callback);
+}
+
+RecoveryStatistics DashboardCommandExecutor::recoveryStatistics()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return recovery_statistics_;
+}
+
+void DashboardCommandExecutor::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    const bool explicit_connect = connect_requested_;
+    if (explicit_connect ||
+        (keep_connected_ && socket_fd_ < 0 && std::chrono::steady_clock::now() >= next_connect_attempt_)) {
+      closeConnection("Reconnecting to the dashboard server");
+      const auto timeout = timeout_;
+      lock.unlock();
+      const bool connected = openConnection(timeout);
+      lock.lock();
+      const bool recovered = connected && connection_lost_since_.has_value();
+      connectionAttempted(connected);
+      if (explicit_connect) {
+        connect_result_ = connected;
+        connect_requested_ = false;
+        connect_cv_.notify_all();
+      }
+      if (recovered && reconnect_callback_) {
+        const auto callback = reconnect_callback_;
+        lock.unlock();
+        callback();
+        lock.lock();
+      }
+      continue;
+    }
+
+    if (!keep_connected_) {
+      closeConnection("Disconnected from the dashboard server");
+      connection_lost_since_.reset();
+      while (!queued_.empty()) {
+        queued_.front().answer.set_exception(
+            std::make_exception_ptr(urcl::UrException("Not connected to the dashboard server")));
+        queued_.pop_front();
+      }
+    }
+
+    failExpiredRequests(std::chrono::steady_clock::now());
+
+    // Pipeline everything that is queued, answers are matched in order
+    if (socket_fd_ >= 0 && !queued_.empty()) {
+      std::string data;
+      while (!queued_.empty()) {
+        data += queued_.front().command;
+        in_flight_.push_back(std::move(queued_.front()));
+        queued_.pop_front();
+      }
+      lock.unlock();
+      const bool sent = sendAll(data);
+      lock.lock();
+      if (!sent) {
+        RCLCPP_WARN(rclcpp::get_logger("Dashboard_Client"), "Failed to send to the dashboard server, reconnecting");
+        connectionLost("Failed to send to the dashboard server");
+        continue;
+      }
+    }
+
+    // Sleep until something can happen: an answer, a new command, a deadline or the next connection attempt
+    auto wake_time = std::chrono::steady_clock::time_point::max();
+    for (const auto* requests : { &queued_, &in_flight_ }) {
+      for (const auto& request : *requests) {
+        wake_time = std::min(wake_time, request.deadline);
+      }
+    }
+    if (keep_connected_ && socket_fd_ < 0) {
+      wake_time = std::min(wake_time, next_connect_attempt_);
+    }
+    const bool wait_forever = wake_time == std::chrono::steady_clock::time_point::max();
+    const int poll_timeout = wait_forever ? -1 : remainingMilliseconds(wake_time);
+    pollfd fds[2] = { { wake_pipe_[0], POLLIN, 0 }, { socket_fd_, POLLIN, 0 } };
+    const nfds_t fd_count = socket_fd_ >= 0 ? 2 : 1;
+
+    lock.unlock();
+    poll(fds, fd_count, poll_timeout);
+    char drain[64];
+    while (read(wake_pipe_[0], drain, sizeof(drain)) > 0) {
+    }
+    bool connection_lost = false;
+    if (fd_count == 2 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+      char buffer[1024];
+      const ssize_t received = recv(socket_fd_, buffer, sizeof(buffer), 0);
+      if (received > 0) {
+        receive_buffer_.append(buffer, received);
+      } else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        connection_lost = true;
+      }
+    }
+    lock.lock();
+
+    size_t line_end;
+    while ((line_end = receive_buffer_.find('\n')) != std::string::npos) {
+      std::string answer = receive_buffer_.substr(0, line_end);
+      receive_buffer_.erase(0, line_end + 1);
+      if (in_flight_.empty()) {
+        RCLCPP_WARN(rclcpp::get_logger("Dashboard_Client"), "Ignoring unexpected answer from dashboard server: '%s'",
+                    answer.c_str());
+        continue;
+      }
+      in_flight_.front().answer.set_value(std::move(answer));
+      in_flight_.pop_front();
+    }
+    if (connection_lost) {
+      RCLCPP_WARN(rclcpp::get_logger("Dashboard_Client"), "Lost connection to the dashboard server, reconnecting");
+      connectionLost("Lost connection to the dashboard server");
+    }
+  }
+
+  closeConnection("Dashboard command executor shut down");
+  while (!queued_.empty()) {
+    queued_.front().answer.set_exception(
+        std::make_exception_ptr(urcl::UrException("Dashboard command executor shut down")));
+    queued_.pop_front();
+  }
+  connect_cv_.notify_all();
+}
+
+bool DashboardCommandExecutor::openConnection(std::chrono::milliseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* addresses = nullptr;
+  if (getaddrinfo(host_.c_str(), std::to_string(port_).c_str(), &hints, &addresses) != 0) {
+    return false;
+  }
+
+  int fd = -1;
+  for (addrinfo* address = addresses; address != nullptr && fd < 0; address = address->ai_next) {
+    fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    if (::connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+      pollfd pfd = { fd, POLLOUT, 0 };
+      int error = errno;
+      if (error == EINPROGRESS && poll(&pfd, 1, remainingMilliseconds(deadline)) == 1) {
+        socklen_t length = sizeof(error);
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+      } else if (error == EINPROGRESS) {
+        error = ETIMEDOUT;
+      }
+      if (error != 0) {
+        close(fd);
+        fd = -1;
+      }
+    }
+  }
+  freeaddrinfo(addresses);
+  if (fd < 0) {
+    return false;
+  }
+
+  int flag = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+  socket_fd_ = fd;
+  receive_buffer_.clear();
+
+  // The dashboard server greets every new connection
+  size_t line_end;
+  while ((line_end = receive_buffer_.find('\n')) == std::string::npos) {
+    pollfd pfd = { fd, POLLIN, 0 };
+    char buffer[256];
+    ssize_t received = 0;
+    if (poll(&pfd, 1, remainingMilliseconds(deadline)) != 1 || (received = recv(fd, buffer, sizeof(buffer), 0)) <= 0) {
+      close(fd);
+      socket_fd_ = -1;
+      return false;
+    }
+    receive_buffer_.append(buffer, received);
+  }
+  const bool welcomed = receive_buffer_.compare(0, line_end, DASHBOARD_WELCOME) == 0;
+  receive_buffer_.erase(0, line_end + 1);
+  if (!welcomed) {
+    close(fd);
+    socket_fd_ = -1;
+  }
+  return welcomed;
+}
+
+bool DashboardCommandExecutor::sendAll(const std::string& data)
+{
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t result = send(socket_fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (result > 0) {
+      sent += result;
+    } else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      pollfd pfd = { socket_fd_, POLLOUT, 0 };
+      poll(&pfd, 1, 100);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DashboardCommandExecutor::closeConnection(const std::string& reason)
+{
+  if (socket_fd_ >= 0) {
+    close(socket_fd_);
+    socket_fd_ = -1;
+  }
+  receive_buffer_.clear();
+  while (!in_flight_.empty()) {
+    in_flight_.front().answer.set_exception(std::make_exception_ptr(urcl::UrException(reason)));
+    in_flight_.pop_front();
+  }
+}
+
+void DashboardCommandExecutor::connectionLost(const std::string& reason)
+{
+  closeConnection(reason);
+  const auto now = std::chrono::steady_clock::now();
+  if (!connection_lost_since_) {
+    connection_lost_since_ = now;
+  }
+  // The first attempt is made right away, a blip is usually over by then
+  next_connect_attempt_ = now;
+}
+
+void DashboardCommandExecutor::connectionAttempted(bool connected)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (!connected) {
+    if (!connection_lost_since_) {
+      connection_lost_since_ = now;
+    }
+    const std::chrono::milliseconds delay = backoff_.next();
+    next_connect_attempt_ = now + delay;
+    RCLCPP_WARN(rclcpp::get_logger("Dashboard_Client"), "Could not connect to the dashboard server, retrying in %.1f s",
+                std::chrono::duration<double>(delay).count());
+    return;
+  }
+
+  backoff_.reset();
+  if (connection_lost_since_) {
+    recovery_statistics_.recordRecovery(now - *connection_lost_since_);
+    connection_lost_since_.reset();
+    RCLCPP_INFO(rclcpp::get_logger("Dashboard_Client"), "Reconnected to the dashboard server after %.2f s",
+                recovery_statistics_.last_recovery_time.count());
+  }
+}
+
+void DashboardCommandExecutor::failExpiredRequests(std::chrono::steady_clock::time_point now)
+{
+  for (auto it = queued_.begin(); it != queued_.end();) {
+    if (it->deadline <= now) {
+      it->answer.set_exception(
+          std::make_exception_ptr(urcl::UrException("Timeout while waiting to send '" + it->command + "'")));
+      it = queued_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // A late answer would be matched to the wrong command, so the whole connection has to be dropped
+  for (const auto& request : in_flight_) {
+    if (request.deadline <= now) {
+      RCLCPP_WARN(rclcpp::get_logger("Dashboard_Client"), "Dashboard server didn't answer '%s' in time, reconnecting",
+                  request.command.substr(0, request.command.size() - 1).c_str());
+      connectionLost("Timeout while waiting for the dashboard server's answer");
+      break;
+    }
+  }
+}
+
+void DashboardCommandExecutor::wakeUp()
+{
+  const char byte = 0;
+  if (write(wake_pipe_[1], &byte, 1) < 0) {
+    // The pipe is full, so the I/O thread will wake up anyway
+  }
+}
+}  // namespace ur_robot_driver
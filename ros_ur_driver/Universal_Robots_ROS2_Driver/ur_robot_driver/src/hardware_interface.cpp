@@ -37,6 +37,9 @@
  */
 //----------------------------------------------------------------------
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -47,13 +50,20 @@
 
 #include "rclcpp/rclcpp.hpp"
 #include "hardware_interface/types/hardware_interface_type_values.hpp"
+#include "ur_robot_driver/bitset_expansion.hpp"
 #include "ur_robot_driver/hardware_interface.hpp"
 #include "ur_robot_driver/urcl_log_handler.hpp"
+#include "ur_robot_driver/wrench_transform.hpp"
 
 namespace rtde = urcl::rtde_interface;
 
 namespace ur_robot_driver
 {
+namespace
+{
+// Never matches the value of a bitset, which forces the expansion on the first update
+constexpr uint64_t UNKNOWN_BITSET_WORD = std::numeric_limits<uint64_t>::max();
+}  // namespace
 
 URPositionHardwareInterface::~URPositionHardwareInterface()
 {
@@ -85,6 +95,16 @@ URPositionHardwareInterface::on_init(const hardware_interface::HardwareInfo& sys
   start_modes_ = {};
   position_controller_running_ = false;
   velocity_controller_running_ = false;
+  trajectory_forwarding_running_ = false;
+  start_trajectory_forwarding_ = false;
+  stop_trajectory_forwarding_ = false;
+  trajectory_positions_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  trajectory_velocities_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  trajectory_accelerations_ = { { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 } };
+  trajectory_time_from_start_ = 0.0;
+  trajectory_point_count_ = 0.0;
+  trajectory_transfer_state_ = TrajectoryTransferState::TRANSFER_IDLE;
+  last_forwarded_time_from_start_ = 0.0;
   runtime_state_ = static_cast<uint32_t>(rtde::RUNTIME_STATE::STOPPED);
   pausing_state_ = PausingState::RUNNING;
   pausing_ramp_up_increment_ = 0.01;
@@ -92,7 +112,51 @@ URPositionHardwareInterface::on_init(const hardware_interface::HardwareInfo& sys
   first_pass_ = true;
   initialized_ = false;
   async_thread_shutdown_ = false;
+  io_batch_sequence_cmd_ = NO_NEW_CMD_;
+  io_batch_acknowledged_ = 0.0;
   system_interface_initialized_ = 0.0;
+  rtde_timestamp_ = 0.0;
+  rtde_period_ = 0.0;
+  last_rtde_timestamp_ = 0.0;
+  rtde_packets_received_ = 0.0;
+  rtde_missed_packets_ = 0.0;
+  rtde_phase_error_ = 0.0;
+  rtde_max_phase_error_ = 0.0;
+  rtde_sync_interrupted_ = false;
+  connection_connected_ = 0.0;
+  connection_reconnects_ = 0.0;
+  connection_last_recovery_time_ = 0.0;
+  connection_max_recovery_time_ = 0.0;
+  actual_dig_out_bits_word_ = UNKNOWN_BITSET_WORD;
+  actual_dig_in_bits_word_ = UNKNOWN_BITSET_WORD;
+  analog_io_types_word_ = UNKNOWN_BITSET_WORD;
+  tool_analog_input_types_word_ = UNKNOWN_BITSET_WORD;
+  robot_status_bits_word_ = UNKNOWN_BITSET_WORD;
+  safety_status_bits_word_ = UNKNOWN_BITSET_WORD;
+
+  // The recipe profile has to be known before the state interfaces get exported
+  const std::string rtde_recipe_profile = info_.hardware_parameters["rtde_recipe_profile"];
+  if (rtde_recipe_profile.empty() || rtde_recipe_profile == "full") {
+    rtde_recipe_profile_ = RTDERecipeProfile::FULL;
+  } else if (rtde_recipe_profile == "motion") {
+    rtde_recipe_profile_ = RTDERecipeProfile::MOTION;
+  } else {
+    RCLCPP_FATAL(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "Unknown RTDE recipe profile '%s'. Expected 'full' or 'motion'.", rtde_recipe_profile.c_str());
+    return hardware_interface::CallbackReturn::ERROR;
+  }
+  io_output_recipe_filename_ = info_.hardware_parameters["io_output_recipe_filename"];
+
+  // Seconds without RTDE data after which the connection to the robot is re-established. 0, the default, disables
+  // reconnecting.
+  const std::string reconnect_timeout = info_.hardware_parameters["reconnect_timeout"];
+  reconnect_timeout_ = std::chrono::duration<double>(reconnect_timeout.empty() ? 0.0 : std::stod(reconnect_timeout));
+  // Upper bound in seconds for the delay between two attempts to reconnect
+  const std::string reconnect_max_interval = info_.hardware_parameters["reconnect_max_interval"];
+  reconnect_backoff_ = ReconnectBackoff(
+      std::chrono::milliseconds(500),
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<double>(
+          reconnect_max_interval.empty() ? 10.0 : std::stod(reconnect_max_interval))));
 
   for (const hardware_interface::ComponentInfo& joint : info_.joints) {
     if (joint.command_interfaces.size() != 2) {
@@ -175,61 +239,89 @@ std::vector<hardware_interface::StateInterface> URPositionHardwareInterface::exp
     }
   }
 
-  for (size_t i = 0; i < 18; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "digital_output_" + std::to_string(i), &actual_dig_out_bits_copy_[i]));
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "digital_input_" + std::to_string(i), &actual_dig_in_bits_copy_[i]));
-  }
+  // Without IO data from the robot, there is no point in offering the interfaces
+  if (hasIOData()) {
+    for (size_t i = 0; i < 18; ++i) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "digital_output_" + std::to_string(i), &actual_dig_out_bits_copy_[i]));
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "digital_input_" + std::to_string(i), &actual_dig_in_bits_copy_[i]));
+    }
 
-  for (size_t i = 0; i < 11; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "safety_status_bit_" + std::to_string(i), &safety_status_bits_copy_[i]));
-  }
+    for (size_t i = 0; i < 11; ++i) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "safety_status_bit_" + std::to_string(i), &safety_status_bits_copy_[i]));
+    }
 
-  for (size_t i = 0; i < 4; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "analog_io_type_" + std::to_string(i), &analog_io_types_copy_[i]));
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "robot_status_bit_" + std::to_string(i), &robot_status_bits_copy_[i]));
-  }
+    for (size_t i = 0; i < 4; ++i) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "analog_io_type_" + std::to_string(i), &analog_io_types_copy_[i]));
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "robot_status_bit_" + std::to_string(i), &robot_status_bits_copy_[i]));
+    }
 
-  for (size_t i = 0; i < 2; ++i) {
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "tool_analog_input_type_" + std::to_string(i), &tool_analog_input_types_copy_[i]));
+    for (size_t i = 0; i < 2; ++i) {
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "tool_analog_input_type_" + std::to_string(i), &tool_analog_input_types_copy_[i]));
 
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "tool_analog_input_" + std::to_string(i), &tool_analog_input_[i]));
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "tool_analog_input_" + std::to_string(i), &tool_analog_input_[i]));
 
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "standard_analog_input_" + std::to_string(i), &standard_analog_input_[i]));
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "standard_analog_input_" + std::to_string(i), &standard_analog_input_[i]));
 
-    state_interfaces.emplace_back(hardware_interface::StateInterface(
-        tf_prefix + "gpio", "standard_analog_output_" + std::to_string(i), &standard_analog_output_[i]));
+      state_interfaces.emplace_back(hardware_interface::StateInterface(
+          tf_prefix + "gpio", "standard_analog_output_" + std::to_string(i), &standard_analog_output_[i]));
+    }
+
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface(tf_prefix + "gpio", "tool_output_voltage", &tool_output_voltage_copy_));
+
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface(tf_prefix + "gpio", "robot_mode", &robot_mode_copy_));
+
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface(tf_prefix + "gpio", "safety_mode", &safety_mode_copy_));
+
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface(tf_prefix + "gpio", "tool_mode", &tool_mode_copy_));
+
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface(tf_prefix + "gpio", "tool_output_current", &tool_output_current_));
+
+    state_interfaces.emplace_back(
+        hardware_interface::StateInterface(tf_prefix + "gpio", "tool_temperature", &tool_temperature_));
   }
 
-  state_interfaces.emplace_back(
-      hardware_interface::StateInterface(tf_prefix + "gpio", "tool_output_voltage", &tool_output_voltage_copy_));
+  state_interfaces.emplace_back(hardware_interface::StateInterface(tf_prefix + "system_interface", "initialized",
+                                                                   &system_interface_initialized_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface(tf_prefix + "gpio", "robot_mode", &robot_mode_copy_));
+      hardware_interface::StateInterface(tf_prefix + "gpio", "program_running", &robot_program_running_copy_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface(tf_prefix + "gpio", "safety_mode", &safety_mode_copy_));
+      hardware_interface::StateInterface(tf_prefix + "rtde_sync", "packets_received", &rtde_packets_received_));
 
-  state_interfaces.emplace_back(hardware_interface::StateInterface(tf_prefix + "gpio", "tool_mode", &tool_mode_copy_));
+  state_interfaces.emplace_back(
+      hardware_interface::StateInterface(tf_prefix + "rtde_sync", "missed_packets", &rtde_missed_packets_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface(tf_prefix + "gpio", "tool_output_current", &tool_output_current_));
+      hardware_interface::StateInterface(tf_prefix + "rtde_sync", "phase_error", &rtde_phase_error_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface(tf_prefix + "gpio", "tool_temperature", &tool_temperature_));
+      hardware_interface::StateInterface(tf_prefix + "rtde_sync", "max_phase_error", &rtde_max_phase_error_));
 
-  state_interfaces.emplace_back(hardware_interface::StateInterface(tf_prefix + "system_interface", "initialized",
-                                                                   &system_interface_initialized_));
+  state_interfaces.emplace_back(
+      hardware_interface::StateInterface(tf_prefix + "connection", "connected", &connection_connected_));
 
   state_interfaces.emplace_back(
-      hardware_interface::StateInterface(tf_prefix + "gpio", "program_running", &robot_program_running_copy_));
+      hardware_interface::StateInterface(tf_prefix + "connection", "reconnects", &connection_reconnects_));
+
+  state_interfaces.emplace_back(hardware_interface::StateInterface(tf_prefix + "connection", "last_recovery_time",
+                                                                   &connection_last_recovery_time_));
+
+  state_interfaces.emplace_back(hardware_interface::StateInterface(tf_prefix + "connection", "max_recovery_time",
+                                                                   &connection_max_recovery_time_));
 
   return state_interfaces;
 }
@@ -252,6 +344,12 @@ std::vector<hardware_interface::CommandInterface> URPositionHardwareInterface::e
   command_interfaces.emplace_back(
       hardware_interface::CommandInterface(tf_prefix + "gpio", "io_async_success", &io_async_success_));
 
+  command_interfaces.emplace_back(
+      hardware_interface::CommandInterface(tf_prefix + "gpio", "io_batch_sequence", &io_batch_sequence_cmd_));
+
+  command_interfaces.emplace_back(
+      hardware_interface::CommandInterface(tf_prefix + "gpio", "io_batch_acknowledged", &io_batch_acknowledged_));
+
   command_interfaces.emplace_back(hardware_interface::CommandInterface(
       tf_prefix + "speed_scaling", "target_speed_fraction_cmd", &target_speed_fraction_cmd_));
 
@@ -298,6 +396,24 @@ std::vector<hardware_interface::CommandInterface> URPositionHardwareInterface::e
   command_interfaces.emplace_back(hardware_interface::CommandInterface(
       tf_prefix + "zero_ftsensor", "zero_ftsensor_async_success", &zero_ftsensor_async_success_));
 
+  for (size_t i = 0; i < 6; ++i) {
+    command_interfaces.emplace_back(hardware_interface::CommandInterface(
+        tf_prefix + "trajectory_forwarding", "position_" + std::to_string(i), &trajectory_positions_[i]));
+    command_interfaces.emplace_back(hardware_interface::CommandInterface(
+        tf_prefix + "trajectory_forwarding", "velocity_" + std::to_string(i), &trajectory_velocities_[i]));
+    command_interfaces.emplace_back(hardware_interface::CommandInterface(
+        tf_prefix + "trajectory_forwarding", "acceleration_" + std::to_string(i), &trajectory_accelerations_[i]));
+  }
+
+  command_interfaces.emplace_back(hardware_interface::CommandInterface(
+      tf_prefix + "trajectory_forwarding", "time_from_start", &trajectory_time_from_start_));
+
+  command_interfaces.emplace_back(hardware_interface::CommandInterface(
+      tf_prefix + "trajectory_forwarding", "point_count", &trajectory_point_count_));
+
+  command_interfaces.emplace_back(hardware_interface::CommandInterface(
+      tf_prefix + "trajectory_forwarding", "transfer_state", &trajectory_transfer_state_));
+
   return command_interfaces;
 }
 
@@ -359,9 +475,10 @@ URPositionHardwareInterface::on_configure(const rclcpp_lifecycle::State& previou
   // own hash matching your actual robot.
   const std::string calibration_checksum = info_.hardware_parameters["kinematics/hash"];
 
-  std::unique_ptr<urcl::ToolCommSetup> tool_comm_setup;
+  // Kept for setting up the tool communication again whenever the driver is re-created
+  std::shared_ptr<urcl::ToolCommSetup> tool_comm_setup;
   if (use_tool_communication) {
-    tool_comm_setup = std::make_unique<urcl::ToolCommSetup>();
+    tool_comm_setup = std::make_shared<urcl::ToolCommSetup>();
 
     using ToolVoltageT = std::underlying_type<urcl::ToolVoltage>::type;
 
@@ -418,14 +535,40 @@ URPositionHardwareInterface::on_configure(const rclcpp_lifecycle::State& previou
   // distiguishable in the log
   const std::string tf_prefix = info_.hardware_parameters.at("tf_prefix");
   RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Initializing driver...");
-  registerUrclLogHandler(tf_prefix);
-  try {
-    rtde_comm_has_been_started_ = false;
+  const std::string urcl_log_level = info_.hardware_parameters["urcl_log_level"];
+  registerUrclLogHandler(tf_prefix, urcl_log_level.empty() ? "debug" : urcl_log_level);
+
+  // Sets up all connections to the robot, called again by reconnect() whenever the connection has been lost
+  create_driver_ = [=]() {
+    std::unique_ptr<urcl::ToolCommSetup> driver_tool_comm_setup;
+    if (tool_comm_setup) {
+      driver_tool_comm_setup = std::make_unique<urcl::ToolCommSetup>(*tool_comm_setup);
+    }
     ur_driver_ = std::make_unique<urcl::UrDriver>(
         robot_ip, script_filename, output_recipe_filename, input_recipe_filename,
         std::bind(&URPositionHardwareInterface::handleRobotProgramState, this, std::placeholders::_1), headless_mode,
-        std::move(tool_comm_setup), (uint32_t)reverse_port, (uint32_t)script_sender_port, servoj_gain,
+        std::move(driver_tool_comm_setup), (uint32_t)reverse_port, (uint32_t)script_sender_port, servoj_gain,
         servoj_lookahead_time, non_blocking_read_, reverse_ip, trajectory_port, script_command_port);
+    ur_driver_->registerTrajectoryDoneCallback(
+        std::bind(&URPositionHardwareInterface::handleTrajectoryDone, this, std::placeholders::_1));
+
+    if (rtde_recipe_profile_ == RTDERecipeProfile::MOTION && !io_output_recipe_filename_.empty()) {
+      // Path to the file containing the recipe used for requesting RTDE inputs on the low-rate connection. The client
+      // library always sets up inputs, so this has to request an input not written by the control loop's recipe.
+      const std::string io_input_recipe_filename = info_.hardware_parameters["io_input_recipe_filename"];
+      // Frequency in which the robot sends the IO, tool and safety data
+      const double io_rtde_frequency = stod(info_.hardware_parameters["io_rtde_frequency"]);
+      io_rtde_client_ = std::make_unique<rtde::RTDEClient>(robot_ip, io_rtde_notifier_, io_output_recipe_filename_,
+                                                           io_input_recipe_filename, io_rtde_frequency);
+      if (!io_rtde_client_->init()) {
+        throw urcl::UrException("Could not set up the low-rate RTDE recipe");
+      }
+    }
+  };
+
+  try {
+    rtde_comm_has_been_started_ = false;
+    create_driver_();
   } catch (urcl::ToolCommNotAvailable& e) {
     RCLCPP_FATAL_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), "See parameter use_tool_communication");
 
@@ -434,6 +577,10 @@ URPositionHardwareInterface::on_configure(const rclcpp_lifecycle::State& previou
     RCLCPP_FATAL_STREAM(rclcpp::get_logger("URPositionHardwareInterface"), e.what());
     return hardware_interface::CallbackReturn::ERROR;
   }
+
+  // Period in which the robot sends RTDE packages. Used to detect packages that got skipped.
+  rtde_period_ = 1.0 / ur_driver_->getControlFrequency();
+
   // Timeout before the reverse interface will be dropped by the robot
   receive_timeout_ = urcl::RobotReceiveTimeout::millisec(std::stoi(info_.hardware_parameters["keep_alive_count"]) * 20);
 
@@ -475,10 +622,20 @@ URPositionHardwareInterface::on_cleanup(const rclcpp_lifecycle::State& previous_
 
   if (async_thread_) {
     async_thread_shutdown_ = true;
+    async_thread_cv_.notify_one();
     async_thread_->join();
     async_thread_.reset();
   }
 
+  io_rtde_client_.reset();
+  io_data_pkg_.reset();
+
+  if (rtde_packets_received_ > 0) {
+    RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"),
+                "RTDE synchronization: %.0f packages received, %.0f packages missed, maximum phase error %.3f ms",
+                rtde_packets_received_, rtde_missed_packets_, rtde_max_phase_error_ * 1000.0);
+  }
+
   ur_driver_.reset();
 
   unregisterUrclLogHandler();
@@ -510,30 +667,94 @@ void URPositionHardwareInterface::readBitsetData(const std::unique_ptr<rtde::Dat
   }
 }
 
+void URPositionHardwareInterface::readIOData(const std::unique_ptr<rtde::DataPackage>& data_pkg)
+{
+  readData(data_pkg, "standard_analog_input0", standard_analog_input_[0]);
+  readData(data_pkg, "standard_analog_input1", standard_analog_input_[1]);
+  readData(data_pkg, "standard_analog_output0", standard_analog_output_[0]);
+  readData(data_pkg, "standard_analog_output1", standard_analog_output_[1]);
+  readData(data_pkg, "tool_mode", tool_mode_);
+  readData(data_pkg, "tool_analog_input0", tool_analog_input_[0]);
+  readData(data_pkg, "tool_analog_input1", tool_analog_input_[1]);
+  readData(data_pkg, "tool_output_voltage", tool_output_voltage_);
+  readData(data_pkg, "tool_output_current", tool_output_current_);
+  readData(data_pkg, "tool_temperature", tool_temperature_);
+  readData(data_pkg, "robot_mode", robot_mode_);
+  readData(data_pkg, "safety_mode", safety_mode_);
+  readBitsetData<uint32_t>(data_pkg, "robot_status_bits", robot_status_bits_);
+  readBitsetData<uint32_t>(data_pkg, "safety_status_bits", safety_status_bits_);
+  readBitsetData<uint64_t>(data_pkg, "actual_digital_input_bits", actual_dig_in_bits_);
+  readBitsetData<uint64_t>(data_pkg, "actual_digital_output_bits", actual_dig_out_bits_);
+  readBitsetData<uint32_t>(data_pkg, "analog_io_types", analog_io_types_);
+  readBitsetData<uint32_t>(data_pkg, "tool_analog_input_types", tool_analog_input_types_);
+}
+
+bool URPositionHardwareInterface::hasIOData() const
+{
+  return rtde_recipe_profile_ == RTDERecipeProfile::FULL || !io_output_recipe_filename_.empty();
+}
+
 void URPositionHardwareInterface::asyncThread()
 {
   while (!async_thread_shutdown_) {
+    if (reconnecting_) {
+      reconnect();
+      std::this_thread::sleep_for(std::chrono::nanoseconds(20000000));
+      continue;
+    }
+    if (io_rtde_client_ && rtde_comm_has_been_started_) {
+      // Hand the latest low-rate package over to the control loop, older ones are not of interest anymore
+      std::unique_ptr<rtde::DataPackage> io_data_pkg = io_rtde_client_->getDataPackage(std::chrono::milliseconds(0));
+      if (io_data_pkg) {
+        std::lock_guard<std::mutex> lock(io_data_mutex_);
+        io_data_pkg_ = std::move(io_data_pkg);
+      }
+    }
     if (initialized_) {
       //        RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Initialized in async thread");
       checkAsyncIO();
     }
-    std::this_thread::sleep_for(std::chrono::nanoseconds(20000000));
+    // write() wakes this thread up as soon as there is an async command, the timeout keeps polling the IO data
+    std::unique_lock<std::mutex> lock(async_thread_mutex_);
+    async_thread_cv_.wait_for(lock, std::chrono::milliseconds(20), [&]() {
+      return async_command_pending_.load() || async_thread_shutdown_;
+    });
+    async_command_pending_ = false;
   }
 }
 
 hardware_interface::return_type URPositionHardwareInterface::read(const rclcpp::Time& time,
                                                                   const rclcpp::Duration& period)
 {
+  if (reconnecting_) {
+    // The async thread owns the driver until the connection is back. Without a speed scaling the scaled controllers
+    // don't progress meanwhile.
+    speed_scaling_combined_ = 0.0;
+    return hardware_interface::return_type::OK;
+  }
+  connection_connected_ = 1.0;
+  connection_reconnects_ = static_cast<double>(recovery_statistics_.reconnects);
+  connection_last_recovery_time_ = recovery_statistics_.last_recovery_time.count();
+  connection_max_recovery_time_ = recovery_statistics_.max_recovery_time.count();
+
   // We want to start the rtde comm the latest point possible due to the delay times arising from setting up the
   // communication with multiple arms
   if (!rtde_comm_has_been_started_) {
     ur_driver_->startRTDECommunication();
+    if (io_rtde_client_) {
+      io_rtde_client_->start();
+    }
     rtde_comm_has_been_started_ = true;
+    last_rtde_package_time_ = std::chrono::steady_clock::now();
   }
   std::unique_ptr<rtde::DataPackage> data_pkg = ur_driver_->getDataPackage();
 
   if (data_pkg) {
     packet_read_ = true;
+    last_rtde_package_time_ = std::chrono::steady_clock::now();
+    readData(data_pkg, "timestamp", rtde_timestamp_);
+    updateRTDESyncStatistics();
+
     readData(data_pkg, "actual_q", urcl_joint_positions_);
     readData(data_pkg, "actual_qd", urcl_joint_velocities_);
     readData(data_pkg, "actual_current", urcl_joint_efforts_);
@@ -543,27 +764,19 @@ hardware_interface::return_type URPositionHardwareInterface::read(const rclcpp::
     readData(data_pkg, "runtime_state", runtime_state_);
     readData(data_pkg, "actual_TCP_force", urcl_ft_sensor_measurements_);
     readData(data_pkg, "actual_TCP_pose", urcl_tcp_pose_);
-    readData(data_pkg, "standard_analog_input0", standard_analog_input_[0]);
-    readData(data_pkg, "standard_analog_input1", standard_analog_input_[1]);
-    readData(data_pkg, "standard_analog_output0", standard_analog_output_[0]);
-    readData(data_pkg, "standard_analog_output1", standard_analog_output_[1]);
-    readData(data_pkg, "tool_mode", tool_mode_);
-    readData(data_pkg, "tool_analog_input0", tool_analog_input_[0]);
-    readData(data_pkg, "tool_analog_input1", tool_analog_input_[1]);
-    readData(data_pkg, "tool_output_voltage", tool_output_voltage_);
-    readData(data_pkg, "tool_output_current", tool_output_current_);
-    readData(data_pkg, "tool_temperature", tool_temperature_);
-    readData(data_pkg, "robot_mode", robot_mode_);
-    readData(data_pkg, "safety_mode", safety_mode_);
-    readBitsetData<uint32_t>(data_pkg, "robot_status_bits", robot_status_bits_);
-    readBitsetData<uint32_t>(data_pkg, "safety_status_bits", safety_status_bits_);
-    readBitsetData<uint64_t>(data_pkg, "actual_digital_input_bits", actual_dig_in_bits_);
-    readBitsetData<uint64_t>(data_pkg, "actual_digital_output_bits", actual_dig_out_bits_);
-    readBitsetData<uint32_t>(data_pkg, "analog_io_types", analog_io_types_);
-    readBitsetData<uint32_t>(data_pkg, "tool_analog_input_types", tool_analog_input_types_);
+
+    if (rtde_recipe_profile_ == RTDERecipeProfile::FULL) {
+      readIOData(data_pkg);
+    } else if (io_rtde_client_) {
+      // Never wait for the async thread, the data will simply be picked up in the next cycle
+      std::unique_lock<std::mutex> lock(io_data_mutex_, std::try_to_lock);
+      if (lock.owns_lock() && io_data_pkg_) {
+        readIOData(io_data_pkg_);
+        io_data_pkg_.reset();
+      }
+    }
 
     // required transforms
-    extractToolPose();
     transformForceTorque();
 
     // TODO(anyone): logic for sending other stuff to higher level interface
@@ -612,6 +825,22 @@ hardware_interface::return_type URPositionHardwareInterface::read(const rclcpp::
   }
   if (!non_blocking_read_)
     RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"), "Unable to read from hardware...");
+
+  const auto now = std::chrono::steady_clock::now();
+  if (reconnect_timeout_.count() > 0.0 && now - last_rtde_package_time_ > reconnect_timeout_) {
+    RCLCPP_ERROR(rclcpp::get_logger("URPositionHardwareInterface"),
+                 "No data received from the robot for %.1f s, re-establishing the connection",
+                 reconnect_timeout_.count());
+    // The robot program can't be running without the reverse interface, so controllers depending on it get stopped
+    robot_program_running_ = false;
+    robot_program_running_copy_ = 0.0;
+    speed_scaling_combined_ = 0.0;
+    connection_connected_ = 0.0;
+    rtde_sync_interrupted_ = true;
+    connection_lost_time_ = now;
+    next_reconnect_attempt_ = now;
+    reconnecting_ = true;
+  }
   // TODO(anyone): could not read from the driver --> return ERROR --> on error will be called
   return hardware_interface::return_type::OK;
 }
@@ -619,13 +848,31 @@ hardware_interface::return_type URPositionHardwareInterface::read(const rclcpp::
 hardware_interface::return_type URPositionHardwareInterface::write(const rclcpp::Time& time,
                                                                    const rclcpp::Duration& period)
 {
+  if (reconnecting_) {
+    return hardware_interface::return_type::OK;
+  }
+
+  if (initialized_) {
+    handOverIOCommand();
+  }
+
+  // The commands stay pending until the async thread handled them, so a wake-up it missed is repeated next cycle
+  if (initialized_ && hasAsyncCommand()) {
+    async_command_pending_ = true;
+    async_thread_cv_.notify_one();
+  }
+
   // If there is no interpreting program running on the robot, we do not want to send anything.
   // TODO(anyone): We would still like to disable the controllers requiring a writable interface. In ROS1
   // this was done externally using the controller_stopper.
   if ((runtime_state_ == static_cast<uint32_t>(rtde::RUNTIME_STATE::PLAYING) ||
        runtime_state_ == static_cast<uint32_t>(rtde::RUNTIME_STATE::PAUSING)) &&
       robot_program_running_ && (!non_blocking_read_ || packet_read_)) {
-    if (position_controller_running_) {
+    if (trajectory_forwarding_running_ && trajectory_transfer_state_ != TrajectoryTransferState::TRANSFER_IDLE) {
+      // The robot interpolates the forwarded trajectory itself, so there is no setpoint to send in this cycle.
+      forwardTrajectory();
+
+    } else if (position_controller_running_) {
       ur_driver_->writeJointCommand(urcl_position_commands_, urcl::comm::ControlMode::MODE_SERVOJ, receive_timeout_);
 
     } else if (velocity_controller_running_) {
@@ -641,11 +888,99 @@ hardware_interface::return_type URPositionHardwareInterface::write(const rclcpp:
   return hardware_interface::return_type::OK;
 }
 
+void URPositionHardwareInterface::reconnect()
+{
+  if (std::chrono::steady_clock::now() < next_reconnect_attempt_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> driver_lock(driver_mutex_);
+  // The robot accepts only one reverse interface connection, so the old driver has to go first
+  io_rtde_client_.reset();
+  {
+    std::lock_guard<std::mutex> lock(io_data_mutex_);
+    io_data_pkg_.reset();
+  }
+  ur_driver_.reset();
+
+  try {
+    create_driver_();
+    ur_driver_->startRTDECommunication();
+    if (io_rtde_client_) {
+      io_rtde_client_->start();
+    }
+  } catch (urcl::UrException& e) {
+    const std::chrono::milliseconds delay = reconnect_backoff_.next();
+    next_reconnect_attempt_ = std::chrono::steady_clock::now() + delay;
+    RCLCPP_WARN(rclcpp::get_logger("URPositionHardwareInterface"), "Reconnecting failed: '%s'. Retrying in %.1f s",
+                e.what(), std::chrono::duration<double>(delay).count());
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  reconnect_backoff_.reset();
+  recovery_statistics_.recordRecovery(now - connection_lost_time_);
+  last_rtde_package_time_ = now;
+  RCLCPP_INFO(rclcpp::get_logger("URPositionHardwareInterface"), "Connection to the robot re-established after %.2f s",
+              recovery_statistics_.last_recovery_time.count());
+  reconnecting_ = false;
+}
+
 void URPositionHardwareInterface::handleRobotProgramState(bool program_running)
 {
   robot_program_running_ = program_running;
 }
 
+void URPositionHardwareInterface::handleTrajectoryDone(urcl::control::TrajectoryResult result)
+{
+  trajectory_result_ = result;
+  trajectory_done_ = true;
+}
+
+void URPositionHardwareInterface::forwardTrajectory()
+{
+  const int transfer_state = static_cast<int>(trajectory_transfer_state_);
+
+  if (transfer_state == TrajectoryTransferState::TRANSFER_START) {
+    trajectory_done_ = false;
+    last_forwarded_time_from_start_ = 0.0;
+    ur_driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_START,
+                                              static_cast<int>(trajectory_point_count_), trajectory_receive_timeout_);
+    trajectory_transfer_state_ = TrajectoryTransferState::TRANSFER_READY;
+    return;
+  }
+
+  if (transfer_state == TrajectoryTransferState::TRANSFER_CANCEL) {
+    ur_driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_CANCEL, 0,
+                                              trajectory_receive_timeout_);
+    // Continue servoing from where the robot stopped once the controller writes position commands again
+    urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
+    trajectory_transfer_state_ = TrajectoryTransferState::TRANSFER_IDLE;
+    return;
+  }
+
+  if (transfer_state == TrajectoryTransferState::TRANSFER_POINT) {
+    // The robot expects the duration of each spline segment, not the time since the trajectory start
+    ur_driver_->writeTrajectorySplinePoint(trajectory_positions_, trajectory_velocities_, trajectory_accelerations_,
+                                           trajectory_time_from_start_ - last_forwarded_time_from_start_);
+    last_forwarded_time_from_start_ = trajectory_time_from_start_;
+    trajectory_transfer_state_ = TrajectoryTransferState::TRANSFER_READY;
+  }
+
+  if (trajectory_done_ && (transfer_state == TrajectoryTransferState::TRANSFER_READY ||
+                           transfer_state == TrajectoryTransferState::TRANSFER_POINT)) {
+    trajectory_done_ = false;
+    urcl_position_commands_ = urcl_position_commands_old_ = urcl_joint_positions_;
+    trajectory_transfer_state_ = trajectory_result_ == urcl::control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS ?
+                                     TrajectoryTransferState::TRANSFER_DONE :
+                                     TrajectoryTransferState::TRANSFER_FAILED;
+  }
+
+  // Keeps the robot in trajectory forwarding mode while the trajectory is being transferred and executed
+  ur_driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_NOOP, 0,
+                                            trajectory_receive_timeout_);
+}
+
 void URPositionHardwareInterface::initAsyncIO()
 {
   for (size_t i = 0; i < 18; ++i) {
@@ -657,42 +992,89 @@ void URPositionHardwareInterface::initAsyncIO()
   }
 
   tool_voltage_cmd_ = NO_NEW_CMD_;
+  io_batch_sequence_cmd_ = NO_NEW_CMD_;
 
   payload_mass_ = NO_NEW_CMD_;
   payload_center_of_gravity_ = { NO_NEW_CMD_, NO_NEW_CMD_, NO_NEW_CMD_ };
 }
 
+bool URPositionHardwareInterface::hasAsyncCommand() const
+{
+  const auto is_set = [](double cmd) { return !std::isnan(cmd); };
+  return io_command_state_.load(std::memory_order_acquire) == IOCommandState::SENDING ||
+         is_set(target_speed_fraction_cmd_) || is_set(resend_robot_program_cmd_) || is_set(hand_back_control_cmd_) ||
+         is_set(payload_mass_) || is_set(zero_ftsensor_cmd_);
+}
+
+void URPositionHardwareInterface::handOverIOCommand()
+{
+  if (io_command_state_.load(std::memory_order_acquire) == IOCommandState::SENT) {
+    io_async_success_ = io_command_.success;
+    if (!std::isnan(io_command_.batch_sequence)) {
+      io_batch_acknowledged_ = io_command_.batch_sequence;
+    }
+    io_command_state_.store(IOCommandState::IDLE, std::memory_order_relaxed);
+  }
+
+  if (io_command_state_.load(std::memory_order_relaxed) != IOCommandState::IDLE) {
+    // The commands stay in their interfaces until the async thread is done with the previous ones
+    return;
+  }
+  const auto is_set = [](double cmd) { return !std::isnan(cmd); };
+  if (!std::any_of(standard_dig_out_bits_cmd_.begin(), standard_dig_out_bits_cmd_.end(), is_set) &&
+      !std::any_of(standard_analog_output_cmd_.begin(), standard_analog_output_cmd_.end(), is_set) &&
+      !is_set(tool_voltage_cmd_) && !is_set(io_batch_sequence_cmd_)) {
+    return;
+  }
+  io_command_.digital_outputs = standard_dig_out_bits_cmd_;
+  io_command_.analog_outputs = standard_analog_output_cmd_;
+  io_command_.tool_voltage = tool_voltage_cmd_;
+  io_command_.batch_sequence = io_batch_sequence_cmd_;
+  standard_dig_out_bits_cmd_.fill(NO_NEW_CMD_);
+  standard_analog_output_cmd_.fill(NO_NEW_CMD_);
+  tool_voltage_cmd_ = NO_NEW_CMD_;
+  io_batch_sequence_cmd_ = NO_NEW_CMD_;
+  io_command_state_.store(IOCommandState::SENDING, std::memory_order_release);
+}
+
 void URPositionHardwareInterface::checkAsyncIO()
 {
   if (!rtde_comm_has_been_started_) {
     return;
   }
-  for (size_t i = 0; i < 18; ++i) {
-    if (!std::isnan(standard_dig_out_bits_cmd_[i]) && ur_driver_ != nullptr) {
+  if (io_command_state_.load(std::memory_order_acquire) == IOCommandState::SENDING && ur_driver_ != nullptr) {
+    // All IO commands of one snapshot share io_async_success_, so it only reports success if every single one of
+    // them succeeded.
+    bool io_success = true;
+    for (size_t i = 0; i < 18; ++i) {
+      const double cmd = io_command_.digital_outputs[i];
+      if (std::isnan(cmd)) {
+        continue;
+      }
       if (i <= 7) {
-        io_async_success_ =
-            ur_driver_->getRTDEWriter().sendStandardDigitalOutput(i, static_cast<bool>(standard_dig_out_bits_cmd_[i]));
+        io_success &= ur_driver_->getRTDEWriter().sendStandardDigitalOutput(i, static_cast<bool>(cmd));
       } else if (i <= 15) {
-        io_async_success_ = ur_driver_->getRTDEWriter().sendConfigurableDigitalOutput(
-            static_cast<uint8_t>(i - 8), static_cast<bool>(standard_dig_out_bits_cmd_[i]));
+        io_success &= ur_driver_->getRTDEWriter().sendConfigurableDigitalOutput(static_cast<uint8_t>(i - 8),
+                                                                                static_cast<bool>(cmd));
       } else {
-        io_async_success_ = ur_driver_->getRTDEWriter().sendToolDigitalOutput(
-            static_cast<uint8_t>(i - 16), static_cast<bool>(standard_dig_out_bits_cmd_[i]));
+        io_success &=
+            ur_driver_->getRTDEWriter().sendToolDigitalOutput(static_cast<uint8_t>(i - 16), static_cast<bool>(cmd));
       }
-      standard_dig_out_bits_cmd_[i] = NO_NEW_CMD_;
     }
-  }
 
-  for (size_t i = 0; i < 2; ++i) {
-    if (!std::isnan(standard_analog_output_cmd_[i]) && ur_driver_ != nullptr) {
-      io_async_success_ = ur_driver_->getRTDEWriter().sendStandardAnalogOutput(i, standard_analog_output_cmd_[i]);
-      standard_analog_output_cmd_[i] = NO_NEW_CMD_;
+    for (size_t i = 0; i < 2; ++i) {
+      if (!std::isnan(io_command_.analog_outputs[i])) {
+        io_success &= ur_driver_->getRTDEWriter().sendStandardAnalogOutput(i, io_command_.analog_outputs[i]);
+      }
+    }
+
+    if (!std::isnan(io_command_.tool_voltage)) {
+      io_success &= ur_driver_->setToolVoltage(static_cast<urcl::ToolVoltage>(io_command_.tool_voltage));
     }
-  }
 
-  if (!std::isnan(tool_voltage_cmd_) && ur_driver_ != nullptr) {
-    io_async_success_ = ur_driver_->setToolVoltage(static_cast<urcl::ToolVoltage>(tool_voltage_cmd_));
-    tool_voltage_cmd_ = NO_NEW_CMD_;
+    // write() publishes the result, so it never changes while the control loop runs
+    io_command_.success = io_success;
+    io_command_state_.store(IOCommandState::SENT, std::memory_order_release);
   }
 
   if (!std::isnan(target_speed_fraction_cmd_) && ur_driver_ != nullptr) {
@@ -731,23 +1113,12 @@ void URPositionHardwareInterface::checkAsyncIO()
 
 void URPositionHardwareInterface::updateNonDoubleValues()
 {
-  for (size_t i = 0; i < 18; ++i) {
-    actual_dig_out_bits_copy_[i] = static_cast<double>(actual_dig_out_bits_[i]);
-    actual_dig_in_bits_copy_[i] = static_cast<double>(actual_dig_in_bits_[i]);
-  }
-
-  for (size_t i = 0; i < 11; ++i) {
-    safety_status_bits_copy_[i] = static_cast<double>(safety_status_bits_[i]);
-  }
-
-  for (size_t i = 0; i < 4; ++i) {
-    analog_io_types_copy_[i] = static_cast<double>(analog_io_types_[i]);
-    robot_status_bits_copy_[i] = static_cast<double>(robot_status_bits_[i]);
-  }
-
-  for (size_t i = 0; i < 2; ++i) {
-    tool_analog_input_types_copy_[i] = static_cast<double>(tool_analog_input_types_[i]);
-  }
+  expandBitset(actual_dig_out_bits_, actual_dig_out_bits_word_, actual_dig_out_bits_copy_);
+  expandBitset(actual_dig_in_bits_, actual_dig_in_bits_word_, actual_dig_in_bits_copy_);
+  expandBitset(safety_status_bits_, safety_status_bits_word_, safety_status_bits_copy_);
+  expandBitset(analog_io_types_, analog_io_types_word_, analog_io_types_copy_);
+  expandBitset(robot_status_bits_, robot_status_bits_word_, robot_status_bits_copy_);
+  expandBitset(tool_analog_input_types_, tool_analog_input_types_word_, tool_analog_input_types_copy_);
 
   tool_output_voltage_copy_ = static_cast<double>(tool_output_voltage_);
   robot_mode_copy_ = static_cast<double>(robot_mode_);
@@ -757,41 +1128,35 @@ void URPositionHardwareInterface::updateNonDoubleValues()
   robot_program_running_copy_ = robot_program_running_ ? 1.0 : 0.0;
 }
 
-void URPositionHardwareInterface::transformForceTorque()
+void URPositionHardwareInterface::updateRTDESyncStatistics()
 {
-  // imported from ROS1 driver - hardware_interface.cpp#L867-L876
-  tcp_force_.setValue(urcl_ft_sensor_measurements_[0], urcl_ft_sensor_measurements_[1],
-                      urcl_ft_sensor_measurements_[2]);
-  tcp_torque_.setValue(urcl_ft_sensor_measurements_[3], urcl_ft_sensor_measurements_[4],
-                       urcl_ft_sensor_measurements_[5]);
-
-  tf2::Quaternion rotation_quat;
-  tf2::fromMsg(tcp_transform_.transform.rotation, rotation_quat);
-  tcp_force_ = tf2::quatRotate(rotation_quat.inverse(), tcp_force_);
-  tcp_torque_ = tf2::quatRotate(rotation_quat.inverse(), tcp_torque_);
-
-  urcl_ft_sensor_measurements_ = { tcp_force_.x(),  tcp_force_.y(),  tcp_force_.z(),
-                                   tcp_torque_.x(), tcp_torque_.y(), tcp_torque_.z() };
-}
+  const auto now = std::chrono::steady_clock::now();
+
+  // Right after reconnecting, the time without connection would show up as phase error
+  if (rtde_packets_received_ > 0 && rtde_period_ > 0.0 && !rtde_sync_interrupted_) {
+    // Time that passed on the robot since the last package we've read
+    const double robot_delta = rtde_timestamp_ - last_rtde_timestamp_;
+    const long skipped_packages = std::lround(robot_delta / rtde_period_) - 1;
+    if (skipped_packages > 0) {
+      rtde_missed_packets_ += static_cast<double>(skipped_packages);
+    }
 
-void URPositionHardwareInterface::extractToolPose()
-{
-  // imported from ROS1 driver hardware_interface.cpp#L911-L928
-  double tcp_angle =
-      std::sqrt(std::pow(urcl_tcp_pose_[3], 2) + std::pow(urcl_tcp_pose_[4], 2) + std::pow(urcl_tcp_pose_[5], 2));
-
-  tf2::Vector3 rotation_vec(urcl_tcp_pose_[3], urcl_tcp_pose_[4], urcl_tcp_pose_[5]);
-  tf2::Quaternion rotation;
-  if (tcp_angle > 1e-16) {
-    rotation.setRotation(rotation_vec.normalized(), tcp_angle);
-  } else {
-    rotation.setValue(0.0, 0.0, 0.0, 1.0);  // default Quaternion is 0,0,0,0 which is invalid
+    // When the loop is locked to the robot, both clocks advance by the same amount between two packages.
+    const double host_delta = std::chrono::duration<double>(now - last_rtde_read_time_).count();
+    rtde_phase_error_ = host_delta - robot_delta;
+    rtde_max_phase_error_ = std::max(rtde_max_phase_error_, std::abs(rtde_phase_error_));
   }
-  tcp_transform_.transform.translation.x = urcl_tcp_pose_[0];
-  tcp_transform_.transform.translation.y = urcl_tcp_pose_[1];
-  tcp_transform_.transform.translation.z = urcl_tcp_pose_[2];
 
-  tcp_transform_.transform.rotation = tf2::toMsg(rotation);
+  last_rtde_timestamp_ = rtde_timestamp_;
+  last_rtde_read_time_ = now;
+  rtde_packets_received_ += 1.0;
+  rtde_sync_interrupted_ = false;
+}
+
+void URPositionHardwareInterface::transformForceTorque()
+{
+  // The robot reports the wrench in its base frame, while it is expected in the TCP frame
+  rotateWrenchIntoTool(urcl_tcp_pose_, urcl_ft_sensor_measurements_);
 }
 
 hardware_interface::return_type URPositionHardwareInterface::prepare_command_mode_switch(
@@ -801,10 +1166,18 @@ hardware_interface::return_type URPositionHardwareInterface::prepare_command_mod
 
   start_modes_.clear();
   stop_modes_.clear();
+  start_trajectory_forwarding_ = false;
+  stop_trajectory_forwarding_ = false;
+
+  const std::string tf_prefix = info_.hardware_parameters.at("tf_prefix");
+  const std::string transfer_state_interface = tf_prefix + "trajectory_forwarding/transfer_state";
 
   // Starting interfaces
   // add start interface per joint in tmp var for later check
   for (const auto& key : start_interfaces) {
+    if (key == transfer_state_interface) {
+      start_trajectory_forwarding_ = true;
+    }
     for (auto i = 0u; i < info_.joints.size(); i++) {
       if (key == info_.joints[i].name + "/" + hardware_interface::HW_IF_POSITION) {
         start_modes_.push_back(hardware_interface::HW_IF_POSITION);
@@ -827,6 +1200,9 @@ hardware_interface::return_type URPositionHardwareInterface::prepare_command_mod
   // Stopping interfaces
   // add stop interface per joint in tmp var for later check
   for (const auto& key : stop_interfaces) {
+    if (key == transfer_state_interface) {
+      stop_trajectory_forwarding_ = true;
+    }
     for (auto i = 0u; i < info_.joints.size(); i++) {
       if (key == info_.joints[i].name + "/" + hardware_interface::HW_IF_POSITION) {
         stop_modes_.push_back(StoppingInterface::STOP_POSITION);
@@ -851,6 +1227,25 @@ hardware_interface::return_type URPositionHardwareInterface::perform_command_mod
 {
   hardware_interface::return_type ret_val = hardware_interface::return_type::OK;
 
+  if (stop_trajectory_forwarding_) {
+    trajectory_forwarding_running_ = false;
+    if (trajectory_transfer_state_ != TrajectoryTransferState::TRANSFER_IDLE) {
+      // Not waiting for a reconnect in progress, which drops the trajectory on the robot anyway. Once locked,
+      // reconnect() can't replace the driver until the message is written.
+      std::unique_lock<std::mutex> driver_lock(driver_mutex_, std::try_to_lock);
+      if (driver_lock.owns_lock() && !reconnecting_ && ur_driver_) {
+        // Don't leave a trajectory running on the robot that no controller is supervising anymore
+        ur_driver_->writeTrajectoryControlMessage(urcl::control::TrajectoryControlMessage::TRAJECTORY_CANCEL, 0,
+                                                  trajectory_receive_timeout_);
+      }
+      trajectory_transfer_state_ = TrajectoryTransferState::TRANSFER_IDLE;
+    }
+  }
+  if (start_trajectory_forwarding_) {
+    trajectory_transfer_state_ = TrajectoryTransferState::TRANSFER_IDLE;
+    trajectory_forwarding_running_ = true;
+  }
+
   if (stop_modes_.size() != 0 &&
       std::find(stop_modes_.begin(), stop_modes_.end(), StoppingInterface::STOP_POSITION) != stop_modes_.end()) {
     position_controller_running_ = false;
@@ -876,6 +1271,8 @@ hardware_interface::return_type URPositionHardwareInterface::perform_command_mod
 
   start_modes_.clear();
   stop_modes_.clear();
+  start_trajectory_forwarding_ = false;
+  stop_trajectory_forwarding_ = false;
 
   return ret_val;
 }
@@ -0,0 +1,233 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_robot_driver/script_execution_tracker.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace ur_robot_driver
+{
+namespace
+{
+const std::string STARTED_PREFIX = "urscript_interface started ";
+const std::string FINISHED_PREFIX = "urscript_interface finished ";
+const std::string SHUT_DOWN_MESSAGE = "Shut down before the execution finished";
+
+// Package and robot message types as documented for the primary interface
+constexpr uint8_t ROBOT_MESSAGE = 20;
+constexpr int8_t ROBOT_MESSAGE_TEXT = 0;
+constexpr int8_t ROBOT_MESSAGE_RUNTIME_EXCEPTION = 10;
+// Package size and type, followed by the message's timestamp, source and type
+constexpr size_t ROBOT_MESSAGE_HEADER_SIZE = 4 + 1 + 8 + 1 + 1;
+
+int32_t readInt32(const uint8_t* data)
+{
+  return static_cast<int32_t>(static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 |
+                              static_cast<uint32_t>(data[2]) << 8 | static_cast<uint32_t>(data[3]));
+}
+
+bool parseMarker(const std::string& text, const std::string& prefix, uint64_t& id)
+{
+  if (text.size() <= prefix.size() || text.compare(0, prefix.size(), prefix) != 0 ||
+      text.find_first_not_of("0123456789", prefix.size()) != std::string::npos) {
+    return false;
+  }
+  id = std::stoull(text.substr(prefix.size()));
+  return true;
+}
+}  // namespace
+
+uint64_t ScriptExecutionTracker::add()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t id = next_id_++;
+  Execution& execution = executions_[id];
+  execution.submitted = Clock::now();
+  if (shut_down_) {
+    execution.state = State::FAILED;
+    execution.message = SHUT_DOWN_MESSAGE;
+    execution.finished = execution.submitted;
+  }
+  return id;
+}
+
+std::vector<std::string> ScriptExecutionTracker::wrapSnippets(uint64_t id, const std::vector<std::string>& snippets)
+{
+  std::vector<std::string> wrapped;
+  wrapped.reserve(snippets.size() + 2);
+  wrapped.push_back("textmsg(\"" + STARTED_PREFIX + std::to_string(id) + "\")");
+  wrapped.insert(wrapped.end(), snippets.begin(), snippets.end());
+  wrapped.push_back("textmsg(\"" + FINISHED_PREFIX + std::to_string(id) + "\")");
+  return wrapped;
+}
+
+void ScriptExecutionTracker::markSent(uint64_t id, bool success, const std::string& message)
+{
+  const Clock::time_point now = Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto execution = executions_.find(id);
+    if (execution == executions_.end()) {
+      return;
+    }
+    Execution& e = execution->second;
+    if (e.state != State::QUEUED) {
+      // The robot's messages overtook the queue reporting the delivery
+      e.sent = std::min(now, e.sent);
+      return;
+    }
+    e.sent = now;
+    if (success) {
+      e.state = State::SENT;
+    } else {
+      e.state = State::FAILED;
+      e.message = message;
+      e.finished = now;
+    }
+  }
+  changed_cv_.notify_all();
+}
+
+void ScriptExecutionTracker::handleMessage(const PrimaryRobotMessage& message)
+{
+  const Clock::time_point now = Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (message.type == PrimaryRobotMessage::Type::RUNTIME_EXCEPTION) {
+      const auto execution = std::find_if(executions_.begin(), executions_.end(), [](const auto& e) {
+        return e.second.state == State::SENT || e.second.state == State::STARTED;
+      });
+      if (execution == executions_.end()) {
+        return;
+      }
+      Execution& e = execution->second;
+      e.state = State::FAILED;
+      e.message = "Runtime exception at line " + std::to_string(message.line) + ", column " +
+                  std::to_string(message.column) + ": " + message.text;
+      e.finished = now;
+    } else {
+      uint64_t id;
+      const bool started = parseMarker(message.text, STARTED_PREFIX, id);
+      if (!started && !parseMarker(message.text, FINISHED_PREFIX, id)) {
+        return;
+      }
+      const auto execution = executions_.find(id);
+      if (execution == executions_.end()) {
+        return;
+      }
+      Execution& e = execution->second;
+      if (e.state == State::FINISHED || e.state == State::FAILED || (started && e.state == State::STARTED)) {
+        return;
+      }
+      if (e.state == State::QUEUED) {
+        e.sent = now;
+      }
+      if (e.state != State::STARTED) {
+        e.started = now;
+      }
+      if (started) {
+        e.state = State::STARTED;
+      } else {
+        e.state = State::FINISHED;
+        e.finished = now;
+      }
+    }
+  }
+  changed_cv_.notify_all();
+}
+
+ScriptExecutionTracker::Execution ScriptExecutionTracker::waitForChange(uint64_t id, State known_state,
+                                                                        Clock::time_point deadline)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_cv_.wait_until(lock, deadline, [&]() {
+    const auto execution = executions_.find(id);
+    return execution == executions_.end() || execution->second.state != known_state;
+  });
+  const auto execution = executions_.find(id);
+  return execution == executions_.end() ? Execution() : execution->second;
+}
+
+void ScriptExecutionTracker::remove(uint64_t id)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  executions_.erase(id);
+}
+
+void ScriptExecutionTracker::shutdown()
+{
+  const Clock::time_point now = Clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shut_down_ = true;
+    for (auto& [id, execution] : executions_) {
+      if (execution.state != State::FINISHED && execution.state != State::FAILED) {
+        execution.state = State::FAILED;
+        execution.message = SHUT_DOWN_MESSAGE;
+        execution.finished = now;
+      }
+    }
+  }
+  changed_cv_.notify_all();
+}
+
+std::optional<PrimaryRobotMessage> ScriptExecutionTracker::parseRobotMessage(const uint8_t* data, size_t size)
+{
+  if (size < ROBOT_MESSAGE_HEADER_SIZE || data[4] != ROBOT_MESSAGE) {
+    return std::nullopt;
+  }
+  const auto message_type = static_cast<int8_t>(data[ROBOT_MESSAGE_HEADER_SIZE - 1]);
+  const uint8_t* payload = data + ROBOT_MESSAGE_HEADER_SIZE;
+  const size_t payload_size = size - ROBOT_MESSAGE_HEADER_SIZE;
+
+  PrimaryRobotMessage message;
+  if (message_type == ROBOT_MESSAGE_TEXT) {
+    message.type = PrimaryRobotMessage::Type::TEXT;
+    message.text.assign(reinterpret_cast<const char*>(payload), payload_size);
+    return message;
+  }
+  if (message_type == ROBOT_MESSAGE_RUNTIME_EXCEPTION && payload_size >= 8) {
+    message.type = PrimaryRobotMessage::Type::RUNTIME_EXCEPTION;
+    message.line = readInt32(payload);
+    message.column = readInt32(payload + 4);
+    message.text.assign(reinterpret_cast<const char*>(payload + 8), payload_size - 8);
+    return message;
+  }
+  return std::nullopt;
+}
+}  // namespace ur_robot_driver
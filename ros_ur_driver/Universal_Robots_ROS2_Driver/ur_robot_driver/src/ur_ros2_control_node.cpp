@@ -37,15 +37,36 @@
 
 #include <thread>
 #include <memory>
+#include <string>
+#include <vector>
 
 // ROS includes
 #include "controller_manager/controller_manager.hpp"
+#include "hardware_interface/component_parser.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "realtime_tools/thread_priority.hpp"
 
 // code is inspired by
 // https://github.com/ros-controls/ros2_control/blob/master/controller_manager/src/ros2_control_node.cpp
 
+// Checks whether any UR hardware in the robot description returns from read() without waiting for a package
+bool hasNonBlockingRead(const std::string& robot_description)
+{
+  const std::vector<hardware_interface::HardwareInfo> hardware_infos =
+      hardware_interface::parse_control_resources_from_urdf(robot_description);
+  for (const auto& hardware_info : hardware_infos) {
+    if (hardware_info.hardware_class_type != "ur_robot_driver/URPositionHardwareInterface") {
+      continue;
+    }
+    const auto non_blocking_read = hardware_info.hardware_parameters.find("non_blocking_read");
+    if (non_blocking_read == hardware_info.hardware_parameters.end() || non_blocking_read->second == "true" ||
+        non_blocking_read->second == "True") {
+      return true;
+    }
+  }
+  return false;
+}
+
 int main(int argc, char** argv)
 {
   rclcpp::init(argc, argv);
@@ -55,8 +76,32 @@ int main(int argc, char** argv)
   // create controller manager instance
   auto controller_manager = std::make_shared<controller_manager::ControllerManager>(e, "controller_manager");
 
+  // When enabled, the control loop is paced by the RTDE packages sent from the robot instead of a free-running timer.
+  // This requires the hardware interface to be configured with non_blocking_read:=false, so that its read() blocks
+  // until the next package arrived.
+  bool rtde_synchronized = false;
+  controller_manager->get_parameter_or("rtde_synchronized", rtde_synchronized, false);
+  if (rtde_synchronized) {
+    std::string robot_description;
+    controller_manager->get_parameter_or("robot_description", robot_description, std::string());
+    try {
+      if (hasNonBlockingRead(robot_description)) {
+        RCLCPP_ERROR(controller_manager->get_logger(), "rtde_synchronized requires the hardware to be configured "
+                                                       "with non_blocking_read:=false. Falling back to a control loop "
+                                                       "running at update_rate.");
+        rtde_synchronized = false;
+      }
+    } catch (const std::runtime_error& e) {
+      RCLCPP_ERROR(controller_manager->get_logger(),
+                   "Could not check the hardware's read mode, falling back to a control loop running at "
+                   "update_rate: %s",
+                   e.what());
+      rtde_synchronized = false;
+    }
+  }
+
   // control loop thread
-  std::thread control_loop([controller_manager]() {
+  std::thread control_loop([controller_manager, rtde_synchronized]() {
     if (!realtime_tools::configure_sched_fifo(50)) {
       RCLCPP_WARN(controller_manager->get_logger(), "Could not enable FIFO RT scheduling policy");
     }
@@ -69,6 +114,10 @@ int main(int argc, char** argv)
     // for calculating the measured period of the loop
     rclcpp::Time previous_time = controller_manager->now();
 
+    if (rtde_synchronized) {
+      RCLCPP_INFO(controller_manager->get_logger(), "Control loop is synchronized to the robot's RTDE packages");
+    }
+
     while (rclcpp::ok()) {
       // calculate measured period
       auto const current_time = controller_manager->now();
@@ -80,6 +129,17 @@ int main(int argc, char** argv)
       controller_manager->update(controller_manager->now(), measured_period);
       controller_manager->write(controller_manager->now(), measured_period);
 
+      if (rtde_synchronized) {
+        // read() blocks until the next package arrived, so there is nothing to wait for here. Should read() have
+        // returned without waiting (e.g. because the connection was lost), we wait for half a period to avoid
+        // spinning at full speed.
+        auto const cycle_start =
+            std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>{ std::chrono::nanoseconds(
+                current_time.nanoseconds()) };
+        std::this_thread::sleep_until(cycle_start + period / 2);
+        continue;
+      }
+
       // wait until we hit the end of the period
       next_iteration_time += period;
       std::this_thread::sleep_until(next_iteration_time);
@@ -40,52 +40,171 @@
 // in all copies of the Source Code. By using the Source Code, you agree to the above terms. For more information,
 // please contact legal@universal-robots.com.
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <memory>
 #include <utility>
 
 #include "ur_robot_driver/urcl_log_handler.hpp"
 #include "rclcpp/logging.hpp"
+#include "rcutils/error_handling.h"
 
 namespace ur_robot_driver
 {
 bool g_registered = false;
-std::unique_ptr<UrclLogHandler> g_log_handler(new UrclLogHandler);
 
-UrclLogHandler::UrclLogHandler() = default;
-
-void UrclLogHandler::log(const char* file, int line, urcl::LogLevel loglevel, const char* message)
+namespace
+{
+int toRcutilsSeverity(urcl::LogLevel loglevel)
 {
-  rcutils_log_location_t location = { "", file, static_cast<size_t>(line) };
-
-  const auto logger_name = "UR_Client_Library:" + tf_prefix_;
   switch (loglevel) {
     case urcl::LogLevel::DEBUG:
-      rcutils_log(&location, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_DEBUG, logger_name.c_str(), "%s", message);
-      break;
+      return RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_DEBUG;
     case urcl::LogLevel::INFO:
-      rcutils_log(&location, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_INFO, logger_name.c_str(), "%s", message);
-      break;
+      return RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_INFO;
     case urcl::LogLevel::WARN:
-      rcutils_log(&location, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_WARN, logger_name.c_str(), "%s", message);
-      break;
+      return RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_WARN;
     case urcl::LogLevel::ERROR:
-      rcutils_log(&location, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_ERROR, logger_name.c_str(), "%s", message);
-      break;
+      return RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_ERROR;
     case urcl::LogLevel::FATAL:
-      rcutils_log(&location, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_FATAL, logger_name.c_str(), "%s", message);
-      break;
+      return RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_FATAL;
     default:
+      return RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_UNSET;
+  }
+}
+
+urcl::LogLevel toUrclLogLevel(int severity)
+{
+  if (severity <= RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_DEBUG) {
+    return urcl::LogLevel::DEBUG;
+  } else if (severity <= RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_INFO) {
+    return urcl::LogLevel::INFO;
+  } else if (severity <= RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_WARN) {
+    return urcl::LogLevel::WARN;
+  } else if (severity <= RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_ERROR) {
+    return urcl::LogLevel::ERROR;
+  }
+  return urcl::LogLevel::FATAL;
+}
+}  // namespace
+
+UrclLogHandler::UrclLogHandler(const std::string& tf_prefix)
+  : tf_prefix_(tf_prefix), logger_name_("UR_Client_Library:" + tf_prefix)
+{
+  for (size_t i = 0; i < QUEUE_SIZE; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  thread_ = std::thread(&UrclLogHandler::run, this);
+}
+
+UrclLogHandler::~UrclLogHandler()
+{
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void UrclLogHandler::log(const char* file, int line, urcl::LogLevel loglevel, const char* message)
+{
+  const int severity = toRcutilsSeverity(loglevel);
+  if (severity == RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_UNSET) {
+    return;
+  }
+  // The ROS log level may be changed at any time, so it is checked for every message instead of once on registration
+  if (!rcutils_logging_logger_is_enabled_for(logger_name_.c_str(), severity)) {
+    return;
+  }
+
+  // Claim a slot. The slot's sequence tells whether it has already been consumed in the previous round.
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots_[pos % QUEUE_SIZE];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // Queue is full, don't wait for the logging backend
+      dropped_messages_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->entry.file = file;
+  slot->entry.line = line;
+  slot->entry.severity = severity;
+  const size_t length = std::min(std::strlen(message), MAX_MESSAGE_LENGTH - 1);
+  std::memcpy(slot->entry.message, message, length);
+  slot->entry.message[length] = '\0';
+  slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool UrclLogHandler::logQueued()
+{
+  bool logged = false;
+  while (true) {
+    Slot& slot = slots_[dequeue_pos_ % QUEUE_SIZE];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
       break;
+    }
+
+    const Entry& entry = slot.entry;
+    rcutils_log_location_t location = { "", entry.file, static_cast<size_t>(entry.line) };
+    rcutils_log(&location, entry.severity, logger_name_.c_str(), "%s", entry.message);
+
+    // Hand the slot back to the producers for the next round
+    slot.sequence.store(dequeue_pos_ + QUEUE_SIZE, std::memory_order_release);
+    ++dequeue_pos_;
+    logged = true;
+  }
+
+  const uint64_t dropped_messages = dropped_messages_.load(std::memory_order_relaxed);
+  if (dropped_messages != reported_dropped_messages_) {
+    rcutils_log(nullptr, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_WARN, logger_name_.c_str(),
+                "Dropped %lu log messages of the client library as they came in faster than they could be logged "
+                "(%lu in total).",
+                static_cast<unsigned long>(dropped_messages - reported_dropped_messages_),
+                static_cast<unsigned long>(dropped_messages));
+    reported_dropped_messages_ = dropped_messages;
+  }
+
+  return logged;
+}
+
+void UrclLogHandler::run()
+{
+  while (running_) {
+    if (!logQueued()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
   }
+  // Don't lose the messages logged right before shutting down
+  logQueued();
 }
 
-void registerUrclLogHandler(const std::string& tf_prefix)
+void registerUrclLogHandler(const std::string& tf_prefix, const std::string& log_level)
 {
   if (g_registered == false) {
-    g_log_handler->setTFPrefix(tf_prefix);
-    // Log level is decided by ROS2 log level
-    urcl::setLogLevel(urcl::LogLevel::DEBUG);
-    urcl::registerLogHandler(std::move(g_log_handler));
+    auto log_handler = std::make_unique<UrclLogHandler>(tf_prefix);
+    // Messages below this level aren't even formatted by the client library, all others are filtered by the ROS2 log
+    // level in log()
+    int severity = RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_DEBUG;
+    if (rcutils_logging_severity_level_from_string(log_level.c_str(), rcutils_get_default_allocator(), &severity) !=
+        RCUTILS_RET_OK) {
+      rcutils_reset_error();
+      severity = RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_DEBUG;
+      rcutils_log(nullptr, RCUTILS_LOG_SEVERITY::RCUTILS_LOG_SEVERITY_WARN, log_handler->logger_name_.c_str(),
+                  "Unknown log level '%s' for the client library, using 'debug' instead.", log_level.c_str());
+    }
+    urcl::setLogLevel(toUrclLogLevel(severity));
+    urcl::registerLogHandler(std::move(log_handler));
     g_registered = true;
   }
 }
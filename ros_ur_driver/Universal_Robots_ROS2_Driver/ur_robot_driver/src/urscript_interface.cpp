@@ -38,35 +38,59 @@
 #include <ur_client_library/comm/stream.h>
 #include <ur_client_library/primary/primary_package.h>
 
+#include <sys/time.h>
+
+#include <atomic>
+#include <chrono>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <rclcpp/rclcpp.hpp>
+#include <rclcpp_action/rclcpp_action.hpp>
 #include <std_msgs/msg/string.hpp>
+#include <ur_dashboard_msgs/action/execute_script.hpp>
+#include <ur_dashboard_msgs/srv/send_script.hpp>
+
+#include "ur_robot_driver/script_execution_tracker.hpp"
+#include "ur_robot_driver/urscript_queue.hpp"
+
+using ur_robot_driver::ScriptExecutionTracker;
+using ur_robot_driver::URScriptQueue;
+using ur_robot_driver::URScriptTemplate;
+using ExecuteScript = ur_dashboard_msgs::action::ExecuteScript;
+using GoalHandleExecuteScript = rclcpp_action::ServerGoalHandle<ExecuteScript>;
 
 class URScriptInterface : public rclcpp::Node
 {
 public:
   URScriptInterface()
     : Node("urscript_interface")
-    , m_script_sub(this->create_subscription<std_msgs::msg::String>(
-          "~/script_command", 1, [this](const std_msgs::msg::String::SharedPtr msg) {
-            auto program_with_newline = msg->data + '\n';
-
-            RCLCPP_INFO_STREAM(this->get_logger(), program_with_newline);
-
-            size_t len = program_with_newline.size();
-            const auto* data = reinterpret_cast<const uint8_t*>(program_with_newline.c_str());
-            size_t written;
-
-            if (m_secondary_stream->write(data, len, written)) {
-              URCL_LOG_INFO("Sent program to robot:\n%s", program_with_newline.c_str());
-              return true;
-            }
-            URCL_LOG_ERROR("Could not send program to robot");
-            return false;
-          }))
   {
     this->declare_parameter("robot_ip", rclcpp::PARAMETER_STRING);
+    // Number of submissions that can wait for being sent, further ones are rejected
+    const int64_t queue_size = this->declare_parameter<int64_t>("script_queue_size", 32);
+    // Number of snippets after which no further submissions are merged into the same secondary program
+    const int64_t max_batch_snippets = this->declare_parameter<int64_t>("max_batch_snippets", 100);
+    // Time in seconds to wait for the snippets of an execute_script goal being executed
+    m_script_timeout = this->declare_parameter<double>("script_timeout", 10.0);
+    // Names of the script templates, each given as parameter script_templates.<name>
+    const auto template_names =
+        this->declare_parameter<std::vector<std::string>>("script_template_names", std::vector<std::string>());
+    for (const auto& name : template_names) {
+      const std::string text = this->declare_parameter<std::string>("script_templates." + name, "");
+      try {
+        m_templates.emplace(name, URScriptTemplate(text));
+      } catch (const std::invalid_argument& e) {
+        RCLCPP_ERROR(this->get_logger(), "Ignoring script template '%s': %s", name.c_str(), e.what());
+      }
+    }
+
     m_secondary_stream = std::make_unique<urcl::comm::URStream<urcl::primary_interface::PrimaryPackage>>(
         this->get_parameter("robot_ip").as_string(), urcl::primary_interface::UR_SECONDARY_PORT);
     m_secondary_stream->connect();
@@ -76,17 +100,246 @@ public:
     const auto* data = reinterpret_cast<const uint8_t*>(program_with_newline.c_str());
     size_t written;
     m_secondary_stream->write(data, len, written);
+
+    m_queue = std::make_unique<URScriptQueue>(
+        [this](const std::string& program) {
+          RCLCPP_DEBUG(this->get_logger(), "Sending program to robot:\n%s", program.c_str());
+          const auto* data = reinterpret_cast<const uint8_t*>(program.c_str());
+          size_t written;
+          if (m_secondary_stream->write(data, program.size(), written)) {
+            return true;
+          }
+          RCLCPP_ERROR(this->get_logger(), "Could not send program to robot");
+          return false;
+        },
+        static_cast<size_t>(queue_size), static_cast<size_t>(max_batch_snippets));
+
+    // The primary interface reports the progress of the snippets sent through the execute_script action
+    m_primary_stream = std::make_unique<urcl::comm::URStream<urcl::primary_interface::PrimaryPackage>>(
+        this->get_parameter("robot_ip").as_string(), urcl::primary_interface::UR_PRIMARY_PORT);
+    m_primary_stream->connect();
+    // Wakes up the reader regularly for checking whether to stop, even if the robot doesn't send anything
+    m_primary_stream->setReceiveTimeout(timeval{ 1, 0 });
+    m_reader_thread = std::thread(&URScriptInterface::readPrimaryInterface, this);
+
+    // Concurrent service calls wait for their delivery at the same time, so their snippets can share a program
+    m_callback_group = this->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+
+    m_script_sub = this->create_subscription<std_msgs::msg::String>(
+        "~/script_command", 10, [this](const std_msgs::msg::String::SharedPtr msg) {
+          // Sent as it is. Nobody waits for the delivery, so only a rejection is reported.
+          auto delivered = m_queue->submitProgram(msg->data);
+          if (delivered.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+              delivered.get() == URScriptQueue::DeliveryStatus::QUEUE_FULL) {
+            RCLCPP_WARN_THROTTLE(this->get_logger(), *this->get_clock(), 1000,
+                                 "Script queue is full, dropping script commands");
+          }
+        });
+
+    m_send_script_srv = this->create_service<ur_dashboard_msgs::srv::SendScript>(
+        "~/send_script",
+        [this](const ur_dashboard_msgs::srv::SendScript::Request::SharedPtr req,
+               ur_dashboard_msgs::srv::SendScript::Response::SharedPtr resp) { sendScript(req, resp); },
+        rmw_qos_profile_services_default, m_callback_group);
+
+    m_execute_script_server = rclcpp_action::create_server<ExecuteScript>(
+        this, "~/execute_script",
+        [](const rclcpp_action::GoalUUID& /*uuid*/, std::shared_ptr<const ExecuteScript::Goal> /*goal*/) {
+          return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+        },
+        [](const std::shared_ptr<GoalHandleExecuteScript> /*goal_handle*/) {
+          // Once sent, the robot runs the snippets anyway
+          return rclcpp_action::CancelResponse::REJECT;
+        },
+        [this](const std::shared_ptr<GoalHandleExecuteScript> goal_handle) { startGoalThread(goal_handle); },
+        rcl_action_server_get_default_options(), m_callback_group);
+  }
+
+  ~URScriptInterface() override
+  {
+    // Goals waiting for the robot fail right away instead of running into their timeout
+    m_tracker.shutdown();
+    {
+      std::lock_guard<std::mutex> lock(m_goal_threads_mutex);
+      m_goal_threads_closed = true;
+      for (auto& goal_thread : m_goal_threads) {
+        goal_thread.thread.join();
+      }
+    }
+    m_reading = false;
+    m_reader_thread.join();
   }
 
 private:
-  rclcpp::Subscription<std_msgs::msg::String>::SharedPtr m_script_sub;
+  struct GoalThread
+  {
+    std::thread thread;
+    std::atomic<bool> finished{ false };
+  };
+
+  void startGoalThread(const std::shared_ptr<GoalHandleExecuteScript> goal_handle)
+  {
+    std::lock_guard<std::mutex> lock(m_goal_threads_mutex);
+    if (m_goal_threads_closed) {
+      auto result = std::make_shared<ExecuteScript::Result>();
+      result->success = false;
+      result->message = "Shutting down, no more scripts are executed";
+      goal_handle->abort(result);
+      return;
+    }
+    // Threads of finished goals are joined here, so the list only grows with the goals running concurrently
+    m_goal_threads.remove_if([](GoalThread& goal_thread) {
+      if (!goal_thread.finished) {
+        return false;
+      }
+      goal_thread.thread.join();
+      return true;
+    });
+    GoalThread& goal_thread = m_goal_threads.emplace_back();
+    goal_thread.thread = std::thread([this, goal_handle, &goal_thread]() {
+      try {
+        executeScript(goal_handle);
+      } catch (const std::exception& e) {
+        // Reporting the result fails once the context is shut down, e.g. by Ctrl-C while waiting for the robot
+        RCLCPP_WARN(this->get_logger(), "Could not finish the execute_script goal: %s", e.what());
+      }
+      goal_thread.finished = true;
+    });
+  }
+
+  void readPrimaryInterface()
+  {
+    uint8_t buffer[4096];
+    size_t read;
+    while (m_reading) {
+      if (!m_primary_stream->read(buffer, sizeof(buffer), read)) {
+        if (m_primary_stream->getState() != urcl::comm::SocketState::Connected && m_reading) {
+          RCLCPP_WARN(this->get_logger(), "Lost connection to the primary interface, reconnecting");
+          m_primary_stream->connect();
+        }
+        continue;
+      }
+      if (const auto message = ScriptExecutionTracker::parseRobotMessage(buffer, read)) {
+        m_tracker.handleMessage(*message);
+      }
+    }
+  }
+
+  void executeScript(const std::shared_ptr<GoalHandleExecuteScript> goal_handle)
+  {
+    const auto goal = goal_handle->get_goal();
+    const double timeout = goal->timeout > 0.0 ? goal->timeout : m_script_timeout;
+    const ScriptExecutionTracker::Clock::time_point deadline =
+        ScriptExecutionTracker::Clock::now() +
+        std::chrono::duration_cast<ScriptExecutionTracker::Clock::duration>(std::chrono::duration<double>(timeout));
+
+    const uint64_t id = m_tracker.add();
+    // In a program of its own, as a runtime exception aborts the whole program and can't be attributed to a snippet
+    const URScriptQueue::DeliveryStatus status =
+        m_queue->submitSnippets(ScriptExecutionTracker::wrapSnippets(id, goal->snippets), true).get();
+    m_tracker.markSent(id, status == URScriptQueue::DeliveryStatus::SENT, URScriptQueue::toString(status));
+
+    auto feedback = std::make_shared<ExecuteScript::Feedback>();
+    auto execution = m_tracker.waitForChange(id, ScriptExecutionTracker::State::QUEUED, deadline);
+    while (execution.state == ScriptExecutionTracker::State::SENT ||
+           execution.state == ScriptExecutionTracker::State::STARTED) {
+      feedback->state = execution.state == ScriptExecutionTracker::State::SENT ? "sent" : "started";
+      goal_handle->publish_feedback(feedback);
+      const ScriptExecutionTracker::State known_state = execution.state;
+      execution = m_tracker.waitForChange(id, known_state, deadline);
+      if (execution.state == known_state) {
+        break;
+      }
+    }
+    m_tracker.remove(id);
+
+    auto result = std::make_shared<ExecuteScript::Result>();
+    const auto seconds = [](ScriptExecutionTracker::Clock::time_point from,
+                            ScriptExecutionTracker::Clock::time_point to) {
+      if (from == ScriptExecutionTracker::Clock::time_point() || to == ScriptExecutionTracker::Clock::time_point()) {
+        return 0.0;
+      }
+      return std::chrono::duration<double>(to - from).count();
+    };
+    result->send_duration = seconds(execution.submitted, execution.sent);
+    result->start_duration = seconds(execution.sent, execution.started);
+    result->execution_duration = seconds(execution.started, execution.finished);
+
+    switch (execution.state) {
+      case ScriptExecutionTracker::State::FINISHED:
+        result->success = true;
+        result->message = "finished";
+        goal_handle->succeed(result);
+        return;
+      case ScriptExecutionTracker::State::FAILED:
+        result->message = execution.message;
+        break;
+      case ScriptExecutionTracker::State::STARTED:
+        result->message = "Timed out while the robot executed the snippets";
+        break;
+      default:
+        result->message = "Timed out waiting for the robot to start executing the snippets";
+        break;
+    }
+    result->success = false;
+    RCLCPP_WARN(this->get_logger(), "Script execution failed: %s", result->message.c_str());
+    goal_handle->abort(result);
+  }
+
+  void sendScript(const ur_dashboard_msgs::srv::SendScript::Request::SharedPtr req,
+                  ur_dashboard_msgs::srv::SendScript::Response::SharedPtr resp)
+  {
+    std::vector<std::string> snippets = req->snippets;
+    if (!req->template_name.empty()) {
+      const auto script_template = m_templates.find(req->template_name);
+      if (script_template == m_templates.end()) {
+        resp->success = false;
+        resp->message = "unknown template '" + req->template_name + "'";
+        return;
+      }
+      try {
+        snippets.push_back(script_template->second.fill(req->template_values));
+      } catch (const std::invalid_argument& e) {
+        resp->success = false;
+        resp->message = e.what();
+        return;
+      }
+    }
+
+    const URScriptQueue::DeliveryStatus status = m_queue->submitSnippets(snippets).get();
+    resp->success = status == URScriptQueue::DeliveryStatus::SENT;
+    resp->message = URScriptQueue::toString(status);
+  }
+
+  std::unordered_map<std::string, URScriptTemplate> m_templates;
   std::unique_ptr<urcl::comm::URStream<urcl::primary_interface::PrimaryPackage>> m_secondary_stream;
+  // Destroyed before the stream it writes to
+  std::unique_ptr<URScriptQueue> m_queue;
+  std::unique_ptr<urcl::comm::URStream<urcl::primary_interface::PrimaryPackage>> m_primary_stream;
+  ScriptExecutionTracker m_tracker;
+  double m_script_timeout;
+  std::atomic<bool> m_reading{ true };
+  std::thread m_reader_thread;
+  // Each execute_script goal waits for the robot in a thread of its own
+  std::mutex m_goal_threads_mutex;
+  std::list<GoalThread> m_goal_threads;
+  bool m_goal_threads_closed = false;
+  rclcpp::CallbackGroup::SharedPtr m_callback_group;
+  rclcpp::Subscription<std_msgs::msg::String>::SharedPtr m_script_sub;
+  rclcpp::Service<ur_dashboard_msgs::srv::SendScript>::SharedPtr m_send_script_srv;
+  rclcpp_action::Server<ExecuteScript>::SharedPtr m_execute_script_server;
 };
 
 int main(int argc, char** argv)
 {
   rclcpp::init(argc, argv);
-  rclcpp::spin(std::make_unique<URScriptInterface>());
+  rclcpp::executors::MultiThreadedExecutor executor;
+  auto node = std::make_shared<URScriptInterface>();
+  executor.add_node(node);
+  executor.spin();
+  // The node's destructor finishes the waiting execute_script goals, which needs the context
+  executor.remove_node(node);
+  node.reset();
   rclcpp::shutdown();
   return 0;
 }
@@ -0,0 +1,228 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include "ur_robot_driver/urscript_queue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ur_robot_driver
+{
+URScriptTemplate::URScriptTemplate(const std::string& text)
+{
+  std::string literal;
+  size_t position = 0;
+  while (position < text.size()) {
+    const size_t open = text.find('{', position);
+    if (open == std::string::npos) {
+      literal.append(text, position, std::string::npos);
+      break;
+    }
+    const size_t close = text.find('}', open);
+    if (close == std::string::npos || close == open + 1 ||
+        text.find_first_not_of("0123456789", open + 1) != close) {
+      throw std::invalid_argument("Invalid placeholder in script template at position " + std::to_string(open));
+    }
+    literal.append(text, position, open - position);
+    const size_t index = std::stoul(text.substr(open + 1, close - open - 1));
+    literal_size_ += literal.size();
+    literals_.push_back(std::move(literal));
+    literal.clear();
+    placeholders_.push_back(index);
+    parameter_count_ = std::max(parameter_count_, index + 1);
+    position = close + 1;
+  }
+  literal_size_ += literal.size();
+  literals_.push_back(std::move(literal));
+}
+
+std::string URScriptTemplate::fill(const std::vector<std::string>& values) const
+{
+  if (values.size() < parameter_count_) {
+    throw std::invalid_argument("Script template needs " + std::to_string(parameter_count_) + " values, got " +
+                                std::to_string(values.size()));
+  }
+  size_t size = literal_size_;
+  for (const size_t placeholder : placeholders_) {
+    size += values[placeholder].size();
+  }
+
+  std::string script;
+  script.reserve(size);
+  for (size_t i = 0; i < placeholders_.size(); ++i) {
+    script += literals_[i];
+    script += values[placeholders_[i]];
+  }
+  script += literals_.back();
+  return script;
+}
+
+URScriptQueue::URScriptQueue(WriteFunction write, size_t capacity, size_t max_batch_snippets)
+  : write_(std::move(write)), capacity_(capacity), max_batch_snippets_(max_batch_snippets)
+{
+  thread_ = std::thread(&URScriptQueue::run, this);
+}
+
+URScriptQueue::~URScriptQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  thread_.join();
+}
+
+std::future<URScriptQueue::DeliveryStatus> URScriptQueue::submitProgram(std::string program)
+{
+  if (program.empty() || program.back() != '\n') {
+    program += '\n';
+  }
+  return submit({ true, std::move(program), 0, true, {} });
+}
+
+std::future<URScriptQueue::DeliveryStatus> URScriptQueue::submitSnippets(const std::vector<std::string>& snippets,
+                                                                          bool own_program)
+{
+  // Indented as the body of the secondary program the snippets get merged into
+  std::string text;
+  for (const auto& snippet : snippets) {
+    size_t line_start = 0;
+    while (line_start < snippet.size()) {
+      size_t line_end = snippet.find('\n', line_start);
+      if (line_end == std::string::npos) {
+        line_end = snippet.size();
+      }
+      text += "  ";
+      text.append(snippet, line_start, line_end - line_start);
+      text += '\n';
+      line_start = line_end + 1;
+    }
+  }
+  return submit({ false, std::move(text), snippets.size(), own_program, {} });
+}
+
+size_t URScriptQueue::size()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+std::string URScriptQueue::toString(DeliveryStatus status)
+{
+  switch (status) {
+    case DeliveryStatus::SENT:
+      return "sent";
+    case DeliveryStatus::QUEUE_FULL:
+      return "queue full";
+    case DeliveryStatus::SEND_FAILED:
+      return "send failed";
+    case DeliveryStatus::SHUT_DOWN:
+      return "shut down";
+  }
+  return "unknown";
+}
+
+std::future<URScriptQueue::DeliveryStatus> URScriptQueue::submit(Submission submission)
+{
+  std::future<DeliveryStatus> delivered = submission.delivered.get_future();
+  if (!submission.is_program && submission.snippet_count == 0) {
+    submission.delivered.set_value(DeliveryStatus::SENT);
+    return delivered;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_ || queue_.size() >= capacity_) {
+      submission.delivered.set_value(stop_ ? DeliveryStatus::SHUT_DOWN : DeliveryStatus::QUEUE_FULL);
+      return delivered;
+    }
+    queue_.push_back(std::move(submission));
+  }
+  queue_cv_.notify_one();
+  return delivered;
+}
+
+void URScriptQueue::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queue_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (stop_) {
+      break;
+    }
+
+    std::vector<Submission> batch;
+    batch.push_back(std::move(queue_.front()));
+    queue_.pop_front();
+    if (!batch.front().own_program) {
+      size_t snippet_count = batch.front().snippet_count;
+      while (!queue_.empty() && !queue_.front().own_program &&
+             snippet_count + queue_.front().snippet_count <= max_batch_snippets_) {
+        snippet_count += queue_.front().snippet_count;
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+      }
+    }
+    lock.unlock();
+
+    std::string program;
+    if (batch.front().is_program) {
+      program = std::move(batch.front().text);
+    } else {
+      program = "sec urscript_batch():\n";
+      for (const auto& submission : batch) {
+        program += submission.text;
+      }
+      program += "end\n";
+    }
+    const DeliveryStatus status = write_(program) ? DeliveryStatus::SENT : DeliveryStatus::SEND_FAILED;
+    for (auto& submission : batch) {
+      submission.delivered.set_value(status);
+    }
+
+    lock.lock();
+  }
+
+  while (!queue_.empty()) {
+    queue_.front().delivered.set_value(DeliveryStatus::SHUT_DOWN);
+    queue_.pop_front();
+  }
+}
+}  // namespace ur_robot_driver
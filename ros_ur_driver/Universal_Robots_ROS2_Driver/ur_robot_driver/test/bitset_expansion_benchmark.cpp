@@ -0,0 +1,120 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "ur_robot_driver/bitset_expansion.hpp"
+
+using ur_robot_driver::expandBitset;
+
+namespace
+{
+constexpr size_t CYCLES = 1000000;
+
+template <size_t N>
+void expandPerBit(const std::bitset<N>& bits, std::array<double, N>& copy)
+{
+  for (size_t i = 0; i < N; ++i) {
+    copy[i] = static_cast<double>(bits[i]);
+  }
+}
+
+// One bitset per control cycle, of which every change_interval-th differs from its predecessor
+std::vector<std::bitset<18>> bitsetsPerCycle(size_t change_interval)
+{
+  std::mt19937_64 gen(42);
+  std::vector<std::bitset<18>> bitsets(CYCLES);
+  std::bitset<18> bits(gen());
+  for (size_t i = 0; i < CYCLES; ++i) {
+    if (i % change_interval == 0) {
+      bits = std::bitset<18>(gen());
+    }
+    bitsets[i] = bits;
+  }
+  return bitsets;
+}
+
+template <typename Expansion>
+double nanosecondsPerCycle(const std::vector<std::bitset<18>>& bitsets, Expansion&& expand)
+{
+  std::array<double, 18> copy;
+  double checksum = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& bits : bitsets) {
+    expand(bits, copy);
+    checksum += copy[bits.count() % 18];
+  }
+  const auto duration = std::chrono::steady_clock::now() - start;
+  // Keeps the loop from being optimized away
+  if (checksum < 0.0) {
+    std::cout << checksum << std::endl;
+  }
+  return std::chrono::duration<double, std::nano>(duration).count() / bitsets.size();
+}
+}  // namespace
+
+// Compares the expansion of the 18 digital output bits, as done in every read(), for IO that changes in every cycle,
+// in every 100th cycle, or never at all
+TEST(BitsetExpansionBenchmark, digital_outputs)
+{
+  for (size_t change_interval : { size_t{ 1 }, size_t{ 100 }, CYCLES }) {
+    const auto bitsets = bitsetsPerCycle(change_interval);
+
+    const double per_bit_ns = nanosecondsPerCycle(bitsets, [](const auto& bits, auto& copy) {
+      expandPerBit(bits, copy);
+    });
+    const double nibble_ns = nanosecondsPerCycle(bitsets, [](const auto& bits, auto& copy) {
+      uint64_t last_word = std::numeric_limits<uint64_t>::max();
+      expandBitset(bits, last_word, copy);
+    });
+    uint64_t last_word = std::numeric_limits<uint64_t>::max();
+    const double changed_only_ns = nanosecondsPerCycle(bitsets, [&last_word](const auto& bits, auto& copy) {
+      expandBitset(bits, last_word, copy);
+    });
+
+    std::cout << "Change every " << change_interval << " cycles: per bit " << per_bit_ns << " ns, by nibble "
+              << nibble_ns << " ns, changed only " << changed_only_ns << " ns" << std::endl;
+  }
+}
@@ -0,0 +1,120 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include "ur_robot_driver/bitset_expansion.hpp"
+
+using ur_robot_driver::expandBitset;
+
+namespace
+{
+constexpr uint64_t UNKNOWN_BITSET_WORD = std::numeric_limits<uint64_t>::max();
+
+// The expansion as it was done before, converting each bit on its own
+template <size_t N>
+std::array<double, N> expandPerBit(const std::bitset<N>& bits)
+{
+  std::array<double, N> copy;
+  for (size_t i = 0; i < N; ++i) {
+    copy[i] = static_cast<double>(bits[i]);
+  }
+  return copy;
+}
+
+template <size_t N>
+void expectMatchesPerBit(size_t count)
+{
+  std::mt19937_64 gen(42);
+  uint64_t last_word = UNKNOWN_BITSET_WORD;
+  std::array<double, N> copy;
+  copy.fill(-1.0);
+
+  for (size_t i = 0; i < count; ++i) {
+    const std::bitset<N> bits(gen());
+    expandBitset(bits, last_word, copy);
+    ASSERT_EQ(expandPerBit(bits), copy) << "Bits: " << bits;
+    EXPECT_EQ(bits.to_ullong(), last_word);
+  }
+}
+}  // namespace
+
+TEST(BitsetExpansion, matches_per_bit_conversion)
+{
+  // Sizes of the bitsets exported by the hardware interface, plus the edge cases
+  expectMatchesPerBit<1>(100);
+  expectMatchesPerBit<2>(100);
+  expectMatchesPerBit<4>(1000);
+  expectMatchesPerBit<11>(10000);
+  expectMatchesPerBit<18>(10000);
+  expectMatchesPerBit<64>(10000);
+}
+
+TEST(BitsetExpansion, first_expansion_of_all_set_bits)
+{
+  // All bits set matches the unknown word only for 64 bits, smaller bitsets must be expanded right away
+  std::bitset<18> bits;
+  bits.set();
+  uint64_t last_word = UNKNOWN_BITSET_WORD;
+  std::array<double, 18> copy;
+  copy.fill(0.0);
+
+  expandBitset(bits, last_word, copy);
+  EXPECT_EQ(expandPerBit(bits), copy);
+}
+
+TEST(BitsetExpansion, unchanged_bits_keep_copy)
+{
+  const std::bitset<18> bits(0b101101);
+  uint64_t last_word = UNKNOWN_BITSET_WORD;
+  std::array<double, 18> copy;
+  expandBitset(bits, last_word, copy);
+
+  // Nothing is written without a change, so an overwritten copy stays as it is
+  copy[0] = 5.0;
+  expandBitset(bits, last_word, copy);
+  EXPECT_EQ(5.0, copy[0]);
+
+  expandBitset(std::bitset<18>(0b101100), last_word, copy);
+  EXPECT_EQ(0.0, copy[0]);
+  EXPECT_EQ(expandPerBit(std::bitset<18>(0b101100)), copy);
+}
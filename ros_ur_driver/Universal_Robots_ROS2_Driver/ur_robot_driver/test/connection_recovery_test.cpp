@@ -0,0 +1,90 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "ur_robot_driver/connection_recovery.hpp"
+
+using ur_robot_driver::ReconnectBackoff;
+using ur_robot_driver::RecoveryStatistics;
+using namespace std::chrono_literals;
+
+TEST(ReconnectBackoff, doubles_up_to_maximum_and_resets)
+{
+  ReconnectBackoff backoff(100ms, 500ms);
+  EXPECT_EQ(backoff.next(), 100ms);
+  EXPECT_EQ(backoff.next(), 200ms);
+  EXPECT_EQ(backoff.next(), 400ms);
+  EXPECT_EQ(backoff.next(), 500ms);
+  EXPECT_EQ(backoff.next(), 500ms);
+  backoff.reset();
+  EXPECT_EQ(backoff.next(), 100ms);
+}
+
+TEST(ReconnectBackoff, keeps_initial_delay_above_maximum)
+{
+  // The hardware uses a fixed initial delay with a configurable maximum, which may be set below it
+  ReconnectBackoff backoff(500ms, 100ms);
+  EXPECT_EQ(backoff.next(), 500ms);
+  EXPECT_EQ(backoff.next(), 500ms);
+}
+
+TEST(ReconnectBackoff, stays_at_maximum_while_the_robot_is_down)
+{
+  ReconnectBackoff backoff(500ms, 10s);
+  std::chrono::milliseconds delay(0);
+  for (int i = 0; i < 1000; ++i) {
+    delay = backoff.next();
+  }
+  EXPECT_EQ(delay, 10s);
+}
+
+TEST(RecoveryStatistics, records_last_and_longest_recovery)
+{
+  RecoveryStatistics statistics;
+  EXPECT_EQ(statistics.reconnects, 0u);
+  EXPECT_EQ(statistics.last_recovery_time.count(), 0.0);
+  EXPECT_EQ(statistics.max_recovery_time.count(), 0.0);
+
+  statistics.recordRecovery(1.5s);
+  statistics.recordRecovery(4.0s);
+  statistics.recordRecovery(0.5s);
+  EXPECT_EQ(statistics.reconnects, 3u);
+  EXPECT_DOUBLE_EQ(statistics.last_recovery_time.count(), 0.5);
+  EXPECT_DOUBLE_EQ(statistics.max_recovery_time.count(), 4.0);
+}
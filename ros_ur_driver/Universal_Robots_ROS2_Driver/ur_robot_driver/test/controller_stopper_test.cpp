@@ -0,0 +1,206 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "controller_manager_msgs/msg/controller_state.hpp"
+#include "controller_manager_msgs/srv/list_controllers.hpp"
+#include "controller_manager_msgs/srv/switch_controller.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/bool.hpp"
+#include "ur_robot_driver/controller_stopper.hpp"
+
+using controller_manager_msgs::srv::ListControllers;
+using controller_manager_msgs::srv::SwitchController;
+using namespace std::chrono_literals;
+
+namespace
+{
+/*!
+ * \brief Controller manager answering the stopper's service calls and recording its switch requests.
+ */
+class FakeControllerManager
+{
+public:
+  FakeControllerManager() : node_(std::make_shared<rclcpp::Node>("fake_controller_manager"))
+  {
+    list_srv_ = node_->create_service<ListControllers>(
+        "controller_manager/list_controllers",
+        [this](const ListControllers::Request::SharedPtr, ListControllers::Response::SharedPtr response) {
+          for (const auto& name : { "joint_state_broadcaster", "scaled_joint_trajectory_controller" }) {
+            controller_manager_msgs::msg::ControllerState controller;
+            controller.name = name;
+            controller.state = isActive(name) ? "active" : "inactive";
+            response->controller.push_back(controller);
+          }
+        });
+    switch_srv_ = node_->create_service<SwitchController>(
+        "controller_manager/switch_controller",
+        [this](const SwitchController::Request::SharedPtr request, SwitchController::Response::SharedPtr response) {
+          for (const auto& name : request->deactivate_controllers) {
+            inactive_.push_back(name);
+          }
+          for (const auto& name : request->activate_controllers) {
+            inactive_.erase(std::remove(inactive_.begin(), inactive_.end(), name), inactive_.end());
+          }
+          switch_requests_.push_back(*request);
+          response->ok = true;
+        });
+  }
+
+  rclcpp::Node::SharedPtr node() const
+  {
+    return node_;
+  }
+
+  const std::vector<SwitchController::Request>& switchRequests() const
+  {
+    return switch_requests_;
+  }
+
+private:
+  bool isActive(const std::string& name) const
+  {
+    return std::find(inactive_.begin(), inactive_.end(), name) == inactive_.end();
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::Service<ListControllers>::SharedPtr list_srv_;
+  rclcpp::Service<SwitchController>::SharedPtr switch_srv_;
+  std::vector<std::string> inactive_;
+  std::vector<SwitchController::Request> switch_requests_;
+};
+}  // namespace
+
+/*!
+ * \brief Runs the stopper and the controller manager in executors of their own, so the tests decide when the
+ * controller manager answers.
+ */
+class ControllerStopperTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestSuite()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    const std::vector<std::string> consistent_controllers = { "joint_state_broadcaster" };
+    stopper_node_ = std::make_shared<rclcpp::Node>(
+        "controller_stopper",
+        rclcpp::NodeOptions().parameter_overrides({ { "consistent_controllers", consistent_controllers } }));
+    running_pub_ =
+        stopper_node_->create_publisher<std_msgs::msg::Bool>("io_and_status_controller/robot_program_running", 1);
+    stopper_executor_.add_node(stopper_node_);
+    controller_manager_executor_.add_node(controller_manager_.node());
+    stopper_ = std::make_unique<ControllerStopper>(stopper_node_, false);
+  }
+
+  void publishRunning(bool running)
+  {
+    std_msgs::msg::Bool msg;
+    msg.data = running;
+    running_pub_->publish(msg);
+  }
+
+  // Spins the stopper and, unless held back, the controller manager until the predicate holds
+  bool spinUntil(const std::function<bool()>& predicate, bool spin_controller_manager = true,
+                 std::chrono::milliseconds timeout = 5s)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      stopper_executor_.spin_some(10ms);
+      if (spin_controller_manager) {
+        controller_manager_executor_.spin_some(10ms);
+      }
+    }
+    return true;
+  }
+
+  void spinFor(std::chrono::milliseconds duration, bool spin_controller_manager = true)
+  {
+    spinUntil([]() { return false; }, spin_controller_manager, duration);
+  }
+
+  rclcpp::Node::SharedPtr stopper_node_;
+  rclcpp::Publisher<std_msgs::msg::Bool>::SharedPtr running_pub_;
+  FakeControllerManager controller_manager_;
+  rclcpp::executors::SingleThreadedExecutor stopper_executor_;
+  rclcpp::executors::SingleThreadedExecutor controller_manager_executor_;
+  std::unique_ptr<ControllerStopper> stopper_;
+};
+
+TEST_F(ControllerStopperTest, stops_controllers_started_again_before_a_refresh)
+{
+  const std::vector<std::string> stoppable = { "scaled_joint_trajectory_controller" };
+  const auto switched = [this](size_t count) {
+    return [this, count]() { return controller_manager_.switchRequests().size() >= count; };
+  };
+  ASSERT_TRUE(spinUntil([this]() { return running_pub_->get_subscription_count() > 0; }));
+
+  publishRunning(false);
+  ASSERT_TRUE(spinUntil(switched(1)));
+  EXPECT_EQ(stoppable, controller_manager_.switchRequests()[0].deactivate_controllers);
+  // Lets the refresh following the stop finish
+  spinFor(200ms);
+
+  publishRunning(true);
+  ASSERT_TRUE(spinUntil(switched(2)));
+  EXPECT_EQ(stoppable, controller_manager_.switchRequests()[1].activate_controllers);
+
+  // The controller manager doesn't answer the refresh following the start before the program stops again
+  spinFor(100ms, false);
+  publishRunning(false);
+  spinFor(100ms, false);
+  ASSERT_TRUE(spinUntil(switched(3)));
+  EXPECT_EQ(stoppable, controller_manager_.switchRequests()[2].deactivate_controllers);
+}
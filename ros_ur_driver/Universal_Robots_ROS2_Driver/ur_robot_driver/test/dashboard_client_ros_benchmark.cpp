@@ -0,0 +1,131 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "fake_dashboard_server.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "ur_dashboard_msgs/srv/get_robot_mode.hpp"
+#include "ur_robot_driver/dashboard_client_ros.hpp"
+
+using ur_dashboard_msgs::srv::GetRobotMode;
+using ur_robot_driver::DashboardClientROS;
+using ur_robot_driver::FakeDashboardServer;
+
+namespace
+{
+constexpr size_t CALLS = 2000;
+// DashboardClientROS always connects to the dashboard server's default port
+constexpr int DASHBOARD_PORT = 29999;
+
+struct Latency
+{
+  double median_us = 0.0;
+  double p99_us = 0.0;
+};
+
+// Calls get_robot_mode through ROS one after the other, like a supervisor polling the robot mode
+Latency measureGetRobotMode(double status_poll_rate)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+      "dashboard_client", rclcpp::NodeOptions().parameter_overrides({ { "status_poll_rate", status_poll_rate } }));
+  DashboardClientROS client(node, "127.0.0.1");
+  rclcpp::executors::MultiThreadedExecutor executor;
+  executor.add_node(node);
+  std::thread spinner([&executor]() { executor.spin(); });
+
+  auto caller = std::make_shared<rclcpp::Node>("dashboard_caller");
+  auto robot_mode = caller->create_client<GetRobotMode>("/dashboard_client/get_robot_mode");
+  EXPECT_TRUE(robot_mode->wait_for_service(std::chrono::seconds(5)));
+
+  std::vector<double> latencies;
+  latencies.reserve(CALLS);
+  for (size_t i = 0; i < CALLS; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    auto future = robot_mode->async_send_request(std::make_shared<GetRobotMode::Request>());
+    if (rclcpp::spin_until_future_complete(caller, future, std::chrono::seconds(5)) !=
+        rclcpp::FutureReturnCode::SUCCESS) {
+      ADD_FAILURE() << "get_robot_mode didn't answer";
+      break;
+    }
+    latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    EXPECT_TRUE(future.get()->success);
+  }
+  executor.cancel();
+  spinner.join();
+
+  Latency latency;
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    latency.median_us = latencies[latencies.size() / 2];
+    latency.p99_us = latencies[latencies.size() * 99 / 100];
+  }
+  return latency;
+}
+}  // namespace
+
+class DashboardClientROSBenchmark : public ::testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestSuite()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(DashboardClientROSBenchmark, get_robot_mode_latency)
+{
+  // Answers right away, a real robot adds the network round trip and the dashboard server's own response time
+  FakeDashboardServer server(DASHBOARD_PORT);
+
+  // Without polling every call queries the dashboard server, with polling the calls are answered from the cache
+  const Latency live = measureGetRobotMode(0.0);
+  const Latency cached = measureGetRobotMode(2.0);
+  std::cout << "get_robot_mode latency: live median " << live.median_us << " us, p99 " << live.p99_us
+            << " us; from cache median " << cached.median_us << " us, p99 " << cached.p99_us << " us" << std::endl;
+}
@@ -0,0 +1,214 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fake_dashboard_server.hpp"
+#include "ur_client_library/exceptions.h"
+#include "ur_robot_driver/dashboard_command_executor.hpp"
+
+using ur_robot_driver::DashboardCommandExecutor;
+using ur_robot_driver::FakeDashboardServer;
+using namespace std::chrono_literals;
+
+TEST(DashboardCommandExecutor, answers_concurrent_callers_in_order)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 50ms);
+  ASSERT_TRUE(executor.connect());
+
+  const std::vector<std::pair<std::string, std::string>> commands = {
+    { "robotmode", "Robotmode: RUNNING" },
+    { "safetymode", "Safetymode: NORMAL" },
+    { "running", "Program running: false" },
+    { "programState", "STOPPED test_program.urp" },
+    { "get loaded program", "Loaded program: /programs/test_program.urp" },
+  };
+
+  std::atomic<int> wrong_answers{ 0 };
+  std::vector<std::thread> callers;
+  for (size_t i = 0; i < 8; ++i) {
+    callers.emplace_back([&, i]() {
+      for (size_t j = 0; j < 25; ++j) {
+        const auto& [command, expected] = commands[(i + j) % commands.size()];
+        if (executor.submit(command + "\n", 5s).get() != expected) {
+          ++wrong_answers;
+        }
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  EXPECT_EQ(wrong_answers, 0);
+  EXPECT_EQ(server.connections(), 1);
+}
+
+TEST(DashboardCommandExecutor, pipelines_commands)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 50ms);
+  ASSERT_TRUE(executor.connect());
+
+  std::vector<std::future<std::string>> answers;
+  for (size_t i = 0; i < 20; ++i) {
+    answers.push_back(executor.submit("programState", 5s));
+  }
+  for (auto& answer : answers) {
+    EXPECT_EQ(answer.get(), "STOPPED test_program.urp");
+  }
+  // Commands are sent before the previous ones have been answered
+  EXPECT_GT(server.maxPipelined(), 1u);
+}
+
+TEST(DashboardCommandExecutor, timeout_fails_command_and_reconnects)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 50ms);
+  ASSERT_TRUE(executor.connect());
+
+  auto slow = executor.submit("slow", 100ms);
+  auto queued_behind = executor.submit("robotmode", 100ms);
+  EXPECT_THROW(slow.get(), urcl::UrException);
+  // Sent on the same connection, its answer can't be told apart from a late one anymore
+  EXPECT_THROW(queued_behind.get(), urcl::UrException);
+
+  // The late answer to "slow" must not be mistaken for this one's
+  EXPECT_EQ(executor.submit("robotmode", 2s).get(), "Robotmode: RUNNING");
+  EXPECT_EQ(server.connections(), 2);
+}
+
+TEST(DashboardCommandExecutor, keeps_queued_commands_when_connection_is_lost)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 50ms);
+  ASSERT_TRUE(executor.connect());
+
+  auto dropped = executor.submit("drop", 2s);
+  EXPECT_THROW(dropped.get(), urcl::UrException);
+
+  // Submitted while the connection is down, sent after reconnecting
+  std::vector<std::future<std::string>> answers;
+  for (size_t i = 0; i < 5; ++i) {
+    answers.push_back(executor.submit("running", 2s));
+  }
+  for (auto& answer : answers) {
+    EXPECT_EQ(answer.get(), "Program running: false");
+  }
+  EXPECT_EQ(server.connections(), 2);
+}
+
+TEST(DashboardCommandExecutor, disconnect_fails_commands_until_connected_again)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 50ms);
+  ASSERT_TRUE(executor.connect());
+  executor.setTimeout(1s);
+  EXPECT_EQ(executor.sendAndReceive("power on\n"), "Powering on");
+
+  executor.disconnect();
+  EXPECT_THROW(executor.sendAndReceive("power on\n"), urcl::UrException);
+
+  ASSERT_TRUE(executor.connect());
+  EXPECT_EQ(executor.sendAndReceive("power on\n"), "Powering on");
+}
+
+TEST(DashboardCommandExecutor, fails_to_connect_without_server)
+{
+  int port;
+  {
+    FakeDashboardServer server;
+    port = server.port();
+  }
+  DashboardCommandExecutor executor("127.0.0.1", port, 50ms);
+  executor.setTimeout(200ms);
+  EXPECT_FALSE(executor.connect());
+  EXPECT_THROW(executor.submit("robotmode", 200ms).get(), urcl::UrException);
+}
+
+TEST(DashboardCommandExecutor, reconnects_right_away_and_reports_recovery)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 50ms);
+  std::atomic<int> resyncs{ 0 };
+  executor.setReconnectCallback([&]() { ++resyncs; });
+  ASSERT_TRUE(executor.connect());
+
+  EXPECT_THROW(executor.submit("drop", 2s).get(), urcl::UrException);
+  // Reconnecting doesn't wait for the next command
+  const auto deadline = std::chrono::steady_clock::now() + 2s;
+  while (resyncs == 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+
+  EXPECT_EQ(resyncs, 1);
+  EXPECT_EQ(server.connections(), 2);
+  const auto statistics = executor.recoveryStatistics();
+  EXPECT_EQ(statistics.reconnects, 1u);
+  EXPECT_LT(statistics.last_recovery_time, 1s);
+}
+
+TEST(DashboardCommandExecutor, backs_off_while_server_is_down)
+{
+  FakeDashboardServer server;
+  DashboardCommandExecutor executor("127.0.0.1", server.port(), 20ms, 160ms);
+  executor.setTimeout(200ms);
+  ASSERT_TRUE(executor.connect());
+
+  server.setDown(true);
+  EXPECT_THROW(executor.submit("drop", 2s).get(), urcl::UrException);
+  std::this_thread::sleep_for(700ms);
+  // Attempts after 0, 20, 40, 80, 160, 160, 160 ms. Retrying every 20 ms would have been about 35 attempts.
+  const int attempts = server.connections() - 1;
+  EXPECT_GE(attempts, 5);
+  EXPECT_LE(attempts, 9);
+
+  // Queued while the server is down, sent once it is back
+  auto answer = executor.submit("robotmode", 2s);
+  server.setDown(false);
+  EXPECT_EQ(answer.get(), "Robotmode: RUNNING");
+  const auto statistics = executor.recoveryStatistics();
+  EXPECT_EQ(statistics.reconnects, 1u);
+  EXPECT_GE(statistics.last_recovery_time, 700ms);
+}
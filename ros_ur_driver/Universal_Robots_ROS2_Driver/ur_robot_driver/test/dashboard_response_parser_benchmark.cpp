@@ -0,0 +1,104 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "ur_robot_driver/dashboard_response_parser.hpp"
+
+using namespace ur_robot_driver::dashboard_parser;
+using ur_dashboard_msgs::msg::RobotMode;
+
+namespace
+{
+// Robot mode parsing as it was done using a regex and a chain of comparisons before
+bool parseRobotModeRegex(const std::string& answer, RobotMode& mode)
+{
+  std::smatch match;
+  std::regex expected("Robotmode: (.+)");
+  const bool success = std::regex_match(answer, match, expected);
+  if (success) {
+    const std::vector<std::pair<std::string, int8_t>> modes = {
+      { "NO_CONTROLLER", RobotMode::NO_CONTROLLER }, { "DISCONNECTED", RobotMode::DISCONNECTED },
+      { "CONFIRM_SAFETY", RobotMode::CONFIRM_SAFETY }, { "BOOTING", RobotMode::BOOTING },
+      { "POWER_OFF", RobotMode::POWER_OFF },         { "POWER_ON", RobotMode::POWER_ON },
+      { "IDLE", RobotMode::IDLE },                   { "BACKDRIVE", RobotMode::BACKDRIVE },
+      { "RUNNING", RobotMode::RUNNING },             { "UPDATING_FIRMWARE", RobotMode::UPDATING_FIRMWARE },
+    };
+    for (const auto& [name, value] : modes) {
+      if (match[1] == name) {
+        mode.mode = value;
+        break;
+      }
+    }
+  }
+  return success;
+}
+}  // namespace
+
+TEST(DashboardResponseParserBenchmark, robot_mode)
+{
+  // Reports the time per answer for comparing both versions
+  std::vector<std::string> answers;
+  for (size_t i = 0; i < 2000; ++i) {
+    for (const auto& mode : ROBOT_MODES) {
+      answers.push_back("Robotmode: " + std::string(mode.name));
+    }
+  }
+  int checksum = 0;
+
+  auto time_per_answer = [&](auto&& parse) {
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& answer : answers) {
+      RobotMode mode;
+      checksum += parse(answer, mode) + mode.mode;
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(duration).count() / answers.size();
+  };
+
+  const double regex_ns = time_per_answer(parseRobotModeRegex);
+  const double parser_ns = time_per_answer([](const std::string& answer, RobotMode& mode) {
+    return parseRobotMode(answer, mode);
+  });
+  std::cout << "regex: " << regex_ns << " ns per answer, parser: " << parser_ns << " ns per answer (checksum "
+            << checksum << ")" << std::endl;
+}
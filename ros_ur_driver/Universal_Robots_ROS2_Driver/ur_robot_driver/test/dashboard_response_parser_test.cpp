@@ -0,0 +1,227 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "ur_robot_driver/dashboard_response_parser.hpp"
+
+using namespace ur_robot_driver::dashboard_parser;
+using ur_dashboard_msgs::msg::RobotMode;
+using ur_dashboard_msgs::msg::SafetyMode;
+
+namespace
+{
+// Robot mode parsing as it was done using a regex and a chain of comparisons before
+bool parseRobotModeRegex(const std::string& answer, RobotMode& mode)
+{
+  std::smatch match;
+  std::regex expected("Robotmode: (.+)");
+  const bool success = std::regex_match(answer, match, expected);
+  if (success) {
+    const std::vector<std::pair<std::string, int8_t>> modes = {
+      { "NO_CONTROLLER", RobotMode::NO_CONTROLLER }, { "DISCONNECTED", RobotMode::DISCONNECTED },
+      { "CONFIRM_SAFETY", RobotMode::CONFIRM_SAFETY }, { "BOOTING", RobotMode::BOOTING },
+      { "POWER_OFF", RobotMode::POWER_OFF },         { "POWER_ON", RobotMode::POWER_ON },
+      { "IDLE", RobotMode::IDLE },                   { "BACKDRIVE", RobotMode::BACKDRIVE },
+      { "RUNNING", RobotMode::RUNNING },             { "UPDATING_FIRMWARE", RobotMode::UPDATING_FIRMWARE },
+    };
+    for (const auto& [name, value] : modes) {
+      if (match[1] == name) {
+        mode.mode = value;
+        break;
+      }
+    }
+  }
+  return success;
+}
+
+bool parseSafetyModeRegex(const std::string& answer, SafetyMode& mode)
+{
+  std::smatch match;
+  std::regex expected("Safetymode: (.+)");
+  const bool success = std::regex_match(answer, match, expected);
+  if (success) {
+    const std::vector<std::pair<std::string, uint8_t>> modes = {
+      { "NORMAL", SafetyMode::NORMAL },
+      { "REDUCED", SafetyMode::REDUCED },
+      { "PROTECTIVE_STOP", SafetyMode::PROTECTIVE_STOP },
+      { "RECOVERY", SafetyMode::RECOVERY },
+      { "SAFEGUARD_STOP", SafetyMode::SAFEGUARD_STOP },
+      { "SYSTEM_EMERGENCY_STOP", SafetyMode::SYSTEM_EMERGENCY_STOP },
+      { "ROBOT_EMERGENCY_STOP", SafetyMode::ROBOT_EMERGENCY_STOP },
+      { "VIOLATION", SafetyMode::VIOLATION },
+      { "FAULT", SafetyMode::FAULT },
+    };
+    for (const auto& [name, value] : modes) {
+      if (match[1] == name) {
+        mode.mode = value;
+        break;
+      }
+    }
+  }
+  return success;
+}
+
+// Answers built from the fragments the dashboard server uses, mutated randomly to also cover near misses
+std::vector<std::string> fuzzAnswers(size_t count)
+{
+  const std::vector<std::string> fragments = {
+    "Robotmode: ", "Safetymode: ", "Program running: ", "Loaded program: ", "Loading program: ",
+    "Loading installation: ", "true", "false", "true ", "false ", "STOPPED", "PLAYING", "PAUSED", " ",
+    "RUNNING", "POWER_OFF", "IDLE", "NO_CONTROLLER", "UPDATING_FIRMWARE", "NORMAL", "PROTECTIVE_STOP", "FAULT",
+    "VIOLATION", "AUTOMATIC_MODE_SAFEGUARD_STOP", "/programs/test.urp", "<unnamed>", "a b", "\n", "\r", "\t", "\v",
+    "\f", std::string(1, '\0'), "x", "Robotmode:", "running", "Program running: True"
+  };
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> fragment(0, fragments.size() - 1);
+  std::uniform_int_distribution<size_t> length(0, 4);
+  std::uniform_int_distribution<int> character(0, 255);
+  std::uniform_int_distribution<int> mutation(0, 9);
+
+  std::vector<std::string> answers;
+  for (size_t i = 0; i < count; ++i) {
+    std::string answer;
+    const size_t fragment_count = length(gen);
+    for (size_t j = 0; j < fragment_count; ++j) {
+      answer += fragments[fragment(gen)];
+    }
+    if (!answer.empty() && mutation(gen) == 0) {
+      answer[std::uniform_int_distribution<size_t>(0, answer.size() - 1)(gen)] = static_cast<char>(character(gen));
+    }
+    answers.push_back(answer);
+  }
+  return answers;
+}
+
+// Answers the way they are actually sent by the dashboard server
+std::vector<std::string> typicalAnswers()
+{
+  std::vector<std::string> answers;
+  for (const auto& mode : ROBOT_MODES) {
+    answers.push_back("Robotmode: " + std::string(mode.name));
+  }
+  for (const auto& mode : SAFETY_MODES) {
+    answers.push_back("Safetymode: " + std::string(mode.name));
+  }
+  for (const auto& state : PROGRAM_STATES) {
+    answers.push_back(std::string(state) + " test_program.urp");
+  }
+  answers.push_back("Program running: true");
+  answers.push_back("Program running: false");
+  answers.push_back("true test_program.urp");
+  answers.push_back("false test_program.urp");
+  return answers;
+}
+}  // namespace
+
+TEST(DashboardResponseParser, mode_lookup)
+{
+  for (const auto& mode : ROBOT_MODES) {
+    EXPECT_EQ(lookupMode(ROBOT_MODES, mode.name), mode.value);
+  }
+  for (const auto& mode : SAFETY_MODES) {
+    EXPECT_EQ(lookupMode(SAFETY_MODES, mode.name), mode.value);
+  }
+  EXPECT_FALSE(lookupMode(ROBOT_MODES, ""));
+  EXPECT_FALSE(lookupMode(ROBOT_MODES, "AAA"));
+  EXPECT_FALSE(lookupMode(ROBOT_MODES, "ZZZ"));
+  EXPECT_FALSE(lookupMode(SAFETY_MODES, "NORMAL "));
+}
+
+TEST(DashboardResponseParser, matches_regex_implementation)
+{
+  auto answers = fuzzAnswers(50000);
+  const auto typical = typicalAnswers();
+  answers.insert(answers.end(), typical.begin(), typical.end());
+
+  const std::regex loaded_program("Loaded program: (.+)");
+  const std::regex program_running("Program running: (true|false)");
+  const std::regex program_saved("(true|false) ([^\\s]+)");
+  const std::regex program_state("(STOPPED|PLAYING|PAUSED) (.+)");
+
+  for (const auto& answer : answers) {
+    SCOPED_TRACE("answer: '" + answer + "'");
+    std::smatch match;
+
+    std::string_view value;
+    const bool loaded = std::regex_match(answer, match, loaded_program);
+    ASSERT_EQ(loaded, parsePrefixed(answer, "Loaded program: ", value));
+    if (loaded) {
+      EXPECT_EQ(match[1].str(), value);
+    }
+
+    bool running = false;
+    const bool running_matched = std::regex_match(answer, match, program_running);
+    ASSERT_EQ(running_matched, parseProgramRunning(answer, running));
+    if (running_matched) {
+      EXPECT_EQ(match[1] == "true", running);
+    }
+
+    bool saved = false;
+    std::string_view program_name;
+    const bool saved_matched = std::regex_match(answer, match, program_saved);
+    ASSERT_EQ(saved_matched, parseProgramSaved(answer, saved, program_name));
+    if (saved_matched) {
+      EXPECT_EQ(match[1] == "true", saved);
+      EXPECT_EQ(match[2].str(), program_name);
+    }
+
+    std::string_view state;
+    const bool state_matched = std::regex_match(answer, match, program_state);
+    ASSERT_EQ(state_matched, parseProgramState(answer, state, program_name));
+    if (state_matched) {
+      EXPECT_EQ(match[1].str(), state);
+      EXPECT_EQ(match[2].str(), program_name);
+    }
+
+    RobotMode robot_mode_expected;
+    RobotMode robot_mode;
+    robot_mode_expected.mode = robot_mode.mode = 42;
+    ASSERT_EQ(parseRobotModeRegex(answer, robot_mode_expected), parseRobotMode(answer, robot_mode));
+    EXPECT_EQ(robot_mode_expected.mode, robot_mode.mode);
+
+    SafetyMode safety_mode_expected;
+    SafetyMode safety_mode;
+    safety_mode_expected.mode = safety_mode.mode = 42;
+    ASSERT_EQ(parseSafetyModeRegex(answer, safety_mode_expected), parseSafetyMode(answer, safety_mode));
+    EXPECT_EQ(safety_mode_expected.mode, safety_mode.mode);
+  }
+}
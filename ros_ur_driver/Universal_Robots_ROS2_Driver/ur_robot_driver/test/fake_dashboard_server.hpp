@@ -0,0 +1,191 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#ifndef UR_ROBOT_DRIVER__TEST__FAKE_DASHBOARD_SERVER_HPP_
+#define UR_ROBOT_DRIVER__TEST__FAKE_DASHBOARD_SERVER_HPP_
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+
+namespace ur_robot_driver
+{
+/*!
+ * \brief Local stand-in for the dashboard server, replaying captured answers with configurable delays.
+ *
+ * Like the real server it handles one command after the other. The command "drop" makes it close the connection
+ * without answering. While it is down, it closes new connections right away.
+ */
+class FakeDashboardServer
+{
+public:
+  struct Reply
+  {
+    std::string answer;
+    std::chrono::milliseconds delay;
+  };
+
+  /*!
+   * \param port Port to listen on, 0 picks a free one
+   */
+  explicit FakeDashboardServer(int port = 0)
+  {
+    replies_ = {
+      { "robotmode", { "Robotmode: RUNNING", std::chrono::milliseconds(0) } },
+      { "safetymode", { "Safetymode: NORMAL", std::chrono::milliseconds(1) } },
+      { "running", { "Program running: false", std::chrono::milliseconds(0) } },
+      { "programState", { "STOPPED test_program.urp", std::chrono::milliseconds(2) } },
+      { "get loaded program", { "Loaded program: /programs/test_program.urp", std::chrono::milliseconds(1) } },
+      { "power on", { "Powering on", std::chrono::milliseconds(0) } },
+      { "slow", { "Finally", std::chrono::milliseconds(300) } },
+    };
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int flag = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+    listen(listen_fd_, 4);
+    thread_ = std::thread(&FakeDashboardServer::serve, this);
+  }
+
+  ~FakeDashboardServer()
+  {
+    stop_ = true;
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    thread_.join();
+  }
+
+  int port() const
+  {
+    return port_;
+  }
+
+  int connections() const
+  {
+    return connections_;
+  }
+
+  void setDown(bool down)
+  {
+    down_ = down;
+  }
+
+  // Largest number of commands that were waiting in the server's receive buffer at once
+  size_t maxPipelined() const
+  {
+    return max_pipelined_;
+  }
+
+private:
+  void serve()
+  {
+    while (!stop_) {
+      const int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) {
+        continue;
+      }
+      ++connections_;
+      if (down_) {
+        close(fd);
+        continue;
+      }
+      const std::string welcome = "Connected: Universal Robots Dashboard Server\n";
+      send(fd, welcome.data(), welcome.size(), MSG_NOSIGNAL);
+
+      std::string buffer;
+      bool open = true;
+      while (open && !stop_) {
+        char data[256];
+        const ssize_t received = recv(fd, data, sizeof(data), 0);
+        if (received <= 0) {
+          break;
+        }
+        buffer.append(data, received);
+        size_t pipelined = 0;
+        for (char c : buffer) {
+          pipelined += c == '\n';
+        }
+        max_pipelined_ = std::max<size_t>(max_pipelined_, pipelined);
+
+        size_t line_end;
+        while (open && (line_end = buffer.find('\n')) != std::string::npos) {
+          const std::string command = buffer.substr(0, line_end);
+          buffer.erase(0, line_end + 1);
+          if (command == "drop") {
+            open = false;
+            break;
+          }
+          const auto reply = replies_.find(command);
+          std::string answer = "could not understand: '" + command + "'";
+          if (reply != replies_.end()) {
+            std::this_thread::sleep_for(reply->second.delay);
+            answer = reply->second.answer;
+          }
+          answer += '\n';
+          send(fd, answer.data(), answer.size(), MSG_NOSIGNAL);
+        }
+      }
+      close(fd);
+    }
+  }
+
+  std::map<std::string, Reply> replies_;
+  int listen_fd_;
+  int port_;
+  std::atomic<bool> stop_{ false };
+  std::atomic<bool> down_{ false };
+  std::atomic<int> connections_{ 0 };
+  std::atomic<size_t> max_pipelined_{ 0 };
+  std::thread thread_;
+};
+}  // namespace ur_robot_driver
+
+#endif  // UR_ROBOT_DRIVER__TEST__FAKE_DASHBOARD_SERVER_HPP_
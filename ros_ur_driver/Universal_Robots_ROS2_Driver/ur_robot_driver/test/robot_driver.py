@@ -28,6 +28,8 @@
 # POSSIBILITY OF SUCH DAMAGE.
 import logging
 import os
+import signal
+import subprocess
 import sys
 import time
 import unittest
@@ -54,6 +56,9 @@ from test_common import (  # noqa: E402
 
 TIMEOUT_EXECUTE_TRAJECTORY = 30
 
+# Longer than the keepalive timeout, so servoing the same trajectory would make the robot drop the connection
+CONTROL_LOOP_STALL = 0.5
+
 ROBOT_JOINTS = [
     "elbow_joint",
     "shoulder_lift_joint",
@@ -98,6 +103,11 @@ class RobotDriverTest(unittest.TestCase):
             "/scaled_joint_trajectory_controller/follow_joint_trajectory",
             FollowJointTrajectory,
         )
+        self._forwarding_follow_joint_trajectory = ActionInterface(
+            self.node,
+            "/forwarding_joint_trajectory_controller/follow_joint_trajectory",
+            FollowJointTrajectory,
+        )
 
     def setUp(self):
         self._dashboard_interface.start_robot()
@@ -325,3 +335,56 @@ class RobotDriverTest(unittest.TestCase):
         #     result = self.get_result("/scaled_joint_trajectory_controller/follow_joint_trajectory", goal_response, TIMEOUT_EXECUTE_TRAJECTORY)
         #     self.assertEqual(result.error_code, FollowJointTrajectory.Result.GOAL_TOLERANCE_VIOLATED)
         #     self.node.get_logger().info("Received result GOAL_TOLERANCE_VIOLATED")
+
+    def test_trajectory_forwarding_survives_loop_stall(self, tf_prefix):
+        """Test that a forwarded trajectory is finished by the robot while the control loop is stalled."""
+        self.assertTrue(
+            self._controller_manager_interface.switch_controller(
+                strictness=SwitchController.Request.STRICT,
+                activate_controllers=["forwarding_joint_trajectory_controller"],
+                deactivate_controllers=["scaled_joint_trajectory_controller"],
+            ).ok
+        )
+
+        test_trajectory = [
+            (Duration(sec=3, nanosec=0), [0.0 for j in ROBOT_JOINTS]),
+            (Duration(sec=6, nanosec=0), [-0.5 for j in ROBOT_JOINTS]),
+        ]
+
+        trajectory = JointTrajectory(
+            joint_names=[tf_prefix + joint for joint in ROBOT_JOINTS],
+            points=[
+                JointTrajectoryPoint(
+                    positions=test_pos,
+                    velocities=[0.0 for j in ROBOT_JOINTS],
+                    accelerations=[0.0 for j in ROBOT_JOINTS],
+                    time_from_start=test_time,
+                )
+                for (test_time, test_pos) in test_trajectory
+            ],
+        )
+
+        logging.info("Sending goal to be forwarded to the robot")
+        goal_handle = self._forwarding_follow_joint_trajectory.send_goal(trajectory=trajectory)
+        self.assertTrue(goal_handle.accepted)
+
+        # Freeze the whole control node for a moment while the robot is moving
+        time.sleep(4.0)
+        control_node_pid = int(subprocess.check_output(["pgrep", "-f", "ros2_control_node"]).split()[0])
+        logging.info("Stalling the control loop for %.1f seconds", CONTROL_LOOP_STALL)
+        os.kill(control_node_pid, signal.SIGSTOP)
+        time.sleep(CONTROL_LOOP_STALL)
+        os.kill(control_node_pid, signal.SIGCONT)
+
+        result = self._forwarding_follow_joint_trajectory.get_result(
+            goal_handle, TIMEOUT_EXECUTE_TRAJECTORY
+        )
+        self.assertEqual(result.error_code, FollowJointTrajectory.Result.SUCCESSFUL)
+
+        self.assertTrue(
+            self._controller_manager_interface.switch_controller(
+                strictness=SwitchController.Request.STRICT,
+                activate_controllers=["scaled_joint_trajectory_controller"],
+                deactivate_controllers=["forwarding_joint_trajectory_controller"],
+            ).ok
+        )
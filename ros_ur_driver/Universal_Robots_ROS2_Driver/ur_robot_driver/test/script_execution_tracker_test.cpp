@@ -0,0 +1,260 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_robot_driver/script_execution_tracker.hpp"
+
+using ur_robot_driver::PrimaryRobotMessage;
+using ur_robot_driver::ScriptExecutionTracker;
+using namespace std::chrono_literals;
+
+namespace
+{
+void appendInt32(std::vector<uint8_t>& package, int32_t value)
+{
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    package.push_back(static_cast<uint8_t>(static_cast<uint32_t>(value) >> shift));
+  }
+}
+
+/*!
+ * \brief Builds a robot message package as sent by the primary interface.
+ */
+std::vector<uint8_t> robotMessage(int8_t message_type, const std::vector<uint8_t>& payload)
+{
+  std::vector<uint8_t> package;
+  appendInt32(package, static_cast<int32_t>(4 + 1 + 8 + 1 + 1 + payload.size()));
+  package.push_back(20);
+  package.insert(package.end(), 8, 0);          // timestamp
+  package.push_back(static_cast<uint8_t>(-2));  // source
+  package.push_back(static_cast<uint8_t>(message_type));
+  package.insert(package.end(), payload.begin(), payload.end());
+  return package;
+}
+
+PrimaryRobotMessage textMessage(const std::string& text)
+{
+  return { PrimaryRobotMessage::Type::TEXT, text };
+}
+
+// Extracts the text of the textmsg() calls wrapping the snippets
+std::string markerText(const std::string& snippet)
+{
+  const size_t begin = snippet.find('"') + 1;
+  return snippet.substr(begin, snippet.rfind('"') - begin);
+}
+
+ScriptExecutionTracker::Execution current(ScriptExecutionTracker& tracker, uint64_t id,
+                                          ScriptExecutionTracker::State known_state)
+{
+  return tracker.waitForChange(id, known_state, ScriptExecutionTracker::Clock::now());
+}
+}  // namespace
+
+TEST(ScriptExecutionTrackerTest, parses_text_messages_and_runtime_exceptions)
+{
+  const std::string text = "urscript_interface started 3";
+  const auto text_package = robotMessage(0, std::vector<uint8_t>(text.begin(), text.end()));
+  const auto text_message = ScriptExecutionTracker::parseRobotMessage(text_package.data(), text_package.size());
+  ASSERT_TRUE(text_message.has_value());
+  EXPECT_EQ(text_message->type, PrimaryRobotMessage::Type::TEXT);
+  EXPECT_EQ(text_message->text, text);
+
+  std::vector<uint8_t> payload;
+  appendInt32(payload, 4);
+  appendInt32(payload, 17);
+  const std::string error = "compile_error_name_not_found:foo:";
+  payload.insert(payload.end(), error.begin(), error.end());
+  const auto exception_package = robotMessage(10, payload);
+  const auto exception =
+      ScriptExecutionTracker::parseRobotMessage(exception_package.data(), exception_package.size());
+  ASSERT_TRUE(exception.has_value());
+  EXPECT_EQ(exception->type, PrimaryRobotMessage::Type::RUNTIME_EXCEPTION);
+  EXPECT_EQ(exception->line, 4);
+  EXPECT_EQ(exception->column, 17);
+  EXPECT_EQ(exception->text, error);
+
+  // Other robot messages and robot state packages are of no interest
+  const auto key_package = robotMessage(7, std::vector<uint8_t>(20, 0));
+  EXPECT_FALSE(ScriptExecutionTracker::parseRobotMessage(key_package.data(), key_package.size()).has_value());
+  auto state_package = text_package;
+  state_package[4] = 16;
+  EXPECT_FALSE(ScriptExecutionTracker::parseRobotMessage(state_package.data(), state_package.size()).has_value());
+  EXPECT_FALSE(ScriptExecutionTracker::parseRobotMessage(text_package.data(), 10).has_value());
+}
+
+TEST(ScriptExecutionTrackerTest, follows_execution_until_finished)
+{
+  ScriptExecutionTracker tracker;
+  const uint64_t id = tracker.add();
+  const auto snippets = ScriptExecutionTracker::wrapSnippets(id, { "a = 1", "textmsg(a)" });
+  ASSERT_EQ(snippets.size(), 4u);
+  EXPECT_EQ(snippets[1], "a = 1");
+  EXPECT_EQ(snippets[2], "textmsg(a)");
+
+  tracker.markSent(id, true, "sent");
+  EXPECT_EQ(current(tracker, id, ScriptExecutionTracker::State::QUEUED).state, ScriptExecutionTracker::State::SENT);
+
+  // Messages of other programs and executions don't change anything
+  tracker.handleMessage(textMessage("urscript_interface connected"));
+  tracker.handleMessage(textMessage("urscript_interface finished " + std::to_string(id + 1)));
+  EXPECT_EQ(current(tracker, id, ScriptExecutionTracker::State::SENT).state, ScriptExecutionTracker::State::SENT);
+
+  std::this_thread::sleep_for(2ms);
+  tracker.handleMessage(textMessage(markerText(snippets.front())));
+  EXPECT_EQ(current(tracker, id, ScriptExecutionTracker::State::SENT).state, ScriptExecutionTracker::State::STARTED);
+  std::this_thread::sleep_for(2ms);
+  tracker.handleMessage(textMessage(markerText(snippets.back())));
+
+  const auto execution = current(tracker, id, ScriptExecutionTracker::State::STARTED);
+  EXPECT_EQ(execution.state, ScriptExecutionTracker::State::FINISHED);
+  EXPECT_LE(execution.submitted, execution.sent);
+  EXPECT_LT(execution.sent, execution.started);
+  EXPECT_LT(execution.started, execution.finished);
+}
+
+TEST(ScriptExecutionTrackerTest, attributes_runtime_exceptions_to_oldest_unfinished_execution)
+{
+  ScriptExecutionTracker tracker;
+  const uint64_t finished = tracker.add();
+  const uint64_t failing = tracker.add();
+  const uint64_t waiting = tracker.add();
+  tracker.markSent(finished, true, "sent");
+  tracker.markSent(failing, true, "sent");
+  tracker.markSent(waiting, true, "sent");
+  tracker.handleMessage(textMessage("urscript_interface started " + std::to_string(finished)));
+  tracker.handleMessage(textMessage("urscript_interface finished " + std::to_string(finished)));
+
+  PrimaryRobotMessage exception{ PrimaryRobotMessage::Type::RUNTIME_EXCEPTION, "compile_error_name_not_found:foo:" };
+  exception.line = 3;
+  exception.column = 5;
+  tracker.handleMessage(exception);
+
+  EXPECT_EQ(current(tracker, finished, ScriptExecutionTracker::State::SENT).state,
+            ScriptExecutionTracker::State::FINISHED);
+  const auto failed = current(tracker, failing, ScriptExecutionTracker::State::SENT);
+  EXPECT_EQ(failed.state, ScriptExecutionTracker::State::FAILED);
+  EXPECT_EQ(failed.message, "Runtime exception at line 3, column 5: compile_error_name_not_found:foo:");
+  EXPECT_EQ(current(tracker, waiting, ScriptExecutionTracker::State::SENT).state,
+            ScriptExecutionTracker::State::SENT);
+
+  // A late marker doesn't revive the failed execution
+  tracker.handleMessage(textMessage("urscript_interface finished " + std::to_string(failing)));
+  EXPECT_EQ(current(tracker, failing, ScriptExecutionTracker::State::SENT).state,
+            ScriptExecutionTracker::State::FAILED);
+}
+
+TEST(ScriptExecutionTrackerTest, reports_failed_sending)
+{
+  ScriptExecutionTracker tracker;
+  const uint64_t id = tracker.add();
+  tracker.markSent(id, false, "queue full");
+  const auto execution = current(tracker, id, ScriptExecutionTracker::State::QUEUED);
+  EXPECT_EQ(execution.state, ScriptExecutionTracker::State::FAILED);
+  EXPECT_EQ(execution.message, "queue full");
+}
+
+TEST(ScriptExecutionTrackerTest, handles_robot_reporting_before_delivery)
+{
+  ScriptExecutionTracker tracker;
+  const uint64_t id = tracker.add();
+  tracker.handleMessage(textMessage("urscript_interface started " + std::to_string(id)));
+  tracker.markSent(id, true, "sent");
+
+  const auto execution = current(tracker, id, ScriptExecutionTracker::State::QUEUED);
+  EXPECT_EQ(execution.state, ScriptExecutionTracker::State::STARTED);
+  EXPECT_LE(execution.sent, execution.started);
+}
+
+TEST(ScriptExecutionTrackerTest, wakes_up_waiting_callers)
+{
+  ScriptExecutionTracker tracker;
+  const uint64_t id = tracker.add();
+  tracker.markSent(id, true, "sent");
+
+  // Nothing happens until the deadline
+  const auto start = ScriptExecutionTracker::Clock::now();
+  EXPECT_EQ(tracker.waitForChange(id, ScriptExecutionTracker::State::SENT, start + 20ms).state,
+            ScriptExecutionTracker::State::SENT);
+  EXPECT_GE(ScriptExecutionTracker::Clock::now() - start, 20ms);
+
+  std::thread robot([&tracker, id]() {
+    std::this_thread::sleep_for(10ms);
+    tracker.handleMessage(textMessage("urscript_interface started " + std::to_string(id)));
+  });
+  EXPECT_EQ(tracker.waitForChange(id, ScriptExecutionTracker::State::SENT, start + 10s).state,
+            ScriptExecutionTracker::State::STARTED);
+  robot.join();
+
+  tracker.remove(id);
+  EXPECT_EQ(tracker.waitForChange(id, ScriptExecutionTracker::State::STARTED, start + 10s).state,
+            ScriptExecutionTracker::State::QUEUED);
+}
+
+TEST(ScriptExecutionTrackerTest, fails_executions_on_shutdown)
+{
+  ScriptExecutionTracker tracker;
+  const uint64_t finished = tracker.add();
+  const uint64_t waiting = tracker.add();
+  tracker.markSent(finished, true, "sent");
+  tracker.markSent(waiting, true, "sent");
+  tracker.handleMessage(textMessage("urscript_interface finished " + std::to_string(finished)));
+
+  // Callers waiting for the robot get woken up instead of running into their timeout
+  const auto start = ScriptExecutionTracker::Clock::now();
+  std::thread shutdown([&tracker]() {
+    std::this_thread::sleep_for(10ms);
+    tracker.shutdown();
+  });
+  EXPECT_EQ(tracker.waitForChange(waiting, ScriptExecutionTracker::State::SENT, start + 10s).state,
+            ScriptExecutionTracker::State::FAILED);
+  EXPECT_LT(ScriptExecutionTracker::Clock::now() - start, 5s);
+  shutdown.join();
+  EXPECT_EQ(current(tracker, finished, ScriptExecutionTracker::State::SENT).state,
+            ScriptExecutionTracker::State::FINISHED);
+
+  // Added after the shutdown, so nothing would ever report its progress
+  const uint64_t late = tracker.add();
+  EXPECT_EQ(current(tracker, late, ScriptExecutionTracker::State::QUEUED).state,
+            ScriptExecutionTracker::State::FAILED);
+}
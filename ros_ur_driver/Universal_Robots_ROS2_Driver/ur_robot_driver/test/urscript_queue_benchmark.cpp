@@ -0,0 +1,157 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_robot_driver/urscript_queue.hpp"
+
+using ur_robot_driver::URScriptQueue;
+using ur_robot_driver::URScriptTemplate;
+
+namespace
+{
+/*!
+ * \brief Local stand-in for the robot's secondary interface, reading and discarding everything it gets.
+ */
+class ScriptSink
+{
+public:
+  ScriptSink()
+  {
+    server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    bind(server_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    listen(server_fd_, 1);
+
+    thread_ = std::thread([this]() {
+      const int client_fd = accept(server_fd_, nullptr, nullptr);
+      char buffer[4096];
+      ssize_t received;
+      while ((received = recv(client_fd, buffer, sizeof(buffer), 0)) > 0) {
+        bytes_ += received;
+      }
+      close(client_fd);
+    });
+
+    client_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    socklen_t length = sizeof(address);
+    getsockname(server_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    if (connect(client_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      throw std::runtime_error("Could not connect to script sink");
+    }
+  }
+
+  ~ScriptSink()
+  {
+    close(client_fd_);
+    thread_.join();
+    close(server_fd_);
+  }
+
+  bool write(const std::string& program)
+  {
+    size_t sent = 0;
+    while (sent < program.size()) {
+      const ssize_t result = send(client_fd_, program.data() + sent, program.size() - sent, MSG_NOSIGNAL);
+      if (result <= 0) {
+        return false;
+      }
+      sent += result;
+    }
+    return true;
+  }
+
+private:
+  int server_fd_;
+  int client_fd_;
+  std::atomic<size_t> bytes_{ 0 };
+  std::thread thread_;
+};
+}  // namespace
+
+TEST(URScriptQueueBenchmark, throughput_against_tcp_sink)
+{
+  constexpr size_t COMMANDS = 20000;
+  constexpr size_t CLIENTS = 8;
+  const URScriptTemplate script_template("set_standard_digital_out({0}, {1})");
+
+  auto measure = [&](size_t max_batch_snippets) {
+    ScriptSink sink;
+    URScriptQueue queue([&sink](const std::string& program) { return sink.write(program); }, 64,
+                        max_batch_snippets);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    std::atomic<size_t> sent{ 0 };
+    for (size_t client = 0; client < CLIENTS; ++client) {
+      clients.emplace_back([&, client]() {
+        for (size_t i = 0; i < COMMANDS / CLIENTS; ++i) {
+          const std::string snippet = script_template.fill({ std::to_string(client), i % 2 ? "True" : "False" });
+          // Like the service, every client waits for its delivery before sending the next command
+          if (queue.submitSnippets({ snippet }).get() == URScriptQueue::DeliveryStatus::SENT) {
+            ++sent;
+          }
+        }
+      });
+    }
+    for (auto& client : clients) {
+      client.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(sent.load(), COMMANDS);
+    return COMMANDS / elapsed.count();
+  };
+
+  const double unbatched = measure(1);
+  const double batched = measure(100);
+  std::cout << "URScript throughput: " << unbatched << " commands/s unbatched, " << batched << " commands/s batched"
+            << std::endl;
+}
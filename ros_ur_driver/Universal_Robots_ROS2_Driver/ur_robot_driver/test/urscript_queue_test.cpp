@@ -0,0 +1,286 @@
+// Copyright 2026, FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_robot_driver/urscript_queue.hpp"
+
+using ur_robot_driver::URScriptQueue;
+using ur_robot_driver::URScriptTemplate;
+using namespace std::chrono_literals;
+
+namespace
+{
+/*!
+ * \brief Write function recording the programs, which can be held back to fill up the queue.
+ */
+class RecordingWriter
+{
+public:
+  bool write(const std::string& program)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    writing_ = true;
+    writing_cv_.notify_all();
+    release_cv_.wait(lock, [this]() { return !blocked_; });
+    programs_.push_back(program);
+    return succeed_;
+  }
+
+  void block()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    blocked_ = true;
+    writing_ = false;
+  }
+
+  void waitForWriting()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    writing_cv_.wait(lock, [this]() { return writing_; });
+  }
+
+  void release()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      blocked_ = false;
+    }
+    release_cv_.notify_all();
+  }
+
+  void fail()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    succeed_ = false;
+  }
+
+  std::vector<std::string> programs()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return programs_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable writing_cv_;
+  std::condition_variable release_cv_;
+  bool blocked_ = false;
+  bool writing_ = false;
+  bool succeed_ = true;
+  std::vector<std::string> programs_;
+};
+
+URScriptQueue::WriteFunction writeTo(RecordingWriter& writer)
+{
+  return [&writer](const std::string& program) { return writer.write(program); };
+}
+}  // namespace
+
+TEST(URScriptTemplateTest, fills_in_placeholders)
+{
+  URScriptTemplate script_template("set_standard_digital_out({0}, {1})\ntextmsg(\"pin {0}\")");
+  EXPECT_EQ(script_template.parameterCount(), 2u);
+  EXPECT_EQ(script_template.fill({ "3", "True" }), "set_standard_digital_out(3, True)\ntextmsg(\"pin 3\")");
+
+  URScriptTemplate constant("textmsg(\"hello\")");
+  EXPECT_EQ(constant.parameterCount(), 0u);
+  EXPECT_EQ(constant.fill({}), "textmsg(\"hello\")");
+}
+
+TEST(URScriptTemplateTest, rejects_invalid_templates_and_missing_values)
+{
+  EXPECT_THROW(URScriptTemplate("textmsg({0)"), std::invalid_argument);
+  EXPECT_THROW(URScriptTemplate("textmsg({})"), std::invalid_argument);
+  EXPECT_THROW(URScriptTemplate("textmsg({a})"), std::invalid_argument);
+
+  URScriptTemplate script_template("movej({1})");
+  EXPECT_EQ(script_template.parameterCount(), 2u);
+  EXPECT_THROW(script_template.fill({ "a" }), std::invalid_argument);
+}
+
+TEST(URScriptQueueTest, merges_queued_snippets_into_one_secondary_program)
+{
+  RecordingWriter writer;
+  URScriptQueue queue(writeTo(writer), 10, 100);
+
+  // Hold back the first program, so the following submissions wait in the queue together
+  writer.block();
+  auto first = queue.submitSnippets({ "textmsg(\"first\")" });
+  writer.waitForWriting();
+  auto second = queue.submitSnippets({ "a = 1\nb = 2", "textmsg(a)" });
+  auto third = queue.submitSnippets({ "textmsg(\"third\")" });
+  writer.release();
+
+  EXPECT_EQ(first.get(), URScriptQueue::DeliveryStatus::SENT);
+  EXPECT_EQ(second.get(), URScriptQueue::DeliveryStatus::SENT);
+  EXPECT_EQ(third.get(), URScriptQueue::DeliveryStatus::SENT);
+
+  const auto programs = writer.programs();
+  ASSERT_EQ(programs.size(), 2u);
+  EXPECT_EQ(programs[0], "sec urscript_batch():\n  textmsg(\"first\")\nend\n");
+  EXPECT_EQ(programs[1], "sec urscript_batch():\n  a = 1\n  b = 2\n  textmsg(a)\n  textmsg(\"third\")\nend\n");
+}
+
+TEST(URScriptQueueTest, limits_snippets_per_program)
+{
+  RecordingWriter writer;
+  URScriptQueue queue(writeTo(writer), 10, 2);
+
+  writer.block();
+  auto first = queue.submitSnippets({ "a = 0" });
+  writer.waitForWriting();
+  auto second = queue.submitSnippets({ "a = 1" });
+  auto third = queue.submitSnippets({ "a = 2" });
+  auto fourth = queue.submitSnippets({ "a = 3" });
+  writer.release();
+  fourth.get();
+
+  const auto programs = writer.programs();
+  ASSERT_EQ(programs.size(), 3u);
+  EXPECT_EQ(programs[1], "sec urscript_batch():\n  a = 1\n  a = 2\nend\n");
+  EXPECT_EQ(programs[2], "sec urscript_batch():\n  a = 3\nend\n");
+}
+
+TEST(URScriptQueueTest, sends_programs_on_their_own)
+{
+  RecordingWriter writer;
+  URScriptQueue queue(writeTo(writer), 10, 100);
+
+  writer.block();
+  auto first = queue.submitSnippets({ "a = 0" });
+  writer.waitForWriting();
+  auto second = queue.submitSnippets({ "a = 1" });
+  auto program = queue.submitProgram("def move():\n  movej([0, 0, 0, 0, 0, 0])\nend");
+  auto third = queue.submitSnippets({ "a = 2" });
+  writer.release();
+  third.get();
+
+  const auto programs = writer.programs();
+  ASSERT_EQ(programs.size(), 4u);
+  EXPECT_EQ(programs[1], "sec urscript_batch():\n  a = 1\nend\n");
+  EXPECT_EQ(programs[2], "def move():\n  movej([0, 0, 0, 0, 0, 0])\nend\n");
+  EXPECT_EQ(programs[3], "sec urscript_batch():\n  a = 2\nend\n");
+  EXPECT_EQ(program.get(), URScriptQueue::DeliveryStatus::SENT);
+}
+
+TEST(URScriptQueueTest, sends_snippets_on_their_own_if_requested)
+{
+  RecordingWriter writer;
+  URScriptQueue queue(writeTo(writer), 10, 100);
+
+  writer.block();
+  auto first = queue.submitSnippets({ "a = 0" });
+  writer.waitForWriting();
+  auto second = queue.submitSnippets({ "a = 1" });
+  auto own = queue.submitSnippets({ "a = 2", "a = 3" }, true);
+  auto third = queue.submitSnippets({ "a = 4" });
+  auto fourth = queue.submitSnippets({ "a = 5" });
+  writer.release();
+  fourth.get();
+
+  const auto programs = writer.programs();
+  ASSERT_EQ(programs.size(), 4u);
+  EXPECT_EQ(programs[1], "sec urscript_batch():\n  a = 1\nend\n");
+  EXPECT_EQ(programs[2], "sec urscript_batch():\n  a = 2\n  a = 3\nend\n");
+  EXPECT_EQ(programs[3], "sec urscript_batch():\n  a = 4\n  a = 5\nend\n");
+  EXPECT_EQ(own.get(), URScriptQueue::DeliveryStatus::SENT);
+}
+
+TEST(URScriptQueueTest, rejects_submissions_when_full)
+{
+  RecordingWriter writer;
+  URScriptQueue queue(writeTo(writer), 2, 100);
+
+  writer.block();
+  auto sending = queue.submitProgram("a = 0");
+  writer.waitForWriting();
+  auto first = queue.submitProgram("a = 1");
+  auto second = queue.submitProgram("a = 2");
+  auto rejected = queue.submitSnippets({ "a = 3" });
+
+  // Rejected right away, without waiting for the robot
+  ASSERT_EQ(rejected.wait_for(0s), std::future_status::ready);
+  EXPECT_EQ(rejected.get(), URScriptQueue::DeliveryStatus::QUEUE_FULL);
+  EXPECT_EQ(queue.size(), 2u);
+
+  writer.release();
+  EXPECT_EQ(second.get(), URScriptQueue::DeliveryStatus::SENT);
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_EQ(queue.submitProgram("a = 4").get(), URScriptQueue::DeliveryStatus::SENT);
+}
+
+TEST(URScriptQueueTest, reports_failed_writes)
+{
+  RecordingWriter writer;
+  writer.fail();
+  URScriptQueue queue(writeTo(writer), 10, 100);
+  EXPECT_EQ(queue.submitSnippets({ "a = 0" }).get(), URScriptQueue::DeliveryStatus::SEND_FAILED);
+  EXPECT_EQ(queue.submitSnippets({}).get(), URScriptQueue::DeliveryStatus::SENT);
+  EXPECT_EQ(writer.programs().size(), 1u);
+}
+
+TEST(URScriptQueueTest, resolves_queued_submissions_on_shutdown)
+{
+  RecordingWriter writer;
+  std::future<URScriptQueue::DeliveryStatus> sending;
+  std::future<URScriptQueue::DeliveryStatus> queued;
+  std::thread releaser;
+  {
+    URScriptQueue queue(writeTo(writer), 10, 100);
+    writer.block();
+    sending = queue.submitProgram("a = 0");
+    writer.waitForWriting();
+    queued = queue.submitProgram("a = 1");
+
+    // The destructor waits for the program being written and drops the rest
+    releaser = std::thread([&writer]() {
+      std::this_thread::sleep_for(50ms);
+      writer.release();
+    });
+  }
+  releaser.join();
+  EXPECT_EQ(sending.get(), URScriptQueue::DeliveryStatus::SENT);
+  EXPECT_EQ(queued.get(), URScriptQueue::DeliveryStatus::SHUT_DOWN);
+}
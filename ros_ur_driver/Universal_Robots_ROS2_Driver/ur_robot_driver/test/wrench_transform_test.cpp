@@ -0,0 +1,126 @@
+// Copyright 2026 FZI Forschungszentrum Informatik
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//----------------------------------------------------------------------
+/*!\file
+ *
+ * \date    2026-10-19
+ *
+ */
+//----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "tf2/LinearMath/Quaternion.h"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
+#include "ur_robot_driver/wrench_transform.hpp"
+
+using ur_robot_driver::rotateWrenchIntoTool;
+
+namespace
+{
+// The transformation as it was done using tf2 before, including the round trip through the message type
+void rotateWrenchIntoToolTf2(const urcl::vector6d_t& tcp_pose, urcl::vector6d_t& wrench)
+{
+  const double tcp_angle = std::sqrt(std::pow(tcp_pose[3], 2) + std::pow(tcp_pose[4], 2) + std::pow(tcp_pose[5], 2));
+
+  tf2::Vector3 rotation_vec(tcp_pose[3], tcp_pose[4], tcp_pose[5]);
+  tf2::Quaternion rotation;
+  if (tcp_angle > 1e-16) {
+    rotation.setRotation(rotation_vec.normalized(), tcp_angle);
+  } else {
+    rotation.setValue(0.0, 0.0, 0.0, 1.0);
+  }
+  const geometry_msgs::msg::Quaternion rotation_msg = tf2::toMsg(rotation);
+
+  tf2::Quaternion rotation_quat;
+  tf2::fromMsg(rotation_msg, rotation_quat);
+  const tf2::Vector3 force =
+      tf2::quatRotate(rotation_quat.inverse(), tf2::Vector3(wrench[0], wrench[1], wrench[2]));
+  const tf2::Vector3 torque =
+      tf2::quatRotate(rotation_quat.inverse(), tf2::Vector3(wrench[3], wrench[4], wrench[5]));
+
+  wrench = { force.x(), force.y(), force.z(), torque.x(), torque.y(), torque.z() };
+}
+
+std::vector<std::pair<urcl::vector6d_t, urcl::vector6d_t>> randomPosesAndWrenches(size_t count)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> position(-1.0, 1.0);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::uniform_real_distribution<double> load(-100.0, 100.0);
+
+  std::vector<std::pair<urcl::vector6d_t, urcl::vector6d_t>> samples;
+  for (size_t i = 0; i < count; ++i) {
+    samples.push_back({ { position(gen), position(gen), position(gen), angle(gen), angle(gen), angle(gen) },
+                        { load(gen), load(gen), load(gen), load(gen), load(gen), load(gen) } });
+  }
+  return samples;
+}
+}  // namespace
+
+TEST(WrenchTransform, matches_tf2_implementation)
+{
+  for (const auto& [pose, wrench] : randomPosesAndWrenches(10000)) {
+    urcl::vector6d_t expected = wrench;
+    urcl::vector6d_t actual = wrench;
+    rotateWrenchIntoToolTf2(pose, expected);
+    rotateWrenchIntoTool(pose, actual);
+
+    for (size_t i = 0; i < 6; ++i) {
+      EXPECT_NEAR(expected[i], actual[i], 1e-9);
+    }
+  }
+}
+
+TEST(WrenchTransform, zero_rotation_keeps_wrench)
+{
+  const urcl::vector6d_t pose = { 0.3, -0.2, 0.5, 0.0, 0.0, 0.0 };
+  const urcl::vector6d_t wrench = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+  urcl::vector6d_t actual = wrench;
+  rotateWrenchIntoTool(pose, actual);
+
+  EXPECT_EQ(wrench, actual);
+}
+
+TEST(WrenchTransform, rotation_about_z)
+{
+  // The tool is rotated by 90 degrees about the base's z axis, so the base's x axis is the tool's -y axis
+  const urcl::vector6d_t pose = { 0.0, 0.0, 0.0, 0.0, 0.0, M_PI_2 };
+  urcl::vector6d_t wrench = { 1.0, 0.0, 0.0, 0.0, 0.0, 2.0 };
+  rotateWrenchIntoTool(pose, wrench);
+
+  EXPECT_NEAR(wrench[0], 0.0, 1e-12);
+  EXPECT_NEAR(wrench[1], -1.0, 1e-12);
+  EXPECT_NEAR(wrench[2], 0.0, 1e-12);
+  EXPECT_NEAR(wrench[5], 2.0, 1e-12);
+}